@@ -59,11 +59,30 @@ double SSDegMinSec::toDegrees ( void )
 // strings like "+89 59 60.0" (this would become "+90 00 00.0")
 
 string SSDegMinSec::toString ( void )
+{
+    string str;
+    appendString ( str );
+    return str;
+}
+
+// Appends the same string as toString() to an existing string (str),
+// without allocating memory if the string has room for it.
+
+void SSDegMinSec::appendString ( string &str )
 {
     if ( sec >= 59.95 )
-        return SSDegMinSec ( toDegrees() + ( sign == '-' ? -0.05 : 0.05 ) / 3600.0 ).toString();
+    {
+        SSDegMinSec ( toDegrees() + ( sign == '-' ? -0.05 : 0.05 ) / 3600.0 ).appendString ( str );
+    }
     else
-        return format ( "%c%02hd %02hd %04.1f", sign, deg, min, sec );
+    {
+        str += sign;
+        appendint ( str, deg, 2 );
+        str += ' ';
+        appendint ( str, min, 2 );
+        str += ' ';
+        appendfixed ( str, sec, 1, 4 );
+    }
 }
 
 // Constructs an angular value in hours, minutes, seconds with the given sign.
@@ -117,11 +136,29 @@ double SSHourMinSec::toHours ( void )
 // OMITS SIGN!
 
 string SSHourMinSec::toString ( void )
+{
+    string str;
+    appendString ( str );
+    return str;
+}
+
+// Appends the same string as toString() to an existing string (str),
+// without allocating memory if the string has room for it.
+
+void SSHourMinSec::appendString ( string &str )
 {
     if ( sec >= 59.995 )
-        return SSHourMinSec ( mod24h ( toHours() + 0.005 / 3600.0 ) ).toString();
+    {
+        SSHourMinSec ( mod24h ( toHours() + 0.005 / 3600.0 ) ).appendString ( str );
+    }
     else
-        return format ( "%02hd %02hd %05.2f", hour, min, sec );
+    {
+        appendint ( str, hour, 2 );
+        str += ' ';
+        appendint ( str, min, 2 );
+        str += ' ';
+        appendfixed ( str, sec, 2, 5 );
+    }
 }
 
 // Constructs an angle in radians with the defautl value of zero.
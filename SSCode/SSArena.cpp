@@ -0,0 +1,79 @@
+// SSArena.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/25/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "SSArena.hpp"
+
+// Constructs an empty arena which will allocate memory in blocks of the given size, in bytes.
+// No memory is allocated until the first call to allocate().
+
+SSArena::SSArena ( size_t blockSize )
+{
+    _blockSize = blockSize > 0 ? blockSize : kDefaultBlockSize;
+    _next = _end = nullptr;
+    _numAllocs = _bytesAllocated = _bytesReserved = 0;
+}
+
+SSArena::~SSArena ( void )
+{
+    clear();
+}
+
+// Allocates a new block of at least the given size and makes it the current block.
+// Returns false if the system is out of memory.
+
+bool SSArena::addBlock ( size_t size )
+{
+    char *block = (char *) malloc ( size );
+    if ( block == nullptr )
+        return false;
+
+    _blocks.push_back ( block );
+    _next = block;
+    _end = block + size;
+    _bytesReserved += size;
+    return true;
+}
+
+// Returns a pointer to memory for the given number of bytes, aligned to a multiple
+// of the given alignment (which must be a power of two). Requests larger than the block
+// size get a block of their own. Returns nullptr if the system is out of memory.
+
+void *SSArena::allocate ( size_t bytes, size_t align )
+{
+    if ( align < 1 )
+        align = 1;
+
+    uintptr_t addr = ( (uintptr_t) _next + align - 1 ) & ~ (uintptr_t) ( align - 1 );
+    if ( _next == nullptr || addr + bytes > (uintptr_t) _end )
+    {
+        if ( ! addBlock ( bytes + align > _blockSize ? bytes + align : _blockSize ) )
+            return nullptr;
+
+        addr = ( (uintptr_t) _next + align - 1 ) & ~ (uintptr_t) ( align - 1 );
+    }
+
+    _next = (char *) ( addr + bytes );
+    _numAllocs++;
+    _bytesAllocated += bytes;
+
+    return (void *) addr;
+}
+
+// Releases all memory allocated from this arena at once, and resets the allocation counts.
+// Does not call any destructors: objects allocated from the arena must already be destroyed.
+
+void SSArena::clear ( void )
+{
+    for ( char *block : _blocks )
+        free ( block );
+
+    _blocks.clear();
+    _next = _end = nullptr;
+    _numAllocs = _bytesAllocated = _bytesReserved = 0;
+}
@@ -0,0 +1,510 @@
+// SSBinaryCatalog.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/20/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "SSBinaryCatalog.hpp"
+#include "SSStar.hpp"
+
+static const char kMagic[8] = { 'S', 'S', 'C', 'A', 'T', 'L', 'O', 'G' };
+
+// Size in bytes of each element of every section, indexed by section identifier.
+
+static const uint32_t kElementSizes[SSBinaryCatalog::kNumSections] =
+{
+    0,                      // unused
+    1,                      // kTypes
+    8, 8, 8, 8, 8, 8,       // kPositionX ... kVelocityZ
+    4, 4, 4, 4,             // kParallax, kRadVel, kVMag, kBMag
+    4, 4, 8, 4, 4,          // kSpectrum, kIdentStart, kIdents, kNameStart, kNames
+    4, 4, 4, 4, 4,          // kComponents, kMagDelta, kSeparation, kPositionAngle, kPAYear
+    4, 4, 4, 8, 8,          // kVarType, kVarMaxMag, kVarMinMag, kVarPeriod, kVarEpoch
+    4, 4, 4,                // kMajorAxis, kMinorAxis, kCSV
+    4, 1                    // kStringStart, kStrings
+};
+
+// Constructs a binary catalog writer with no objects.
+// String zero is always the empty string.
+
+SSBinaryCatalogWriter::SSBinaryCatalogWriter ( void )
+{
+    clear();
+}
+
+// Removes all objects from the writer and releases their memory.
+
+void SSBinaryCatalogWriter::clear ( void )
+{
+    map<string,uint32_t>().swap ( _stringIndex );
+    vector<uint32_t>().swap ( _stringStart );
+    vector<char>().swap ( _strings );
+
+    vector<uint8_t>().swap ( _types );
+    vector<double>().swap ( _posX );
+    vector<double>().swap ( _posY );
+    vector<double>().swap ( _posZ );
+    vector<double>().swap ( _velX );
+    vector<double>().swap ( _velY );
+    vector<double>().swap ( _velZ );
+    vector<float>().swap ( _parallax );
+    vector<float>().swap ( _radvel );
+    vector<float>().swap ( _vmag );
+    vector<float>().swap ( _bmag );
+    vector<uint32_t>().swap ( _spectrum );
+    vector<uint32_t>().swap ( _identStart );
+    vector<int64_t>().swap ( _idents );
+    vector<uint32_t>().swap ( _nameStart );
+    vector<uint32_t>().swap ( _names );
+    vector<uint32_t>().swap ( _comps );
+    vector<float>().swap ( _magDelta );
+    vector<float>().swap ( _sep );
+    vector<float>().swap ( _pa );
+    vector<float>().swap ( _paYear );
+    vector<uint32_t>().swap ( _varType );
+    vector<float>().swap ( _varMaxMag );
+    vector<float>().swap ( _varMinMag );
+    vector<double>().swap ( _varPeriod );
+    vector<double>().swap ( _varEpoch );
+    vector<float>().swap ( _majAxis );
+    vector<float>().swap ( _minAxis );
+    vector<uint32_t>().swap ( _csv );
+
+    _stringStart.push_back ( 0 );
+    _identStart.push_back ( 0 );
+    _nameStart.push_back ( 0 );
+    addString ( "" );
+}
+
+// Adds a string to the string table, if not already present,
+// and returns its index in the string table.
+
+uint32_t SSBinaryCatalogWriter::addString ( const string &str )
+{
+    map<string,uint32_t>::iterator it = _stringIndex.find ( str );
+    if ( it != _stringIndex.end() )
+        return it->second;
+
+    uint32_t index = (uint32_t) _stringIndex.size();
+    _stringIndex.insert ( { str, index } );
+    _strings.insert ( _strings.end(), str.begin(), str.end() );
+    _strings.push_back ( 0 );
+    _stringStart.push_back ( (uint32_t) _strings.size() );
+    return index;
+}
+
+// Copies an object's data into the writer's columns. Stars and deep sky objects are stored
+// in columns; other objects are stored as CSV text. The object itself is not retained.
+
+void SSBinaryCatalogWriter::add ( SSObject *pObj )
+{
+    _types.push_back ( pObj->getType() );
+
+    const vector<SSInternedString> &objNames = pObj->getNames();
+    for ( int k = 0; k < objNames.size(); k++ )
+        _names.push_back ( addString ( objNames[k] ) );
+    _nameStart.push_back ( (uint32_t) _names.size() );
+
+    SSStar *pStar = dynamic_cast<SSStar *> ( pObj );
+    SSDoubleStar *pDouble = dynamic_cast<SSDoubleStar *> ( pObj );
+    SSVariableStar *pVariable = dynamic_cast<SSVariableStar *> ( pObj );
+    SSDeepSky *pDeepSky = dynamic_cast<SSDeepSky *> ( pObj );
+
+    SSVector pos = pStar ? pStar->getFundamentalPosition() : SSVector ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
+    SSVector vel = pStar ? pStar->getFundamentalVelocity() : SSVector ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
+
+    _posX.push_back ( pos.x );
+    _posY.push_back ( pos.y );
+    _posZ.push_back ( pos.z );
+    _velX.push_back ( vel.x );
+    _velY.push_back ( vel.y );
+    _velZ.push_back ( vel.z );
+    _parallax.push_back ( pStar ? pStar->getParallax() : 0.0 );
+    _radvel.push_back ( pStar ? pStar->getRadVel() : HUGE_VAL );
+    _vmag.push_back ( pStar ? pStar->getVMagnitude() : HUGE_VAL );
+    _bmag.push_back ( pStar ? pStar->getBMagnitude() : HUGE_VAL );
+    _spectrum.push_back ( pStar ? addString ( pStar->getSpectralType() ) : 0 );
+    _csv.push_back ( pStar ? 0 : addString ( pObj->toCSV() ) );
+
+    if ( pStar != nullptr )
+    {
+        const vector<SSIdentifier> &starIdents = pStar->getIdentifiers();
+        for ( int k = 0; k < starIdents.size(); k++ )
+            _idents.push_back ( starIdents[k] );
+    }
+    _identStart.push_back ( (uint32_t) _idents.size() );
+
+    _comps.push_back ( pDouble ? addString ( pDouble->getComponents() ) : 0 );
+    _magDelta.push_back ( pDouble ? pDouble->getMagnitudeDelta() : HUGE_VAL );
+    _sep.push_back ( pDouble ? pDouble->getSeparation() : HUGE_VAL );
+    _pa.push_back ( pDouble ? pDouble->getPositionAngle() : pDeepSky ? pDeepSky->getPostionAngle() : HUGE_VAL );
+    _paYear.push_back ( pDouble ? pDouble->getPositionAngleYear() : HUGE_VAL );
+
+    _varType.push_back ( pVariable ? addString ( pVariable->getVariableType() ) : 0 );
+    _varMaxMag.push_back ( pVariable ? pVariable->getMaximumMagnitude() : HUGE_VAL );
+    _varMinMag.push_back ( pVariable ? pVariable->getMinimumMagnitude() : HUGE_VAL );
+    _varPeriod.push_back ( pVariable ? pVariable->getPeriod() : HUGE_VAL );
+    _varEpoch.push_back ( pVariable ? pVariable->getEpoch() : HUGE_VAL );
+
+    _majAxis.push_back ( pDeepSky ? pDeepSky->getMajorAxis() : HUGE_VAL );
+    _minAxis.push_back ( pDeepSky ? pDeepSky->getMinorAxis() : HUGE_VAL );
+}
+
+// Writes all objects added so far to a binary catalog file. Returns true if successful.
+
+bool SSBinaryCatalogWriter::write ( const string &filename )
+{
+    size_t n = _types.size();
+
+    // Gather sections, then lay them out after the header and section table on 8-byte boundaries.
+
+    struct { uint32_t id; uint32_t elemSize; const void *data; uint64_t count; } sections[] =
+    {
+        { SSBinaryCatalog::kTypes, 1, _types.data(), n },
+        { SSBinaryCatalog::kPositionX, 8, _posX.data(), n },
+        { SSBinaryCatalog::kPositionY, 8, _posY.data(), n },
+        { SSBinaryCatalog::kPositionZ, 8, _posZ.data(), n },
+        { SSBinaryCatalog::kVelocityX, 8, _velX.data(), n },
+        { SSBinaryCatalog::kVelocityY, 8, _velY.data(), n },
+        { SSBinaryCatalog::kVelocityZ, 8, _velZ.data(), n },
+        { SSBinaryCatalog::kParallax, 4, _parallax.data(), n },
+        { SSBinaryCatalog::kRadVel, 4, _radvel.data(), n },
+        { SSBinaryCatalog::kVMag, 4, _vmag.data(), n },
+        { SSBinaryCatalog::kBMag, 4, _bmag.data(), n },
+        { SSBinaryCatalog::kSpectrum, 4, _spectrum.data(), n },
+        { SSBinaryCatalog::kIdentStart, 4, _identStart.data(), _identStart.size() },
+        { SSBinaryCatalog::kIdents, 8, _idents.data(), _idents.size() },
+        { SSBinaryCatalog::kNameStart, 4, _nameStart.data(), _nameStart.size() },
+        { SSBinaryCatalog::kNames, 4, _names.data(), _names.size() },
+        { SSBinaryCatalog::kComponents, 4, _comps.data(), n },
+        { SSBinaryCatalog::kMagDelta, 4, _magDelta.data(), n },
+        { SSBinaryCatalog::kSeparation, 4, _sep.data(), n },
+        { SSBinaryCatalog::kPositionAngle, 4, _pa.data(), n },
+        { SSBinaryCatalog::kPAYear, 4, _paYear.data(), n },
+        { SSBinaryCatalog::kVarType, 4, _varType.data(), n },
+        { SSBinaryCatalog::kVarMaxMag, 4, _varMaxMag.data(), n },
+        { SSBinaryCatalog::kVarMinMag, 4, _varMinMag.data(), n },
+        { SSBinaryCatalog::kVarPeriod, 8, _varPeriod.data(), n },
+        { SSBinaryCatalog::kVarEpoch, 8, _varEpoch.data(), n },
+        { SSBinaryCatalog::kMajorAxis, 4, _majAxis.data(), n },
+        { SSBinaryCatalog::kMinorAxis, 4, _minAxis.data(), n },
+        { SSBinaryCatalog::kCSV, 4, _csv.data(), n },
+        { SSBinaryCatalog::kStringStart, 4, _stringStart.data(), _stringStart.size() },
+        { SSBinaryCatalog::kStrings, 1, _strings.data(), _strings.size() },
+    };
+
+    int numSections = sizeof ( sections ) / sizeof ( sections[0] );
+    SSBinaryCatalogHeader header = { { 0 }, SSBinaryCatalog::kVersion, SSBinaryCatalog::kEndianTag, (uint32_t) n, (uint32_t) numSections };
+    memcpy ( header.magic, kMagic, sizeof ( kMagic ) );
+
+    vector<SSBinaryCatalogSection> table ( numSections );
+    uint64_t offset = sizeof ( header ) + numSections * sizeof ( SSBinaryCatalogSection );
+    for ( int i = 0; i < numSections; i++ )
+    {
+        offset = ( offset + 7 ) & ~7ull;
+        table[i].id = sections[i].id;
+        table[i].elemSize = sections[i].elemSize;
+        table[i].offset = offset;
+        table[i].count = sections[i].count;
+        offset += sections[i].elemSize * sections[i].count;
+    }
+
+    FILE *file = fopen ( filename.c_str(), "wb" );
+    if ( file == nullptr )
+        return false;
+
+    bool ok = fwrite ( &header, sizeof ( header ), 1, file ) == 1;
+    ok = ok && fwrite ( table.data(), sizeof ( SSBinaryCatalogSection ), numSections, file ) == numSections;
+
+    static const char zeros[8] = { 0 };
+    uint64_t pos = sizeof ( header ) + numSections * sizeof ( SSBinaryCatalogSection );
+    for ( int i = 0; ok && i < numSections; i++ )
+    {
+        if ( table[i].offset > pos )
+            ok = fwrite ( zeros, 1, table[i].offset - pos, file ) == table[i].offset - pos;
+
+        if ( ok && sections[i].count > 0 )
+            ok = fwrite ( sections[i].data, sections[i].elemSize, sections[i].count, file ) == sections[i].count;
+
+        pos = table[i].offset + sections[i].elemSize * sections[i].count;
+    }
+
+    ok = fclose ( file ) == 0 && ok;
+    return ok;
+}
+
+// Exports a vector of objects to a binary catalog file. Returns the number of objects exported,
+// or zero on failure.
+
+int SSExportObjectsToBinary ( const string &filename, SSObjectVec &objects )
+{
+    SSBinaryCatalogWriter writer;
+
+    for ( size_t i = 0; i < objects.size(); i++ )
+        writer.add ( objects[i].get() );
+
+    return writer.write ( filename ) ? (int) writer.size() : 0;
+}
+
+// Constructs a binary catalog object with no file open.
+
+SSBinaryCatalog::SSBinaryCatalog ( void )
+{
+    _numObjects = 0;
+    for ( int i = 0; i < kNumSections; i++ )
+    {
+        _sections[i] = nullptr;
+        _counts[i] = 0;
+    }
+}
+
+// Closes the catalog file. All pointers into the catalog become invalid.
+
+void SSBinaryCatalog::close ( void )
+{
+    _file.close();
+    _numObjects = 0;
+    for ( int i = 0; i < kNumSections; i++ )
+    {
+        _sections[i] = nullptr;
+        _counts[i] = 0;
+    }
+}
+
+// Returns true if a column of (count) start indices (start) never decreases,
+// and its last element is at most (limit).
+
+static bool validStarts ( const uint32_t *start, uint64_t count, uint64_t limit )
+{
+    for ( uint64_t i = 1; i < count; i++ )
+        if ( start[i] < start[i - 1] )
+            return false;
+
+    return count > 0 && start[ count - 1 ] <= limit;
+}
+
+// Opens and memory-maps a binary catalog file, then validates its header and section table,
+// and the identifier, name, and string start columns, so that no accessor can read outside the file.
+// No other data is read until it's accessed. Returns true if successful, or false if the file
+// can't be opened, was written by an unsupported version or on a machine with different byte
+// order, or is damaged.
+
+bool SSBinaryCatalog::open ( const string &filename )
+{
+    close();
+    if ( ! _file.open ( filename ) )
+        return false;
+
+    const char *data = _file.data();
+    size_t size = _file.size();
+
+    SSBinaryCatalogHeader header;
+    bool ok = size >= sizeof ( header );
+    if ( ok )
+    {
+        memcpy ( &header, data, sizeof ( header ) );
+        ok = memcmp ( header.magic, kMagic, sizeof ( kMagic ) ) == 0 && header.version == kVersion && header.endian == kEndianTag;
+        ok = ok && size >= sizeof ( header ) + (uint64_t) header.numSections * sizeof ( SSBinaryCatalogSection );
+    }
+
+    for ( uint32_t i = 0; ok && i < header.numSections; i++ )
+    {
+        SSBinaryCatalogSection section;
+        memcpy ( &section, data + sizeof ( header ) + i * sizeof ( section ), sizeof ( section ) );
+
+        // Skip sections from newer format revisions; reject sections which don't fit in the file.
+
+        if ( section.id == 0 || section.id >= kNumSections )
+            continue;
+
+        ok = section.elemSize == kElementSizes[section.id] && section.offset % 8 == 0 && section.offset <= size
+          && section.count <= ( size - section.offset ) / section.elemSize;
+        _sections[section.id] = data + section.offset;
+        _counts[section.id] = section.count;
+    }
+
+    // Every section must be present, and per-object columns must have one element per object.
+
+    for ( int i = 1; ok && i < kNumSections; i++ )
+    {
+        ok = _sections[i] != nullptr;
+        if ( i == kIdentStart || i == kNameStart )
+            ok = ok && _counts[i] == header.numObjects + 1;
+        else if ( i != kIdents && i != kNames && i != kStringStart && i != kStrings )
+            ok = ok && _counts[i] == header.numObjects;
+    }
+
+    if ( ok )
+    {
+        const uint32_t *identStart = getIndexColumn ( kIdentStart );
+        const uint32_t *nameStart = getIndexColumn ( kNameStart );
+        const uint32_t *stringStart = getIndexColumn ( kStringStart );
+
+        const char *strings = (const char *) _sections[kStrings];
+        uint64_t numStarts = _counts[kStringStart], numChars = _counts[kStrings];
+
+        // Every string must start inside the string table, which must end with a null character.
+
+        ok = validStarts ( stringStart, numStarts, numChars ) && numChars > 0 && strings[ numChars - 1 ] == 0;
+        ok = ok && ( numStarts < 2 || stringStart[ numStarts - 2 ] < numChars );
+        ok = ok && validStarts ( identStart, header.numObjects + 1, _counts[kIdents] );
+        ok = ok && validStarts ( nameStart, header.numObjects + 1, _counts[kNames] );
+    }
+
+    if ( ! ok )
+    {
+        close();
+        return false;
+    }
+
+    _numObjects = header.numObjects;
+    return true;
+}
+
+// Returns a pointer to the start of a section and the number of elements it contains,
+// or null pointer if the section is not present.
+
+const void *SSBinaryCatalog::getSection ( Section id, size_t &count )
+{
+    count = _counts[id];
+    return _sections[id];
+}
+
+// Returns a pointer to a null-terminated string in the string table.
+// Returns an empty string if the index is out of range.
+
+const char *SSBinaryCatalog::getString ( uint32_t index )
+{
+    if ( index + 1 >= _counts[kStringStart] )
+        return "";
+
+    return (const char *) _sections[kStrings] + getIndexColumn ( kStringStart )[index];
+}
+
+// Returns the number of identifiers of the i-th object.
+
+int SSBinaryCatalog::getIdentifierCount ( size_t i )
+{
+    const uint32_t *start = getIndexColumn ( kIdentStart );
+    return start[i + 1] - start[i];
+}
+
+// Returns the k-th identifier of the i-th object.
+
+SSIdentifier SSBinaryCatalog::getIdentifier ( size_t i, int k )
+{
+    const int64_t *idents = (const int64_t *) _sections[kIdents];
+    return SSIdentifier ( idents[ getIndexColumn ( kIdentStart )[i] + k ] );
+}
+
+// Returns the number of names of the i-th object.
+
+int SSBinaryCatalog::getNameCount ( size_t i )
+{
+    const uint32_t *start = getIndexColumn ( kNameStart );
+    return start[i + 1] - start[i];
+}
+
+// Returns the k-th name of the i-th object.
+
+const char *SSBinaryCatalog::getName ( size_t i, int k )
+{
+    return getString ( getIndexColumn ( kNames )[ getIndexColumn ( kNameStart )[i] + k ] );
+}
+
+// Creates a new SSObject from the i-th object in the catalog.
+// If an arena is provided (pArena), the object is allocated from it.
+// Returns null pointer if the object can't be created.
+
+SSObjectPtr SSBinaryCatalog::getObject ( size_t i, SSArena *pArena )
+{
+    uint32_t csv = getIndexColumn ( kCSV )[i];
+    if ( csv != 0 )
+        return SSObjectFromCSV ( getString ( csv ), pArena );
+
+    SSObjectPtr pObject = SSNewObject ( (SSObjectType) getTypes()[i], pArena );
+    SSStarPtr pStar = SSGetStarPtr ( pObject );
+    if ( pStar == nullptr )
+        return pObject;
+
+    pStar->setFundamentalPosition ( SSVector ( getDoubleColumn ( kPositionX )[i], getDoubleColumn ( kPositionY )[i], getDoubleColumn ( kPositionZ )[i] ) );
+    pStar->setFundamentalVelocity ( SSVector ( getDoubleColumn ( kVelocityX )[i], getDoubleColumn ( kVelocityY )[i], getDoubleColumn ( kVelocityZ )[i] ) );
+    pStar->setParallax ( getFloatColumn ( kParallax )[i] );
+    pStar->setRadVel ( getFloatColumn ( kRadVel )[i] );
+    pStar->setVMagnitude ( getFloatColumn ( kVMag )[i] );
+    pStar->setBMagnitude ( getFloatColumn ( kBMag )[i] );
+    pStar->setSpectralType ( getSpectralType ( i ) );
+
+    int numIdents = getIdentifierCount ( i );
+    vector<SSIdentifier> idents ( numIdents );
+    for ( int k = 0; k < numIdents; k++ )
+        idents[k] = getIdentifier ( i, k );
+    pStar->setIdentifiers ( move ( idents ) );
+
+    int numNames = getNameCount ( i );
+    vector<string> names ( numNames );
+    for ( int k = 0; k < numNames; k++ )
+        names[k] = getName ( i, k );
+    pStar->setNames ( names );
+
+    SSDoubleStarPtr pDouble = SSGetDoubleStarPtr ( pObject );
+    if ( pDouble != nullptr )
+    {
+        pDouble->setComponents ( getString ( getIndexColumn ( kComponents )[i] ) );
+        pDouble->setMagnitudeDelta ( getFloatColumn ( kMagDelta )[i] );
+        pDouble->setSeparation ( getFloatColumn ( kSeparation )[i] );
+        pDouble->setPositionAngle ( getFloatColumn ( kPositionAngle )[i] );
+        pDouble->setPositionAngleYear ( getFloatColumn ( kPAYear )[i] );
+    }
+
+    SSVariableStarPtr pVariable = SSGetVariableStarPtr ( pObject );
+    if ( pVariable != nullptr )
+    {
+        pVariable->setVariableType ( getString ( getIndexColumn ( kVarType )[i] ) );
+        pVariable->setMaximumMagnitude ( getFloatColumn ( kVarMaxMag )[i] );
+        pVariable->setMinimumMagnitude ( getFloatColumn ( kVarMinMag )[i] );
+        pVariable->setPeriod ( getDoubleColumn ( kVarPeriod )[i] );
+        pVariable->setEpoch ( getDoubleColumn ( kVarEpoch )[i] );
+    }
+
+    SSDeepSkyPtr pDeepSky = SSGetDeepSkyPtr ( pObject );
+    if ( pDeepSky != nullptr )
+    {
+        pDeepSky->setMajorAxis ( getFloatColumn ( kMajorAxis )[i] );
+        pDeepSky->setMinorAxis ( getFloatColumn ( kMinorAxis )[i] );
+        pDeepSky->setPositionAngle ( getFloatColumn ( kPositionAngle )[i] );
+    }
+
+    return pObject;
+}
+
+// Imports objects from a binary catalog file (filename), appending them to the input vector
+// of SSObjects (objects). If an arena is provided (pArena), objects are allocated from it.
+// Returns the number of objects successfully imported.
+
+int SSImportObjectsFromBinary ( const string &filename, SSObjectVec &objects, SSArena *pArena )
+{
+    SSBinaryCatalog catalog;
+    if ( ! catalog.open ( filename ) )
+        return 0;
+
+    int numObjects = 0;
+    objects.reserve ( objects.size() + catalog.size() );
+
+    for ( size_t i = 0; i < catalog.size(); i++ )
+    {
+        SSObjectPtr pObject = catalog.getObject ( i, pArena );
+        if ( pObject )
+        {
+            objects.push_back ( pObject );
+            numObjects++;
+        }
+    }
+
+    return numObjects;
+}
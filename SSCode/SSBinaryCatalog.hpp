@@ -0,0 +1,159 @@
+// SSBinaryCatalog.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/20/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// A binary catalog file format for vectors of SSObjects, designed to be memory-mapped
+// and used in place without parsing. The file starts with a versioned, endian-tagged
+// header and a table of sections; each section is one column of per-object data
+// (type, position, velocity, magnitudes, etc.), an identifier or name side table,
+// or the string table. Stars and deep sky objects are stored entirely in columns;
+// other objects (planets, constellations, etc.) are stored as CSV text in the string
+// table. Converters to and from SSObjectVec make the format interchangeable with CSV.
+
+#ifndef SSBinaryCatalog_hpp
+#define SSBinaryCatalog_hpp
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "SSMappedFile.hpp"
+#include "SSObject.hpp"
+
+// Fixed-size header at the start of every binary catalog file.
+
+struct SSBinaryCatalogHeader
+{
+    char        magic[8];       // always "SSCATLOG"
+    uint32_t    version;        // file format version; see kVersion
+    uint32_t    endian;         // kEndianTag, written in native byte order of machine which wrote the file
+    uint32_t    numObjects;     // number of objects in catalog; number of elements in each per-object column
+    uint32_t    numSections;    // number of entries in section table, which immediately follows this header
+};
+
+// Entry in a binary catalog's section table.
+
+struct SSBinaryCatalogSection
+{
+    uint32_t    id;             // section identifier; see SSBinaryCatalog::Section
+    uint32_t    elemSize;       // size of each element in bytes
+    uint64_t    offset;         // offset of first element from start of file, in bytes; always a multiple of 8
+    uint64_t    count;          // number of elements in section
+};
+
+class SSBinaryCatalog
+{
+public:
+
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kEndianTag = 0x01020304;
+
+    // Section identifiers. Per-object columns have one element per object;
+    // the identifier and name start columns have one extra element marking
+    // the end of the last object's identifiers or names.
+
+    enum Section
+    {
+        kTypes = 1,             // object type codes (uint8_t)
+        kPositionX = 2,         // J2000 heliocentric position, light years or unit vector (double)
+        kPositionY = 3,
+        kPositionZ = 4,
+        kVelocityX = 5,         // J2000 heliocentric velocity, light years per year or unit vector (double)
+        kVelocityY = 6,
+        kVelocityZ = 7,
+        kParallax = 8,          // parallax in arcseconds (float)
+        kRadVel = 9,            // radial velocity as fraction of light speed (float)
+        kVMag = 10,             // visual magnitude (float)
+        kBMag = 11,             // blue magnitude (float)
+        kSpectrum = 12,         // spectral type or galaxy type (string table index)
+        kIdentStart = 13,       // index of each object's first identifier in kIdents (uint32_t)
+        kIdents = 14,           // identifiers of all objects, in object order (int64_t)
+        kNameStart = 15,        // index of each object's first name in kNames (uint32_t)
+        kNames = 16,            // names of all objects, in object order (string table index)
+        kComponents = 17,       // double star components (string table index)
+        kMagDelta = 18,         // double star magnitude difference (float)
+        kSeparation = 19,       // double star separation in radians (float)
+        kPositionAngle = 20,    // double star or deep sky object position angle in radians (float)
+        kPAYear = 21,           // double star position angle year (float)
+        kVarType = 22,          // variable star type (string table index)
+        kVarMaxMag = 23,        // variable star maximum (faintest) magnitude (float)
+        kVarMinMag = 24,        // variable star minimum (brightest) magnitude (float)
+        kVarPeriod = 25,        // variable star period in days (double)
+        kVarEpoch = 26,         // variable star epoch as Julian Date (double)
+        kMajorAxis = 27,        // deep sky object major axis in radians (float)
+        kMinorAxis = 28,        // deep sky object minor axis in radians (float)
+        kCSV = 29,              // CSV text of objects which are not stars or deep sky objects; empty string for stars (string table index)
+        kStringStart = 30,      // offset of each string in kStrings, plus one extra marking end of last string (uint32_t)
+        kStrings = 31,          // characters of all strings, each terminated by a null character (char)
+        kNumSections = 32
+    };
+
+protected:
+
+    SSMappedFile _file;                         // mapped catalog file
+    uint32_t _numObjects;                       // number of objects in catalog
+    const void *_sections[kNumSections];        // pointers to start of each section in mapped file
+    uint64_t _counts[kNumSections];             // number of elements in each section
+
+public:
+
+    SSBinaryCatalog ( void );
+
+    bool open ( const string &filename );
+    void close ( void );
+
+    size_t size ( void ) { return _numObjects; }
+
+    const void *getSection ( Section id, size_t &count );
+    const uint8_t *getTypes ( void ) { return (const uint8_t *) _sections[kTypes]; }
+    const double *getDoubleColumn ( Section id ) { return (const double *) _sections[id]; }
+    const float *getFloatColumn ( Section id ) { return (const float *) _sections[id]; }
+    const uint32_t *getIndexColumn ( Section id ) { return (const uint32_t *) _sections[id]; }
+
+    const char *getString ( uint32_t index );
+    const char *getSpectralType ( size_t i ) { return getString ( getIndexColumn ( kSpectrum )[i] ); }
+
+    int getIdentifierCount ( size_t i );
+    SSIdentifier getIdentifier ( size_t i, int k );
+    int getNameCount ( size_t i );
+    const char *getName ( size_t i, int k );
+
+    SSObjectPtr getObject ( size_t i, class SSArena *pArena = nullptr );
+};
+
+// Accumulates objects in compact column form, then writes them to a binary catalog file.
+
+class SSBinaryCatalogWriter
+{
+protected:
+
+    map<string,uint32_t> _stringIndex;      // mapping of strings to string table indices
+    vector<uint32_t> _stringStart;          // offset of each string in _strings
+    vector<char> _strings;                  // null-terminated characters of all strings
+
+    vector<uint8_t> _types;
+    vector<double> _posX, _posY, _posZ, _velX, _velY, _velZ;
+    vector<float> _parallax, _radvel, _vmag, _bmag;
+    vector<uint32_t> _spectrum, _identStart, _nameStart, _names, _comps, _varType, _csv;
+    vector<int64_t> _idents;
+    vector<float> _magDelta, _sep, _pa, _paYear, _varMaxMag, _varMinMag, _majAxis, _minAxis;
+    vector<double> _varPeriod, _varEpoch;
+
+    uint32_t addString ( const string &str );
+
+public:
+
+    SSBinaryCatalogWriter ( void );
+
+    size_t size ( void ) { return _types.size(); }
+    void clear ( void );
+    void add ( SSObject *pObject );
+    bool write ( const string &filename );
+};
+
+int SSExportObjectsToBinary ( const string &filename, SSObjectVec &objects );
+int SSImportObjectsFromBinary ( const string &filename, SSObjectVec &objects, class SSArena *pArena = nullptr );
+
+#endif /* SSBinaryCatalog_hpp */
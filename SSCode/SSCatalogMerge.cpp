@@ -0,0 +1,267 @@
+// SSCatalogMerge.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/30/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <cstdint>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "SSTLE.hpp"
+#include "SSCatalogMerge.hpp"
+#include "SSPlanet.hpp"
+
+// Returns true if two orbits (orb1, orb2) have identical elements.
+
+static bool sameOrbit ( const SSOrbit &orb1, const SSOrbit &orb2 )
+{
+    return orb1.t == orb2.t && orb1.q == orb2.q && orb1.e == orb2.e && orb1.i == orb2.i
+        && orb1.w == orb2.w && orb1.n == orb2.n && orb1.m == orb2.m && orb1.mm == orb2.mm;
+}
+
+// Returns true if an object in a catalog (pOld) has the same data as an object in an update (pNew).
+// Solar system objects are compared field by field; other objects, by their CSV representations.
+
+static bool sameObject ( SSObject *pOld, SSObject *pNew )
+{
+    if ( typeid ( *pOld ) != typeid ( *pNew ) || pOld->getType() != pNew->getType() )
+        return false;
+
+    SSPlanet *pOldPlanet = dynamic_cast<SSPlanet *> ( pOld );
+    SSPlanet *pNewPlanet = dynamic_cast<SSPlanet *> ( pNew );
+
+    if ( pOldPlanet != nullptr && pNewPlanet != nullptr )
+        return sameOrbit ( pOldPlanet->getOrbit(), pNewPlanet->getOrbit() )
+            && pOldPlanet->getHMagnitude() == pNewPlanet->getHMagnitude()
+            && pOldPlanet->getGMagnitude() == pNewPlanet->getGMagnitude()
+            && pOldPlanet->getRadius() == pNewPlanet->getRadius()
+            && pOldPlanet->getNames() == pNewPlanet->getNames();
+
+    return pOld->toCSV() == pNew->toCSV();
+}
+
+// Replaces the data of the object at index k in a catalog (objects) with those of an object from an update (pNew).
+// Solar system objects are copied into the existing object, so pointers to it stay valid;
+// any other object is replaced by the new one.
+
+static void updateObject ( SSObjectVec &objects, size_t k, SSObjectPtr pNew )
+{
+    SSPlanet *pOldPlanet = dynamic_cast<SSPlanet *> ( objects[k].get() );
+    SSPlanet *pNewPlanet = dynamic_cast<SSPlanet *> ( pNew.get() );
+
+    if ( pOldPlanet != nullptr && pNewPlanet != nullptr && typeid ( *pOldPlanet ) == typeid ( *pNewPlanet ) )
+        *pOldPlanet = *pNewPlanet;
+    else
+        objects[k] = pNew;
+}
+
+// Applies a vector of updated objects (updates) to a catalog of objects in place. Each update is matched
+// to an object in the catalog by its identifier in one catalog (cat); updates without an identifier there
+// are matched by their first name to catalog objects which also have none. Matched objects whose data
+// have changed are updated; unmatched updates are appended to the catalog. If retire is true, catalog
+// objects of the same types as the updates, which are not matched by any update, are removed from the
+// catalog; the order of the remaining objects is unchanged. If provided, pIndex is an identifier index
+// of the catalog for the same catalog (cat); it is used to find objects, and is updated to match.
+// Otherwise, a temporary index is built. Counts of changes are returned in summary.
+// Returns the total number of objects added, updated, and retired.
+
+int SSMergeObjects ( SSObjectVec &objects, SSObjectVec &updates, SSCatalog cat, bool retire, SSMergeSummary &summary, SSIdentifierIndex *pIndex )
+{
+    summary = SSMergeSummary();
+
+    SSIdentifierIndex tempIndex;
+    if ( pIndex == nullptr )
+    {
+        tempIndex = SSIdentifierIndex ( objects, cat );
+        pIndex = &tempIndex;
+    }
+
+    // Note which object types appear in the update; only objects of those types can be retired.
+
+    uint64_t types = 0;
+    for ( SSObjectPtr &pNew : updates )
+        if ( pNew != nullptr )
+            types |= 1ULL << ( pNew->getType() & 63 );
+
+    // Match each update to an existing object; update it if its data have changed.
+    // The name map is built only when the first update without an identifier is found.
+
+    size_t numObjects = objects.size();
+    vector<bool> matched ( numObjects, false );
+    unordered_map<const string *, int> nameMap;
+    bool nameMapBuilt = false;
+    SSObjectVec added;
+
+    for ( SSObjectPtr &pNew : updates )
+    {
+        if ( pNew == nullptr )
+            continue;
+
+        int k = -1;
+        SSIdentifier ident = pNew->getIdentifier ( cat );
+        if ( ident )
+        {
+            k = pIndex->find ( ident );
+        }
+        else if ( ! pNew->getNames().empty() )
+        {
+            if ( ! nameMapBuilt )
+            {
+                for ( int i = 0; i < numObjects; i++ )
+                {
+                    SSObject *pOld = objects[i].get();
+                    if ( pOld && ! pOld->getIdentifier ( cat ) && ! pOld->getNames().empty() )
+                        nameMap.insert ( { &pOld->getNames()[0].str(), i } );
+                }
+                nameMapBuilt = true;
+            }
+
+            auto it = nameMap.find ( &pNew->getNames()[0].str() );
+            if ( it != nameMap.end() )
+                k = it->second;
+        }
+
+        if ( k < 0 || k >= numObjects || objects[k] == nullptr )
+        {
+            added.push_back ( pNew );
+            continue;
+        }
+
+        matched[k] = true;
+        if ( sameObject ( objects[k].get(), pNew.get() ) )
+        {
+            summary.unchanged++;
+        }
+        else
+        {
+            updateObject ( objects, k, pNew );
+            summary.updated++;
+        }
+    }
+
+    // Remove unmatched objects of the updated types, keeping the rest in order,
+    // and note where each remaining object has moved to.
+
+    vector<int> renumber;
+    if ( retire )
+    {
+        for ( int i = 0; i < numObjects; i++ )
+            if ( ! matched[i] && objects[i] != nullptr && ( types & ( 1ULL << ( objects[i]->getType() & 63 ) ) ) )
+                summary.retired++;
+
+        if ( summary.retired > 0 )
+        {
+            renumber.assign ( numObjects, -1 );
+            int j = 0;
+            for ( int i = 0; i < numObjects; i++ )
+            {
+                if ( ! matched[i] && objects[i] != nullptr && ( types & ( 1ULL << ( objects[i]->getType() & 63 ) ) ) )
+                    continue;
+
+                renumber[i] = j;
+                objects[j++] = move ( objects[i] );
+            }
+
+            objects.resize ( j );
+        }
+    }
+
+    // Append new objects, and note their identifiers and indices in the catalog.
+
+    vector<pair<int64_t,int>> addedIdents;
+    for ( SSObjectPtr &pNew : added )
+    {
+        SSIdentifier ident = pNew->getIdentifier ( cat );
+        if ( ident )
+            addedIdents.push_back ( { ident, (int) objects.size() } );
+
+        objects.push_back ( pNew );
+        summary.added++;
+    }
+
+    if ( pIndex != &tempIndex && ( addedIdents.size() > 0 || renumber.size() > 0 ) )
+        pIndex->update ( addedIdents, renumber );
+
+    return summary.added + summary.updated + summary.retired;
+}
+
+// Returns true if two TLEs (tle1, tle2) have the same name, designation, epoch, and orbital elements.
+
+static bool sameTLE ( const SSTLE &tle1, const SSTLE &tle2 )
+{
+    return tle1.name == tle2.name && tle1.desig == tle2.desig && tle1.jdepoch == tle2.jdepoch
+        && tle1.xndt2o == tle2.xndt2o && tle1.xndd6o == tle2.xndd6o && tle1.bstar == tle2.bstar
+        && tle1.xincl == tle2.xincl && tle1.xnodeo == tle2.xnodeo && tle1.eo == tle2.eo
+        && tle1.omegao == tle2.omegao && tle1.xmo == tle2.xmo && tle1.xno == tle2.xno;
+}
+
+// Applies a vector of updated TLEs (updates) to a vector of TLEs in place, as SSMergeObjects() does
+// for objects, matching TLEs by their NORAD numbers. Changed TLEs are replaced, new TLEs are appended,
+// and if retire is true, TLEs missing from the update are removed. Counts of changes are returned
+// in summary. Returns the total number of TLEs added, updated, and retired.
+
+int SSMergeTLEs ( vector<SSTLE> &tles, vector<SSTLE> &updates, bool retire, SSMergeSummary &summary )
+{
+    summary = SSMergeSummary();
+
+    size_t numTLEs = tles.size();
+    unordered_map<int, int> noradMap;
+    for ( int i = 0; i < numTLEs; i++ )
+        noradMap.insert ( { tles[i].norad, i } );
+
+    vector<bool> matched ( numTLEs, false );
+    for ( SSTLE &tle : updates )
+    {
+        auto it = noradMap.find ( tle.norad );
+        if ( it == noradMap.end() || it->second >= numTLEs )
+        {
+            noradMap.insert ( { tle.norad, (int) tles.size() } );
+            tles.push_back ( tle );
+            summary.added++;
+            continue;
+        }
+
+        int k = it->second;
+        matched[k] = true;
+        if ( sameTLE ( tles[k], tle ) )
+        {
+            summary.unchanged++;
+        }
+        else
+        {
+            // Free the old TLE's orbit model data; the new TLE's is not shared.
+
+            tles[k].delargs();
+            tles[k] = tle;
+            tles[k].argp.sgp = nullptr;
+            summary.updated++;
+        }
+    }
+
+    if ( retire )
+    {
+        size_t j = 0;
+        for ( size_t i = 0; i < tles.size(); i++ )
+        {
+            if ( i < numTLEs && ! matched[i] )
+            {
+                tles[i].delargs();
+                summary.retired++;
+                continue;
+            }
+
+            if ( j < i )
+            {
+                tles[j] = tles[i];
+                tles[i].argp.sgp = nullptr;
+            }
+
+            j++;
+        }
+
+        tles.resize ( j );
+    }
+
+    return summary.added + summary.updated + summary.retired;
+}
@@ -0,0 +1,39 @@
+// SSCatalogMerge.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/30/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Routines for applying an update (for instance, a daily Minor Planet Center or TLE file)
+// to a catalog which has already been imported, instead of importing the whole catalog again.
+// Objects are matched by their identifiers in one catalog, or by their first name if they have
+// no identifier there. Matching objects which have changed are updated in place, new objects are
+// appended, and objects missing from the update may optionally be retired. An identifier index
+// of the catalog, if any, is updated with only the changed entries, instead of being rebuilt.
+
+#ifndef SSCatalogMerge_hpp
+#define SSCatalogMerge_hpp
+
+#include <vector>
+
+#include "SSObject.hpp"
+#include "SSIdentifierIndex.hpp"
+
+struct SSTLE;
+
+// Counts of changes made by a merge.
+
+struct SSMergeSummary
+{
+    int added;          // objects in update which were not in catalog, appended to it
+    int updated;        // objects in catalog whose data were changed by the update
+    int unchanged;      // objects in catalog whose data were the same in the update
+    int retired;        // objects in catalog which were missing from the update, and removed
+
+    SSMergeSummary ( void ) { added = updated = unchanged = retired = 0; }
+};
+
+int SSMergeObjects ( SSObjectVec &objects, SSObjectVec &updates, SSCatalog cat, bool retire, SSMergeSummary &summary, SSIdentifierIndex *pIndex = nullptr );
+int SSMergeTLEs ( vector<SSTLE> &tles, vector<SSTLE> &updates, bool retire, SSMergeSummary &summary );
+
+#endif /* SSCatalogMerge_hpp */
@@ -0,0 +1,204 @@
+// SSCatalogStream.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/22/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <string>
+
+#include "SSCatalogStream.hpp"
+#include "SSStarStore.hpp"
+#include "SSSkyIndex.hpp"
+#include "SSStar.hpp"
+
+bool SSObjectVecSink::put ( SSObjectPtr pObject )
+{
+    _objects.push_back ( pObject );
+    return true;
+}
+
+bool SSCallbackSink::put ( SSObjectPtr pObject )
+{
+    return _callback ( pObject );
+}
+
+bool SSStarStoreSink::put ( SSObjectPtr pObject )
+{
+    SSStar *pStar = dynamic_cast<SSStar *> ( pObject.get() );
+    if ( pStar != nullptr )
+        _store.append ( pStar );
+
+    return true;
+}
+
+// Indexes a star's apparent direction, if it has been computed; otherwise its fundamental position.
+// Non-star objects are numbered but not indexed, so indices match the order of objects in the stream.
+
+bool SSSkyIndexSink::put ( SSObjectPtr pObject )
+{
+    SSStar *pStar = dynamic_cast<SSStar *> ( pObject.get() );
+    if ( pStar != nullptr )
+    {
+        SSVector dir = pStar->getDirection();
+        if ( isinf ( dir.x ) )
+            dir = pStar->getFundamentalPosition();
+
+        _index.update ( _next, dir );
+    }
+
+    _next++;
+    return true;
+}
+
+bool SSSkyIndexSink::flush ( void )
+{
+    _index.commit();
+    return true;
+}
+
+bool SSBinaryCatalogSink::put ( SSObjectPtr pObject )
+{
+    _writer.add ( pObject.get() );
+    return true;
+}
+
+// Writes all objects received so far to the binary catalog file.
+// Returns true if successful or false on failure.
+
+bool SSBinaryCatalogSink::finish ( void )
+{
+    return _writer.write ( _filename );
+}
+
+bool SSTeeSink::put ( SSObjectPtr pObject )
+{
+    bool result = true;
+
+    for ( SSObjectSink *pSink : _sinks )
+        result = pSink->put ( pObject ) && result;
+
+    return result;
+}
+
+bool SSTeeSink::flush ( void )
+{
+    bool result = true;
+
+    for ( SSObjectSink *pSink : _sinks )
+        result = pSink->flush() && result;
+
+    return result;
+}
+
+SSBufferedSink::SSBufferedSink ( SSObjectSink &sink, size_t budget ) : _sink ( sink )
+{
+    _budget = budget;
+    _used = 0;
+    _stopped = false;
+}
+
+// Adds an object to the buffer. If the buffer has reached its memory budget, passes
+// all buffered objects downstream and empties the buffer. Returns false once the
+// downstream sink has asked to stop.
+
+bool SSBufferedSink::put ( SSObjectPtr pObject )
+{
+    if ( _stopped )
+        return false;
+
+    _buffer.push_back ( pObject );
+    _used += SSEstimateObjectSize ( pObject.get() );
+
+    if ( _used >= _budget )
+        flush();
+
+    return ! _stopped;
+}
+
+// Passes all buffered objects downstream, empties the buffer, then flushes the downstream sink.
+
+bool SSBufferedSink::flush ( void )
+{
+    for ( size_t i = 0; i < _buffer.size() && ! _stopped; i++ )
+        if ( ! _sink.put ( _buffer[i] ) )
+            _stopped = true;
+
+    _buffer.clear();
+    _used = 0;
+
+    return _sink.flush();
+}
+
+// Returns a rough estimate of the heap memory used by an object, in bytes.
+// Names and spectral types are interned and shared, so only their handles are counted.
+
+size_t SSEstimateObjectSize ( SSObject *pObject )
+{
+    if ( pObject == nullptr )
+        return 0;
+
+    size_t size = sizeof ( SSObject );
+    size += pObject->getNames().size() * sizeof ( SSInternedString );
+
+    SSStar *pStar = dynamic_cast<SSStar *> ( pObject );
+    if ( pStar != nullptr )
+    {
+        size += sizeof ( SSStar ) - sizeof ( SSObject );
+        size += pStar->getIdentifiers().size() * sizeof ( SSIdentifier );
+    }
+
+    return size;
+}
+
+// Opens a catalog file for reading. Lines will be converted into objects by the parser.
+// Call isOpen() to find out whether the file was opened successfully.
+
+SSCatalogReader::SSCatalogReader ( const string &filename, SSRecordParser parser ) : _file ( filename ), _parser ( parser )
+{
+    _nextPending = 0;
+}
+
+// Returns the next object in the catalog file, reading and parsing lines as needed.
+// Returns false when the end of the file is reached.
+
+bool SSCatalogReader::next ( SSObjectPtr &pObject )
+{
+    SSStringView line;
+
+    while ( _nextPending >= _pending.size() )
+    {
+        _pending.clear();
+        _nextPending = 0;
+
+        if ( ! _file.readLine ( line ) )
+            return false;
+
+        _parser ( line, _pending );
+    }
+
+    pObject = _pending[ _nextPending++ ];
+    _pending[ _nextPending - 1 ] = nullptr;
+    return true;
+}
+
+// Reads all remaining objects from the catalog file and sends them to a sink,
+// stopping early if the sink asks. Flushes the sink at the end.
+// Returns the number of objects the sink accepted; an object for which
+// the sink's put() returned false is not counted.
+
+int SSCatalogReader::read ( SSObjectSink &sink )
+{
+    SSObjectPtr pObject = nullptr;
+    int count = 0;
+
+    while ( next ( pObject ) )
+    {
+        if ( ! sink.put ( pObject ) )
+            break;
+
+        count++;
+    }
+
+    sink.flush();
+    return count;
+}
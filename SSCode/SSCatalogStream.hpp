@@ -0,0 +1,187 @@
+// SSCatalogStream.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/22/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Classes for streaming very large catalogs through an import pipeline without holding
+// the whole catalog in memory. An SSCatalogReader reads a catalog file one line at a time,
+// and uses a record parser to convert each line into objects (parsing the line and
+// cross-identifying it with other catalogs). Objects are either pulled from the reader
+// one at a time with next(), or pushed into an SSObjectSink, which can append them to
+// a vector, a star store, a sky index, or a binary catalog file, or pass them to a callback.
+// Streaming only bounds the memory used by objects in flight. Sinks which collect the whole
+// catalog (a vector, a star store, a sky index, a binary catalog) still grow with it, and
+// parsers may keep cross-identification tables for the whole import; see SSHIPRecordParser().
+
+#ifndef SSCatalogStream_hpp
+#define SSCatalogStream_hpp
+
+#include <functional>
+#include <vector>
+
+#include "SSObject.hpp"
+#include "SSBinaryCatalog.hpp"
+#include "SSLineReader.hpp"
+
+class SSStarStore;
+class SSSkyIndex;
+
+// Converts one line of a catalog file into zero or more objects, which it appends
+// to the objects vector. The line is a view of the file's contents, valid only during the call.
+// Returns the number of objects appended.
+
+typedef function<int ( SSStringView line, SSObjectVec &objects )> SSRecordParser;
+
+// Receives objects from an import pipeline. put() returns false to stop the import.
+// flush() is called at the end of the import, and whenever a buffering stage upstream
+// releases a batch of objects; it returns false on failure.
+
+class SSObjectSink
+{
+public:
+
+    virtual ~SSObjectSink ( void ) { }
+    virtual bool put ( SSObjectPtr pObject ) = 0;
+    virtual bool flush ( void ) { return true; }
+};
+
+// Appends objects to a vector of objects. This is what the non-streaming importers use.
+
+class SSObjectVecSink : public SSObjectSink
+{
+protected:
+
+    SSObjectVec &_objects;
+
+public:
+
+    SSObjectVecSink ( SSObjectVec &objects ) : _objects ( objects ) { }
+    virtual bool put ( SSObjectPtr pObject );
+};
+
+// Passes objects to a callback function, which returns false to stop the import.
+
+class SSCallbackSink : public SSObjectSink
+{
+protected:
+
+    function<bool ( SSObjectPtr pObject )> _callback;
+
+public:
+
+    SSCallbackSink ( function<bool ( SSObjectPtr pObject )> callback ) : _callback ( callback ) { }
+    virtual bool put ( SSObjectPtr pObject );
+};
+
+// Copies stars and deep sky objects into a columnar star store; other objects are ignored.
+// Objects are released as soon as they are copied.
+
+class SSStarStoreSink : public SSObjectSink
+{
+protected:
+
+    SSStarStore &_store;
+
+public:
+
+    SSStarStoreSink ( SSStarStore &store ) : _store ( store ) { }
+    virtual bool put ( SSObjectPtr pObject );
+};
+
+// Adds object directions to a sky index. Objects are numbered in the order they arrive,
+// starting from the first index passed to the constructor; changes are committed to the
+// index at every flush.
+
+class SSSkyIndexSink : public SSObjectSink
+{
+protected:
+
+    SSSkyIndex &_index;
+    int _next;
+
+public:
+
+    SSSkyIndexSink ( SSSkyIndex &index, int first = 0 ) : _index ( index ), _next ( first ) { }
+    virtual bool put ( SSObjectPtr pObject );
+    virtual bool flush ( void );
+};
+
+// Writes objects to a binary catalog file. Objects are released as soon as they are added,
+// but their column data is kept in memory until finish() writes the whole file, so this sink's
+// memory use grows with the catalog, whatever budget an upstream SSBufferedSink has.
+
+class SSBinaryCatalogSink : public SSObjectSink
+{
+protected:
+
+    SSBinaryCatalogWriter _writer;
+    string _filename;
+
+public:
+
+    SSBinaryCatalogSink ( const string &filename ) : _filename ( filename ) { }
+    virtual bool put ( SSObjectPtr pObject );
+    bool finish ( void );
+};
+
+// Sends each object to several sinks in turn.
+
+class SSTeeSink : public SSObjectSink
+{
+protected:
+
+    vector<SSObjectSink *> _sinks;
+
+public:
+
+    SSTeeSink ( vector<SSObjectSink *> sinks ) : _sinks ( sinks ) { }
+    virtual bool put ( SSObjectPtr pObject );
+    virtual bool flush ( void );
+};
+
+// Holds objects until their estimated memory use reaches a budget, then passes the whole batch
+// to another sink and flushes it. Lets sinks which work best in batches (like SSSkyIndexSink)
+// see large batches. The budget only limits the objects held in this buffer; it does not limit
+// what the downstream sink keeps, and the downstream sink is flushed after every batch.
+
+class SSBufferedSink : public SSObjectSink
+{
+protected:
+
+    SSObjectSink &_sink;
+    size_t _budget;         // memory budget in bytes
+    size_t _used;           // estimated bytes used by objects in buffer
+    SSObjectVec _buffer;    // objects not yet passed on
+    bool _stopped;          // true once downstream sink has returned false from put()
+
+public:
+
+    SSBufferedSink ( SSObjectSink &sink, size_t budget );
+    virtual bool put ( SSObjectPtr pObject );
+    virtual bool flush ( void );
+};
+
+// Reads a catalog file one line at a time, converting lines into objects with a record parser.
+
+class SSCatalogReader
+{
+protected:
+
+    SSLineReader _file;         // catalog file
+    SSRecordParser _parser;     // converts lines to objects
+    SSObjectVec _pending;       // objects parsed from the current line, not yet returned by next()
+    size_t _nextPending;        // index of next object in _pending to return
+
+public:
+
+    SSCatalogReader ( const string &filename, SSRecordParser parser );
+
+    bool isOpen ( void ) { return _file.isOpen(); }
+    bool next ( SSObjectPtr &pObject );
+    int read ( SSObjectSink &sink );
+};
+
+size_t SSEstimateObjectSize ( SSObject *pObject );
+
+#endif /* SSCatalogStream_hpp */
@@ -4,13 +4,12 @@
 // Created by Tim DeBenedictis on 3/25/20.
 // Copyright © 2020 Southern Stars. All rights reserved.
 
-#include <iostream>
-#include <fstream>
-#include <map>
-
 #include "SSConstellation.hpp"
+#include "SSLineReader.hpp"
+
+// Official IAU constellation abbreviations, in order from Andromeda (1) to Vulpecula (88).
 
-static vector<string> _convec =
+constexpr const char *const kConstellations[88] =
 {
     "And", "Ant", "Aps", "Aqr", "Aql", "Ara", "Ari", "Aur",
     "Boo", "Cae", "Cam", "Cnc", "CVn", "CMa", "CMi", "Cap",
@@ -25,7 +24,24 @@ static vector<string> _convec =
     "TrA", "Tuc", "UMa", "UMi", "Vel", "Vir", "Vol", "Vul"
 };
 
-static map<string,int> _conmap;
+// Constellation abbreviations with their indices from 1 to 88, sorted by abbreviation.
+
+constexpr SSNameValue kConstellationIndices[88] =
+{
+    { "And", 1 }, { "Ant", 2 }, { "Aps", 3 }, { "Aql", 5 }, { "Aqr", 4 }, { "Ara", 6 }, { "Ari", 7 }, { "Aur", 8 },
+    { "Boo", 9 }, { "CMa", 14 }, { "CMi", 15 }, { "CVn", 13 }, { "Cae", 10 }, { "Cam", 11 }, { "Cap", 16 }, { "Car", 17 },
+    { "Cas", 18 }, { "Cen", 19 }, { "Cep", 20 }, { "Cet", 21 }, { "Cha", 22 }, { "Cir", 23 }, { "Cnc", 12 }, { "Col", 24 },
+    { "Com", 25 }, { "CrA", 26 }, { "CrB", 27 }, { "Crt", 29 }, { "Cru", 30 }, { "Crv", 28 }, { "Cyg", 31 }, { "Del", 32 },
+    { "Dor", 33 }, { "Dra", 34 }, { "Equ", 35 }, { "Eri", 36 }, { "For", 37 }, { "Gem", 38 }, { "Gru", 39 }, { "Her", 40 },
+    { "Hor", 41 }, { "Hya", 42 }, { "Hyi", 43 }, { "Ind", 44 }, { "LMi", 47 }, { "Lac", 45 }, { "Leo", 46 }, { "Lep", 48 },
+    { "Lib", 49 }, { "Lup", 50 }, { "Lyn", 51 }, { "Lyr", 52 }, { "Men", 53 }, { "Mic", 54 }, { "Mon", 55 }, { "Mus", 56 },
+    { "Nor", 57 }, { "Oct", 58 }, { "Oph", 59 }, { "Ori", 60 }, { "Pav", 61 }, { "Peg", 62 }, { "Per", 63 }, { "Phe", 64 },
+    { "Pic", 65 }, { "PsA", 67 }, { "Psc", 66 }, { "Pup", 68 }, { "Pyx", 69 }, { "Ret", 70 }, { "Scl", 74 }, { "Sco", 73 },
+    { "Sct", 75 }, { "Ser", 76 }, { "Sex", 77 }, { "Sge", 71 }, { "Sgr", 72 }, { "Tau", 78 }, { "Tel", 79 }, { "TrA", 81 },
+    { "Tri", 80 }, { "Tuc", 82 }, { "UMa", 83 }, { "UMi", 84 }, { "Vel", 85 }, { "Vir", 86 }, { "Vol", 87 }, { "Vul", 88 }
+};
+
+static_assert ( namessorted ( kConstellationIndices ), "Constellation abbreviations must be sorted" );
 
 SSConstellation::SSConstellation ( SSObjectType type ) : SSObject ( type )
 {
@@ -42,26 +58,21 @@ SSConstellation::SSConstellation ( SSObjectType type ) : SSObject ( type )
 string SSConstellation::indexToAbbreviation ( int index )
 {
     if ( index >=1 && index <= 88 )
-        return _convec[index];
+        return kConstellations[ index - 1 ];
     else
         return "";
 }
 
 // Given an official IAU constellation abbreviation ("And" ... "Vul"),
 // returns corresponding index from 1 to 88, or 0 if abbreviation not recognized.
+// The abbreviation table is a constant, built at compile time, so this may be called
+// from several threads at once.
 
-int SSConstellation::abbreviationToIndex ( string abbrev )
+int SSConstellation::abbreviationToIndex ( SSStringView abbrev )
 {
-    // Initialize abbreviation-to-index mapping if it's empty
-    
-    if ( _conmap.size() == 0 )
-        for ( int i = 0; i < _convec.size(); i++ )
-            _conmap.insert ( { _convec[i], i + 1 } );
-
-    return _conmap[abbrev];
+    return findname ( kConstellationIndices, 88, abbrev.data(), abbrev.length() );
 }
 
-
 // Downcasts generic SSObject pointer to SSConstellation pointer.
 // Returns nullptr if input pointer is not an instance of SSPlanet!
 
@@ -71,9 +82,10 @@ SSConstellationPtr SSGetConstellationPtr ( SSObjectPtr ptr )
 }
 
 // Allocates a new SSConstellation and initializes it from a CSV-formatted string.
+// If an arena is provided (pArena), the object is allocated from it.
 // Returns nullptr on error (invalid CSV string, heap allocation failure, etc.)
 
-SSObjectPtr SSConstellation::fromCSV ( string csv )
+SSObjectPtr SSConstellation::fromCSV ( string csv, SSArena *pArena )
 {
     vector<string> fields = split ( csv, "," );
     
@@ -81,7 +93,7 @@ SSObjectPtr SSConstellation::fromCSV ( string csv )
     if ( type < kTypeConstellation || type > kTypeAsterism || fields.size() < 8 )
         return nullptr;
     
-	SSObjectPtr pObject = SSNewObject ( type );
+	SSObjectPtr pObject = SSNewObject ( type, pArena );
     SSConstellationPtr pCon = SSGetConstellationPtr ( pObject );
     if ( pCon == nullptr )
         return nullptr;
@@ -98,24 +110,31 @@ SSObjectPtr SSConstellation::fromCSV ( string csv )
     return pObject;
 }
 
-string SSConstellation::toCSV ( void )
+// Appends CSV string from constellation data, including names.
+
+void SSConstellation::appendCSV ( string &csv )
 {
-    string csv = SSObject::typeToCode ( _type ) + ",";
+    csv += SSObject::typeToCode ( _type );
+    csv += ',';
     
     SSSpherical center ( _direction );
     double ra = radtodeg ( center.lon / 15.0 );
     double dec = radtodeg ( center.lat );
     double area = radtodeg ( radtodeg ( _area ) );
     
-    csv += isinf ( ra ) ? "," : format ( "%.7f,", ra );
-    csv += isinf ( dec ) ? "," : format ( "%+.6f,", dec );
-    csv += isinf ( area ) ? "," : format ( "%.2f,", area );
-    csv += _rank < 1 ? "," : format ( "%d,", _rank );
-    
-    for ( int i = 0; i < _names.size(); i++ )
-        csv += _names[i] + ",";
+    appendCSVField ( csv, ra, 7 );
+    appendCSVField ( csv, dec, 6, true );
+    appendCSVField ( csv, area, 2 );
+
+    if ( _rank >= 1 )
+        appendint ( csv, _rank );
+    csv += ',';
     
-    return csv;
+    for ( const SSInternedString &name : _names )
+    {
+        csv += name.str();
+        csv += ',';
+    }
 }
 
 // Reads constellation data from CSV-formatted text file.
@@ -126,8 +145,8 @@ int SSImportConstellations ( const string &filename, SSObjectVec &constellations
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
@@ -135,7 +154,7 @@ int SSImportConstellations ( const string &filename, SSObjectVec &constellations
     string line = "";
     int numCons = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( line ) )
     {
         // Attempt to create constellation from CSV file line; continue on failure.
         
@@ -164,8 +183,8 @@ int SSImportConstellationBoundaries ( const string &filename, SSObjectVec &const
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
@@ -176,7 +195,7 @@ int SSImportConstellationBoundaries ( const string &filename, SSObjectVec &const
     vector<SSVector> boundary ( 0 );
     SSConstellationPtr pCon = SSGetConstellationPtr ( constellations[0] );
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( line ) )
     {
         // Require 3 fields per line; skip if we don't have em.
         
@@ -200,7 +219,7 @@ int SSImportConstellationBoundaries ( const string &filename, SSObjectVec &const
             
             if ( pCon != nullptr && boundary.size() > 0 )
             {
-                pCon->setBoundary ( boundary );
+                pCon->setBoundary ( move ( boundary ) );
                 // cout << "Imported " << boundary.size() << " vertices for " << lastAbbr << endl;
             }
 
@@ -233,7 +252,7 @@ int SSImportConstellationBoundaries ( const string &filename, SSObjectVec &const
     
     if ( pCon != nullptr && boundary.size() > 0 )
     {
-        pCon->setBoundary ( boundary );
+        pCon->setBoundary ( move ( boundary ) );
         // cout << "Imported " << boundary.size() << " vertices for " << lastAbbr << endl;
     }
 
@@ -250,8 +269,8 @@ int SSImportConstellationShapes ( const string &filename, SSObjectVec &constella
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
@@ -261,7 +280,7 @@ int SSImportConstellationShapes ( const string &filename, SSObjectVec &constella
     vector<int> shape ( 0 );
     SSConstellationPtr pCon = SSGetConstellationPtr ( constellations[0] );
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( line ) )
     {
         // Require 3 fields per line; skip if we don't have enough.
         
@@ -284,7 +303,7 @@ int SSImportConstellationShapes ( const string &filename, SSObjectVec &constella
             
             if ( pCon != nullptr && shape.size() > 0 )
             {
-                pCon->setFigure ( shape );
+                pCon->setFigure ( move ( shape ) );
                 // cout << "Imported " << shape.size() / 2 << " shape lines for " << lastAbbr << endl;
             }
 
@@ -316,7 +335,7 @@ int SSImportConstellationShapes ( const string &filename, SSObjectVec &constella
     
     if ( pCon != nullptr && shape.size() > 0 )
     {
-        pCon->setFigure ( shape );
+        pCon->setFigure ( move ( shape ) );
         // cout << "Imported " << shape.size() / 2 << " shape lines for " << lastAbbr << endl;
     }
 
@@ -33,27 +33,33 @@ public:
     
     double getArea ( void ) { return _area; }
     int getRank ( void ) { return _rank; }
-    vector<SSVector> getBoundary ( void ) { return _bounds; }
-    vector<int> getFigure ( void ) { return _figures; }
+    const vector<SSVector> &getBoundary ( void ) { return _bounds; }
+    const vector<int> &getFigure ( void ) { return _figures; }
 
     // modifiers
     
     void setArea ( double area ) { _area = area; }
     void setRank ( int rank ) { _rank = rank; }
-    void setBoundary ( vector<SSVector> bounds ) { _bounds = bounds; }
-    void setFigure ( vector<int> figure ) { _figures = figure; }
+    void setBoundary ( vector<SSVector> bounds ) { _bounds = move ( bounds ); }
+    void setFigure ( vector<int> figure ) { _figures = move ( figure ); }
 
     // converts IAU abbreviation ("And", "Ant", ... "Vul") to index number (1, 2, ... 88) and vice-versa.
     
-    static int abbreviationToIndex ( string abbrev );
+    static int abbreviationToIndex ( SSStringView abbrev );
     static string indexToAbbreviation ( int index );
     
     // imports/exports from/to CSV-format text string
     
-    static SSObjectPtr fromCSV ( string csv );
-    string toCSV ( void );
+    static SSObjectPtr fromCSV ( string csv, class SSArena *pArena = nullptr );
+    void appendCSV ( string &csv );
 };
 
+// Official IAU constellation abbreviations, in order from Andromeda (1) to Vulpecula (88);
+// and the same abbreviations with their indices, sorted by abbreviation for findname().
+
+extern const char *const kConstellations[88];
+extern const SSNameValue kConstellationIndices[88];
+
 // convenient alias for pointer to SSConstellation
 
 typedef SSConstellation *SSConstellationPtr;
@@ -0,0 +1,117 @@
+// SSEphemerisBatch.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/26/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+#include <functional>
+#include <typeinfo>
+
+#include "SSEphemerisBatch.hpp"
+#include "SSConstellation.hpp"
+#include "SSDynamics.hpp"
+
+SSEphemerisBatch::SSEphemerisBatch ( void )
+{
+    _numSkipped = 0;
+}
+
+// Builds a batch from a vector of objects. The batch holds raw pointers to the objects,
+// so the vector must not be changed or destroyed while the batch is in use.
+
+SSEphemerisBatch::SSEphemerisBatch ( SSObjectVec &objects ) : SSEphemerisBatch()
+{
+    build ( objects );
+}
+
+// Removes all objects from the batch.
+
+void SSEphemerisBatch::clear ( void )
+{
+    _planets.clear();
+    _stars.clear();
+    _doubles.clear();
+    _variables.clear();
+    _doubleVariables.clear();
+    _others.clear();
+    _numSkipped = 0;
+}
+
+// Sorts the objects in a vector into lists by concrete class, replacing any objects
+// already in the batch. Classes are matched exactly, so a subclass which overrides
+// computeEphemeris() is never mistaken for its base class; it goes to the list of
+// other objects instead. Null objects are ignored. Every downcast is a dynamic_cast,
+// since the star subclasses inherit SSStar virtually, and static_cast cannot convert
+// through a virtual base. The casts cost time only here, never in computeEphemeris().
+
+void SSEphemerisBatch::build ( SSObjectVec &objects )
+{
+    clear();
+
+    for ( SSObjectPtr &pObjPtr : objects )
+    {
+        SSObject *pObj = pObjPtr.get();
+        if ( pObj == nullptr )
+            continue;
+
+        const type_info &type = typeid ( *pObj );
+
+        if ( type == typeid ( SSPlanet ) )
+            _planets.push_back ( dynamic_cast<SSPlanet *> ( pObj ) );
+        else if ( type == typeid ( SSStar ) || type == typeid ( SSDeepSky ) )
+            _stars.push_back ( dynamic_cast<SSStar *> ( pObj ) );
+        else if ( type == typeid ( SSDoubleStar ) )
+            _doubles.push_back ( dynamic_cast<SSDoubleStar *> ( pObj ) );
+        else if ( type == typeid ( SSVariableStar ) )
+            _variables.push_back ( dynamic_cast<SSVariableStar *> ( pObj ) );
+        else if ( type == typeid ( SSDoubleVariableStar ) )
+            _doubleVariables.push_back ( dynamic_cast<SSDoubleVariableStar *> ( pObj ) );
+        else if ( type == typeid ( SSConstellation ) )
+            _numSkipped++;
+        else
+            _others.push_back ( pObj );
+    }
+
+    // Sort each list by address, so objects allocated one after another are visited in memory order.
+
+    sort ( _planets.begin(), _planets.end(), less<SSPlanet *>() );
+    sort ( _stars.begin(), _stars.end(), less<SSStar *>() );
+    sort ( _doubles.begin(), _doubles.end(), less<SSDoubleStar *>() );
+    sort ( _variables.begin(), _variables.end(), less<SSVariableStar *>() );
+    sort ( _doubleVariables.begin(), _doubleVariables.end(), less<SSDoubleVariableStar *>() );
+    sort ( _others.begin(), _others.end(), less<SSObject *>() );
+}
+
+// Returns the total number of objects in the batch, including skipped objects.
+
+size_t SSEphemerisBatch::size ( void )
+{
+    return _planets.size() + getStarCount() + _others.size() + _numSkipped;
+}
+
+// Computes the ephemeris of every object in the batch for the given dynamical state.
+// Each object's ephemeris depends only on the dynamical state and the object itself,
+// so computing the lists one after another gives exactly the same results as computing
+// the original vector of objects in order.
+
+void SSEphemerisBatch::computeEphemeris ( SSDynamics &dyn )
+{
+    for ( SSPlanet *pPlanet : _planets )
+        pPlanet->SSPlanet::computeEphemeris ( dyn );
+
+    for ( SSStar *pStar : _stars )
+        pStar->SSStar::computeEphemeris ( dyn );
+
+    for ( SSDoubleStar *pDouble : _doubles )
+        pDouble->SSDoubleStar::computeEphemeris ( dyn );
+
+    for ( SSVariableStar *pVariable : _variables )
+        pVariable->SSVariableStar::computeEphemeris ( dyn );
+
+    for ( SSDoubleVariableStar *pDoubleVariable : _doubleVariables )
+        pDoubleVariable->SSDoubleVariableStar::computeEphemeris ( dyn );
+
+    for ( SSObject *pObj : _others )
+        pObj->computeEphemeris ( dyn );
+}
@@ -0,0 +1,58 @@
+// SSEphemerisBatch.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/26/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Computes ephemerides for a whole vector of objects without a virtual call per object.
+// When built, an SSEphemerisBatch sorts the objects into lists by their concrete class
+// (planets, plain stars and deep sky objects, double stars, variable stars, and double
+// variable stars), each in order of the objects' addresses in memory. Each list is then
+// run through a tight loop which calls its class's computeEphemeris() directly.
+// Constellations and asterisms, which have no ephemeris to compute, are skipped entirely.
+// Objects of any other class are still computed with a virtual call, so results are always
+// identical to calling computeEphemeris() on every object in the vector in turn.
+// A batch pays off when the vector's order differs from the order its objects were allocated
+// in (sorted by magnitude, merged, or shuffled): it then visits memory in order while a loop
+// over the vector jumps around. For a vector as imported, a loop over it already sweeps memory
+// in order, and is as fast or faster, so the batch is not used unless a caller chooses it.
+
+#ifndef SSEphemerisBatch_hpp
+#define SSEphemerisBatch_hpp
+
+#include <vector>
+
+#include "SSObject.hpp"
+#include "SSPlanet.hpp"
+#include "SSStar.hpp"
+
+class SSEphemerisBatch
+{
+protected:
+
+    vector<SSPlanet *> _planets;                        // planets, moons, asteroids, comets, satellites
+    vector<SSStar *> _stars;                            // single stars and deep sky objects
+    vector<SSDoubleStar *> _doubles;                    // double stars
+    vector<SSVariableStar *> _variables;                // variable stars
+    vector<SSDoubleVariableStar *> _doubleVariables;    // double variable stars
+    vector<SSObject *> _others;                         // objects of any other class; computed with a virtual call
+    size_t _numSkipped;                                 // objects with no ephemeris to compute
+
+public:
+
+    SSEphemerisBatch ( void );
+    SSEphemerisBatch ( SSObjectVec &objects );
+
+    void build ( SSObjectVec &objects );
+    void clear ( void );
+
+    size_t size ( void );
+    size_t getPlanetCount ( void ) { return _planets.size(); }
+    size_t getStarCount ( void ) { return _stars.size() + _doubles.size() + _variables.size() + _doubleVariables.size(); }
+    size_t getOtherCount ( void ) { return _others.size(); }
+    size_t getSkippedCount ( void ) { return _numSkipped; }
+
+    void computeEphemeris ( class SSDynamics &dyn );
+};
+
+#endif /* SSEphemerisBatch_hpp */
@@ -4,61 +4,51 @@
 //  Created by Tim DeBenedictis on 3/20/20.
 //  Copyright © 2020 Southern Stars. All rights reserved.
 
-#include <iostream>
-#include <fstream>
+#include <cstring>
 
 #include "SSAngle.hpp"
+#include "SSConstellation.hpp"
 #include "SSIdentifier.hpp"
+#include "SSLineReader.hpp"
 
-static vector<string> _bayvec =
-{
-    "alpha",
-    "beta",
-    "gamma",
-    "delta",
-    "epsilon",
-    "zeta",
-    "eta",
-    "theta",
-    "iota",
-    "kappa",
-    "lambda",
-    "mu",
-    "nu",
-    "xi",
-    "omicron",
-    "pi",
-    "rho",
-    "sigma",
-    "tau",
-    "upsilon",
-    "phi",
-    "chi",
-    "psi",
-    "omega",
+// Greek letters of Bayer designations, in order from alpha (1) to omega (24).
+
+static constexpr const char *kGreekLetters[24] =
+{
+    "alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta",
+    "iota", "kappa", "lambda", "mu", "nu", "xi", "omicron", "pi",
+    "rho", "sigma", "tau", "upsilon", "phi", "chi", "psi", "omega"
 };
 
-static vector<string> _convec =
-{
-    "And", "Ant", "Aps", "Aqr", "Aql", "Ara", "Ari", "Aur",
-    "Boo", "Cae", "Cam", "Cnc", "CVn", "CMa", "CMi", "Cap",
-    "Car", "Cas", "Cen", "Cep", "Cet", "Cha", "Cir", "Col",
-    "Com", "CrA", "CrB", "Crv", "Crt", "Cru", "Cyg", "Del",
-    "Dor", "Dra", "Equ", "Eri", "For", "Gem", "Gru", "Her",
-    "Hor", "Hya", "Hyi", "Ind", "Lac", "Leo", "LMi", "Lep",
-    "Lib", "Lup", "Lyn", "Lyr", "Men", "Mic", "Mon", "Mus",
-    "Nor", "Oct", "Oph", "Ori", "Pav", "Peg", "Per", "Phe",
-    "Pic", "Psc", "PsA", "Pup", "Pyx", "Ret", "Sge", "Sgr",
-    "Sco", "Scl", "Sct", "Ser", "Sex", "Tau", "Tel", "Tri",
-    "TrA", "Tuc", "UMa", "UMi", "Vel", "Vir", "Vol", "Vul"
+// Greek letters with their Bayer numbers from 1 to 24, sorted by name.
+
+static constexpr SSNameValue kGreekLetterNumbers[24] =
+{
+    { "alpha", 1 }, { "beta", 2 }, { "chi", 22 }, { "delta", 4 }, { "epsilon", 5 }, { "eta", 7 },
+    { "gamma", 3 }, { "iota", 9 }, { "kappa", 10 }, { "lambda", 11 }, { "mu", 12 }, { "nu", 13 },
+    { "omega", 24 }, { "omicron", 15 }, { "phi", 21 }, { "pi", 16 }, { "psi", 23 }, { "rho", 17 },
+    { "sigma", 18 }, { "tau", 19 }, { "theta", 8 }, { "upsilon", 20 }, { "xi", 14 }, { "zeta", 6 }
 };
 
-static map<string,int> _conmap;
-static map<string,int> _baymap;
+static_assert ( namessorted ( kGreekLetterNumbers ), "Greek letters must be sorted by name" );
+
+// Returns the index from 1 to 88 of a constellation abbreviation (con), or 0 if not recognized.
+// The table is a constant, built at compile time, so any number of threads may search it.
+
+static int string_to_con ( SSStringView con )
+{
+    return findname ( kConstellationIndices, 88, con.data(), con.length() );
+}
+
+// Returns the Bayer number of a Greek letter (str), which may be abbreviated to any number of
+// letters (as "alp" for alpha); if several letters begin the same way, returns the first in order
+// from alpha to omega (so "om" is omicron, not omega). Single Latin letters a-z are numbered from 25,
+// and A-Q from 51. Returns 0 if not recognized.
 
-static int string_to_bayer ( string str )
+static int string_to_bayer ( SSStringView str )
 {
     size_t len = str.length();
+    int bay = 0;
     
     if ( len == 1 )
     {
@@ -69,25 +59,86 @@ static int string_to_bayer ( string str )
     }
     else
     {
-        for ( int i = 0; i < _bayvec.size(); i++ )
-            if ( _bayvec[i].compare ( 0, len, str ) == 0 )
-                return i + 1;
+        for ( size_t k = lowername ( kGreekLetterNumbers, 24, str.data(), len ); k < 24; k++ )
+        {
+            const SSNameValue &letter = kGreekLetterNumbers[k];
+            if ( strlen ( letter.name ) < len || memcmp ( letter.name, str.data(), len ) != 0 )
+                break;
+            
+            if ( bay == 0 || letter.value < bay )
+                bay = letter.value;
+        }
     }
     
-    return 0;
+    return bay;
+}
+
+// Writes an integer (value) to a character buffer (p), exactly like sprintf ( "%0*lld" )
+// with the given minimum (width), but without a terminating null character.
+// Returns a pointer to the character following the last one written.
+
+static char *int_to_chars ( char *p, int64_t value, int width = 0 )
+{
+    char digits[24], *end = digits + sizeof ( digits ), *d = end;
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+
+    do
+    {
+        *--d = '0' + magnitude % 10;
+        magnitude /= 10;
+    }
+    while ( magnitude > 0 );
+
+    if ( value < 0 )
+    {
+        *p++ = '-';
+        width--;
+    }
+
+    for ( int n = (int) ( end - d ); n < width; n++ )
+        *p++ = '0';
+
+    while ( d < end )
+        *p++ = *d++;
+
+    return p;
+}
+
+// Copies a null-terminated string (str) to a character buffer (p), without the null.
+// Returns a pointer to the character following the last one copied.
+
+static char *str_to_chars ( char *p, const char *str )
+{
+    while ( *str )
+        *p++ = *str++;
+
+    return p;
 }
 
-static string bayer_to_string ( int64_t bay )
+static char *bayer_to_chars ( char *p, int64_t bay )
 {
     if ( bay > 50 )
-        return string ( 1, bay - 51 + 'A' );
+        *p++ = (char) ( bay - 51 + 'A' );
     else if ( bay > 24 )
-        return string ( 1, bay - 25 + 'a' );
-    else
-        return _bayvec[ bay - 1 ];
+        *p++ = (char) ( bay - 25 + 'a' );
+    else if ( bay > 0 )
+        p = str_to_chars ( p, kGreekLetters[ bay - 1 ] );
+
+    return p;
+}
+
+// Writes the abbreviation of a constellation (con), from 1 (And) to 88 (Vul),
+// or nothing if the constellation is not valid.
+
+static char *con_to_chars ( char *p, int64_t con )
+{
+    if ( con > 0 && con <= 88 )
+        p = str_to_chars ( p, kConstellations[ con - 1 ] );
+
+    return p;
 }
 
-static int64_t string_to_gcvs ( string str )
+static int64_t string_to_gcvs ( SSStringView str )
 {
     size_t len = str.length();
     int n1 = 0, n2 = 0;
@@ -131,13 +182,13 @@ static int64_t string_to_gcvs ( string str )
         
     if ( len > 3 && str[0] == 'V' && str[1] >= '0' && str[1] <= '9' )
     {
-        return strtoint ( str.substr ( 1, len - 1 ) );
+        return strtoint ( str.data() + 1, len - 1 );
     }
         
     return 0;
 }
 
-string gcvs_to_string ( int64_t n )
+static char *gcvs_to_chars ( char *p, int64_t n )
 {
     int64_t n0 = 0, n1 = 0, n2 = 0;
     
@@ -145,7 +196,7 @@ string gcvs_to_string ( int64_t n )
     
     if ( n < 10 )
     {
-        return string ( 1, 'R' + n - 1 );
+        *p++ = (char) ( 'R' + n - 1 );
     }
     
     // Sequence RR, RS, RT, ... RZ, SS, ST, ... SZ, TT, TU, ... ZZ ***/
@@ -156,7 +207,8 @@ string gcvs_to_string ( int64_t n )
             ;
         n2 = n0 - n2 + 9;
 
-        return string ( 1, 'R' + n1 ) + string ( 1, 'R' + n2 );
+        *p++ = (char) ( 'R' + n1 );
+        *p++ = (char) ( 'R' + n2 );
     }
     
     // Sequence AA, AB, AC, ... AZ, BB, BC, ... BZ, CC, CD, ... QZ
@@ -175,25 +227,58 @@ string gcvs_to_string ( int64_t n )
         if ( n2 >= 'J' - 'A' )
             n2++;
             
-        return string ( 1, 'A' + n1 ) + string ( 1, 'A' + n2 );
+        *p++ = (char) ( 'A' + n1 );
+        *p++ = (char) ( 'A' + n2 );
     }
     
     // Sequence V335, V336, V337, V338, etc.
     
     else
     {
-        return "V" + to_string ( n );
+        *p++ = 'V';
+        p = int_to_chars ( p, n );
     }
     
-    return "";
+    return p;
+}
+
+// Scans an integer from (p) up to (end) as sscanf ( "%d" ) would: skips leading whitespace,
+// then reads an optional sign and digits. If successful, stores the integer in (value),
+// advances (p) past it, and returns true; otherwise returns false. Used instead of sscanf()
+// so identifiers can be parsed from views of a string, without copying them.
+
+static bool scanint ( const char *&p, const char *end, int &value )
+{
+    const char *q = p;
+    while ( q < end && ( *q == ' ' || ( *q >= '\t' && *q <= '\r' ) ) )
+        q++;
+
+    const char *digits = q < end && ( *q == '+' || *q == '-' ) ? q + 1 : q;
+    if ( digits == end || *digits < '0' || *digits > '9' )
+        return false;
+
+    while ( digits < end && *digits >= '0' && *digits <= '9' )
+        digits++;
+
+    value = strtoint ( q, digits - q );
+    p = digits;
+    return true;
 }
 
-int64_t string_to_dm ( string str )
+int64_t string_to_dm ( SSStringView str )
 {
     char     sign = 0, suffix = 0;
     int        zone = 0, num = 0;
     
-    sscanf ( str.c_str(), "%c%d%d%c", &sign, &zone, &num, &suffix );
+    // Same as sscanf ( str, "%c%d%d%c", &sign, &zone, &num, &suffix )
+    
+    const char *p = str.begin(), *end = str.end();
+    if ( p < end )
+    {
+        sign = *p++;
+        if ( scanint ( p, end, zone ) && scanint ( p, end, num ) && p < end )
+            suffix = *p;
+    }
 
     if ( sign == '+' )
         sign = 1;
@@ -216,7 +301,7 @@ int64_t string_to_dm ( string str )
     return sign * 100000000 + zone * 1000000 + num * 10 + suffix;
 }
 
-string dm_to_string ( int64_t dm )
+static char *dm_to_chars ( char *p, int64_t dm )
 {
     int64_t sign = dm / 100000000;
     int64_t    zone = ( dm - sign * 100000000 ) / 1000000;
@@ -239,45 +324,72 @@ string dm_to_string ( int64_t dm )
     else if ( suffix == 5 )
         suffix = 's';
 
+    // Same as sprintf ( "%c%02d %d%c", sign, zone, num, suffix )
+    
+    *p++ = (char) sign;
+    p = int_to_chars ( p, (int) zone, 2 );
+    *p++ = ' ';
+    p = int_to_chars ( p, (int) num );
     if ( suffix > 0 )
-        return format ( "%c%02d %d%c", sign, zone, num, suffix );
-    else
-        return format ( "%c%02d %d", sign, zone, num );
+        *p++ = (char) suffix;
+    
+    return p;
 }
 
-string gj_to_string ( int64_t gj )
+static char *gj_to_chars ( char *p, int64_t gj )
 {
     int64_t d = gj / 10;
     int64_t    c = gj - d * 10;
     
-    static vector<string> compvec = { "", "A", "B", "C", "D" };
-    string comps = compvec[ c ];
-
+    // Same as sprintf ( "%d", d / 10 ) if d is a multiple of 10, otherwise sprintf ( "%.1f", d / 10.0 ),
+    // which is exact: d is far too small for d / 10.0 to round to a different tenth.
+    
     if ( d % 10 == 0 )
-        return format ( "%d", d / 10 ) + comps;
+    {
+        p = int_to_chars ( p, (int) ( d / 10 ) );
+    }
     else
-        return format ( "%.1f", d / 10.0 ) + comps;
+    {
+        p = int_to_chars ( p, d / 10 );
+        *p++ = '.';
+        *p++ = '0' + d % 10;
+    }
+    
+    // Component letter, if any
+
+    if ( c > 0 && c <= 4 )
+        *p++ = 'A' + c - 1;
+    
+    return p;
 }
 
-int64_t string_to_gj ( string str )
+int64_t string_to_gj ( SSStringView str )
 {
-    static map<string,int> compmap = { { "A", 1 }, { "B", 2 }, { "C", 3 }, { "D", 4 } };
+    // Component letters start at the first A, B, C, or D; only a single letter is recognized.
     
-    size_t pos = str.find_first_of ( "ABCD" );
-    string comps = pos == string::npos ? "" : str.substr ( pos, string::npos );
+    size_t pos = 0;
+    while ( pos < str.length() && ( str[pos] < 'A' || str[pos] > 'D' ) )
+        pos++;
     
-    int d = strtofloat64 ( str ) * 10.0 + 0.1;
-    int c = compmap[ comps ];
+    int d = strtofloat64 ( str.data(), str.length() ) * 10.0 + 0.1;
+    int c = pos + 1 == str.length() ? str[pos] - 'A' + 1 : 0;
 
     return 10 * d + c;
 }
 
-int64_t string_to_wds ( string str )
+int64_t string_to_wds ( SSStringView str )
 {
     char    sign = 0;
     int        ra = 0, dec = 0;
     
-    sscanf ( str.c_str(), "%d%c%d", &ra, &sign, &dec );
+    // Same as sscanf ( str, "%d%c%d", &ra, &sign, &dec )
+    
+    const char *p = str.begin(), *end = str.end();
+    if ( scanint ( p, end, ra ) && p < end )
+    {
+        sign = *p++;
+        scanint ( p, end, dec );
+    }
     
     if ( sign == '+' )
         sign = 1;
@@ -290,7 +402,7 @@ int64_t string_to_wds ( string str )
         return 0;
 }
 
-string wds_to_string ( int64_t wds )
+static char *wds_to_chars ( char *p, int64_t wds )
 {
     int64_t ra = wds / 100000;
     int64_t sign = ( wds - ra * 100000 ) / 10000;
@@ -301,15 +413,23 @@ string wds_to_string ( int64_t wds )
     else
         sign = '-';
 
-    return format ( "%05d%c%04d", ra, sign, dec );
+    // Same as sprintf ( "%05d%c%04d", ra, sign, dec )
+    
+    p = int_to_chars ( p, (int) ra, 5 );
+    *p++ = (char) sign;
+    return int_to_chars ( p, (int) dec, 4 );
 }
 
-int64_t string_to_ngcic ( string str )
+int64_t string_to_ngcic ( SSStringView str )
 {
     int        num = 0;
     char    ext = 0;
 
-    sscanf ( str.c_str(), "%d%c", &num, &ext );
+    // Same as sscanf ( str, "%d%c", &num, &ext )
+    
+    const char *p = str.begin(), *end = str.end();
+    if ( scanint ( p, end, num ) && p < end )
+        ext = *p;
     
     if ( ext >= 'A' && ext <= 'I' )
         ext = ext - 'A' + 1;
@@ -324,30 +444,49 @@ int64_t string_to_ngcic ( string str )
         return 0;
 }
 
-string ngcic_to_string ( int64_t ngcic )
+static char *ngcic_to_chars ( char *p, int64_t ngcic )
 {
     int64_t        num = ngcic / 10;
     int64_t        ext = ngcic - num * 10;
     
+    p = int_to_chars ( p, (int) num );
     if ( ext > 0 )
-        return format ( "%d%c", num, ext + 'A' - 1 );
-    else
-        return format ( "%d", num );
+        *p++ = (char) ( ext + 'A' - 1 );
+    
+    return p;
 }
 
-int64_t string_to_pngpk ( string str )
+int64_t string_to_pngpk ( SSStringView str )
 {
     double    lon = 0, lat = 0;
     int        londec = 0, latdec = 0;
     char    sign = 0;
     
+    // PNG and PK numbers are rare enough to scan with sscanf(), from a null-terminated copy
+    // which is kept on the stack unless the string is unusually long.
+    
+    char buf[32];
+    string longstr;
+    char *s = buf;
+    
+    if ( str.length() < sizeof ( buf ) )
+    {
+        memcpy ( buf, str.data(), str.length() );
+        buf[ str.length() ] = 0;
+    }
+    else
+    {
+        longstr = str.toString();
+        s = &longstr[0];
+    }
+    
     // Comvert whitespace in penultimate position to period.
     
-    size_t pos = str.length() - 2;
-    if ( str[pos] == ' ' )
-        str[pos] = '.';
+    size_t len = str.length();
+    if ( len >= 2 && s[len - 2] == ' ' )
+        s[len - 2] = '.';
     
-    sscanf ( str.c_str(), "%lf%c%lf", &lon, &sign, &lat );
+    sscanf ( s, "%lf%c%lf", &lon, &sign, &lat );
 
     londec = lon * 10.0 + 0.1;
     latdec = lat * 10.0 + 0.1;
@@ -363,7 +502,7 @@ int64_t string_to_pngpk ( string str )
         return 0;
 }
 
-string pngpk_to_string ( int64_t pngpk, SSCatalog cat )
+static char *pngpk_to_chars ( char *p, int64_t pngpk, SSCatalog cat )
 {
     int64_t londec = pngpk / 10000;
     int64_t    sign = ( pngpk - londec * 10000 ) / 1000;
@@ -374,19 +513,31 @@ string pngpk_to_string ( int64_t pngpk, SSCatalog cat )
     else
         sign = '-';
     
+    // Same as sprintf ( "%05.1f%c%04.1f" ) for PNG, or sprintf ( "%03.0f%c%04.1f" ) for PK,
+    // of londec / 10.0, sign, and latdec / 10.0. Like printf, PK longitudes exactly halfway
+    // between whole degrees are rounded to the even degree.
+    
     if ( cat == kCatPNG )
-        return format ( "%05.1f%c%04.1f", londec / 10.0, sign, latdec / 10.0 );
+    {
+        p = int_to_chars ( p, londec / 10, 3 );
+        *p++ = '.';
+        *p++ = '0' + londec % 10;
+    }
     else // kCatPK
-        return format ( "%03.0f%c%04.1f", londec / 10.0, sign, latdec / 10.0 );
-}
-
-static void mapinit ( void )
-{
-    for ( int i = 0; i < _bayvec.size(); i++ )
-        _baymap.insert ( { _bayvec[i], i + 1 } );
-
-    for ( int i = 0; i < _convec.size(); i++ )
-        _conmap.insert ( { _convec[i], i + 1 } );
+    {
+        int64_t lon = londec / 10, frac = londec % 10;
+        if ( frac > 5 || ( frac == 5 && lon % 2 == 1 ) )
+            lon++;
+        
+        p = int_to_chars ( p, lon, 3 );
+    }
+    
+    *p++ = (char) sign;
+    p = int_to_chars ( p, latdec / 10, 2 );
+    *p++ = '.';
+    *p++ = '0' + latdec % 10;
+    
+    return p;
 }
 
 SSIdentifier::SSIdentifier ( void )
@@ -414,248 +565,303 @@ int64_t SSIdentifier::identifier ( void )
     return _id % 10000000000000000LL;
 }
 
-SSIdentifier SSIdentifier::fromString ( string str )
-{
-    size_t len = str.length();
-    
-    if ( _conmap.size() == 0 || _baymap.size() == 0 )
-        mapinit();
-
-    // if string begins with "M", attempt to parse a Messier number
-    
-    if ( str.find ( "M" ) == 0 && len > 1 )
-    {
-        int64_t m = strtoint ( str.substr ( 1, len - 1 ) );
-        if ( m > 0 && m <= 110 )
-            return SSIdentifier ( kCatMessier, m );
-    }
+// Returns the position of the first digit in a string (str), or npos if it contains none.
 
-    // if string begins with "C", attempt to parse a Caldwell number
-    
-    if ( str.find ( "C" ) == 0 && len > 1 )
-    {
-        int64_t c = strtoint ( str.substr ( 1, len - 1 ) );
-        if ( c > 0 && c <= 109 )
-            return SSIdentifier ( kCatCaldwell, c );
-    }
-
-    // if string begins with "NGC", attempt to parse a New General Catalog identifier
-    
-    if ( str.find ( "NGC" ) == 0 && len > 3 )
-    {
-        int64_t ngc = string_to_ngcic ( str.substr ( 3, len - 3 ) );
-        if ( ngc )
-            return SSIdentifier ( kCatNGC, ngc );
-    }
-
-    // if string begins with "IC", attempt to parse an Index Catalog identifier
-    
-    if ( str.find ( "IC" ) == 0 && len > 2 )
-    {
-        int64_t ic = string_to_ngcic ( str.substr ( 2, len - 2 ) );
-        if ( ic )
-            return SSIdentifier ( kCatIC, ic );
-    }
-
-    // if string begins with "Mel", attempt to parse a Melotte open cluster identifier
-    
-    if ( str.find ( "Mel" ) == 0 && len > 3 )
-    {
-        size_t pos = str.find_first_of ( "0123456789" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatMel, stoi ( str.substr ( pos, len - pos ) ) );
-    }
-
-    // if string begins with "LBN", attempt to parse a Lynds Bright Nebula cluster identifier
+static size_t find_digit ( SSStringView str )
+{
+    for ( size_t i = 0; i < str.length(); i++ )
+        if ( str[i] >= '0' && str[i] <= '9' )
+            return i;
     
-    if ( str.find ( "LBN" ) == 0 && len > 3 )
-    {
-        int64_t lbn = strtoint ( str.substr ( 3, len - 2 ) );
-        if ( lbn > 0 )
-            return SSIdentifier ( kCatLBN, lbn );
-    }
+    return SSStringView::npos;
+}
 
-    // if string begins with "PNG", attempt to parse a Galactic Planetary Nebula number
-    
-    if ( str.find ( "PNG" ) == 0 && len > 3 )
-    {
-        int64_t png = string_to_pngpk ( str.substr ( 3, len - 3 ) );
-        if ( png )
-            return SSIdentifier ( kCatPNG, png );
-    }
+// Converts the number starting at the first digit anywhere in a string (str), as in "HR 7001",
+// to an integer (num) and returns true; returns false if the string contains no digits.
 
-    // if string begins with "PK", attempt to parse a Perek-Kohoutek planetary nebula number
+static bool find_number ( SSStringView str, int64_t &num )
+{
+    size_t pos = find_digit ( str );
+    if ( pos == SSStringView::npos )
+        return false;
     
-    if ( str.find ( "PK" ) == 0 && len > 2 )
-    {
-        int64_t pk = string_to_pngpk ( str.substr ( 2, len - 2 ) );
-        if ( pk )
-            return SSIdentifier ( kCatPK, pk );
-    }
+    num = strtoint ( str.data() + pos, str.length() - pos );
+    return true;
+}
 
-    // if string begins with "PGC", attempt to parse a Principal Galaxy Catalog identifier
-    
-    if ( str.find ( "PGC" ) == 0 && len > 3 )
-    {
-        int64_t pgc = strtoint ( str.substr ( 3, len - 3 ) );
-        if ( pgc )
-            return SSIdentifier ( kCatPGC, pgc );
-    }
+// Converts the Durchmusterung number starting at the first sign anywhere in a string (str),
+// as in "BD +37 1234", to an integer (dm) and returns true; returns false if the string contains no sign.
 
-    // if string begins with "UGCA", attempt to parse a Uppsala Galaxy Catalog Appendix identifier
-    
-    if ( str.find ( "UGCA" ) == 0 && len > 4 )
+static bool find_dm ( SSStringView str, int64_t &dm )
+{
+    for ( size_t i = 0; i < str.length(); i++ )
     {
-        int64_t ugca = strtoint ( str.substr ( 4, len - 4 ) );
-        if ( ugca )
-            return SSIdentifier ( kCatUGCA, ugca );
+        if ( str[i] == '+' || str[i] == '-' )
+        {
+            dm = string_to_dm ( str.substr ( i ) );
+            return true;
+        }
     }
     
-    // if string begins with "UGC", attempt to parse a Uppsala Galaxy Catalog identifier
-    
-    if ( str.find ( "UGC" ) == 0 && len > 3 )
-    {
-        int64_t ugc = strtoint ( str.substr ( 3, len - 3 ) );
-        if ( ugc )
-            return SSIdentifier ( kCatUGC, ugc );
-    }
+    return false;
+}
 
-    // if string begins with "HR", attempt to parse a Harvard Revised (Bright Star) catalog identifier
-    
-    if ( str.find ( "HR" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "0123456789" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatHR, stoi ( str.substr ( pos, len - pos ) ) );
-    }
-    
-    // if string begins with "HD", attempt to parse a Henry Draper catalog identifier
-    
-    if ( str.find ( "HD" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "0123456789" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatHD, stoi ( str.substr ( pos, len - pos ) ) );
-    }
+// Returns true if a string (str) begins with a prefix (prefix).
 
-    // if string begins with "SAO", attempt to parse a Smithsonian Astrophyiscal Observatory catalog identifier
-    
-    if ( str.find ( "SAO" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "0123456789" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatSAO, stoi ( str.substr ( pos, len - pos ) ) );
-    }
+static inline bool has_prefix ( SSStringView str, const char *prefix )
+{
+    size_t len = strlen ( prefix );
+    return str.length() >= len && memcmp ( str.data(), prefix, len ) == 0;
+}
 
-    // if string begins with "HIP", attempt to parse a Hipparcos catalog identifier
-    
-    if ( str.find ( "HIP" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "0123456789" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatHIP, stoi ( str.substr ( pos, len - pos ) ) );
-    }
+// Returns the next word in a string (str) at or after (pos), and advances (pos) past it.
+// Words are separated by spaces, and never empty, as with tokenize ( str, " " ).
+// Returns an empty view when there are no more words.
 
-    // if string begins with "BD" or "SD", attempt to parse a Bonner Durchmusterung catalog identifier
-    // Note: "SD" is abbrevieation for Southern Durchmusterung, found in SKY2000 Master Star Catalog.
+static SSStringView next_word ( SSStringView str, size_t &pos )
+{
+    while ( pos < str.length() && str[pos] == ' ' )
+        pos++;
     
-    if ( str.find ( "BD" ) == 0 || str.find ( "SD" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "+-" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatBD, string_to_dm ( str.substr ( pos, len - pos ) ) );
-    }
-
-    // if string begins with "CD", attempt to parse a Bonner Durchmusterung catalog identifier
+    size_t start = pos;
+    while ( pos < str.length() && str[pos] != ' ' )
+        pos++;
     
-    if ( str.find ( "CD" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "+-" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatCD, string_to_dm ( str.substr ( pos, len - pos ) ) );
-    }
+    return str.substr ( start, pos - start );
+}
 
-    // if string begins with "CP", attempt to parse a Bonner Durchmusterung catalog identifier
-    
-    if ( str.find ( "CP" ) == 0 )
-    {
-        size_t pos = str.find_first_of ( "+-" );
-        if ( pos != string::npos )
-            return SSIdentifier ( kCatCP, string_to_dm ( str.substr ( pos, len - pos ) ) );
-    }
+// Converts a string (str) to an identifier. The first character of the string selects the
+// catalog prefixes it can begin with, like the first level of a trie, so only those catalogs
+// are tried, in the same order as always; each converts its number directly from the string,
+// without copying any part of it. If none succeeds, the string is tried as a Bayer, Flamsteed,
+// or variable star designation, then as an asteroid or periodic comet number.
+// Returns a null identifier if the string cannot be converted.
 
-    // if string begins with "WDS", attempt to parse a Washington Double Star catalog identifier
+SSIdentifier SSIdentifier::fromString ( SSStringView str )
+{
+    size_t len = str.length();
+    int64_t n = 0;
     
-    if ( str.find ( "WDS" ) == 0 && len > 3 )
+    switch ( len > 0 ? str[0] : 0 )
     {
-        int64_t wds = string_to_wds ( str.substr ( 3, len - 3 ) );
-        if ( wds )
-            return SSIdentifier ( kCatWDS, wds );
+        // "M" is a Messier number; "Mel", a Melotte open cluster.
+            
+        case 'M':
+            n = len > 1 ? strtoint ( str.data() + 1, len - 1 ) : 0;
+            if ( n > 0 && n <= 110 )
+                return SSIdentifier ( kCatMessier, n );
+            
+            if ( has_prefix ( str, "Mel" ) && len > 3 && find_number ( str, n ) )
+                return SSIdentifier ( kCatMel, n );
+            break;
+            
+        // "C" is a Caldwell number; "CD" and "CP", Cordoba and Cape Photographic Durchmusterung stars.
+            
+        case 'C':
+            n = len > 1 ? strtoint ( str.data() + 1, len - 1 ) : 0;
+            if ( n > 0 && n <= 109 )
+                return SSIdentifier ( kCatCaldwell, n );
+            
+            if ( has_prefix ( str, "CD" ) && find_dm ( str, n ) )
+                return SSIdentifier ( kCatCD, n );
+            
+            if ( has_prefix ( str, "CP" ) && find_dm ( str, n ) )
+                return SSIdentifier ( kCatCP, n );
+            break;
+            
+        // "NGC" is a New General Catalog object; "NN", a Gliese-Jahreiss nearby star.
+            
+        case 'N':
+            if ( has_prefix ( str, "NGC" ) && len > 3 )
+            {
+                n = string_to_ngcic ( str.substr ( 3 ) );
+                if ( n )
+                    return SSIdentifier ( kCatNGC, n );
+            }
+            else if ( has_prefix ( str, "NN" ) && len > 2 )
+            {
+                n = string_to_gj ( str.substr ( 2 ) );
+                if ( n )
+                    return SSIdentifier ( kCatGJ, n );
+            }
+            break;
+            
+        // "IC" is an Index Catalog object.
+            
+        case 'I':
+            if ( has_prefix ( str, "IC" ) && len > 2 )
+            {
+                n = string_to_ngcic ( str.substr ( 2 ) );
+                if ( n )
+                    return SSIdentifier ( kCatIC, n );
+            }
+            break;
+            
+        // "LBN" is a Lynds Bright Nebula.
+            
+        case 'L':
+            if ( has_prefix ( str, "LBN" ) && len > 3 )
+            {
+                n = strtoint ( str.data() + 3, len - 3 );
+                if ( n > 0 )
+                    return SSIdentifier ( kCatLBN, n );
+            }
+            break;
+            
+        // "PNG" and "PK" are Galactic and Perek-Kohoutek planetary nebulae; "PGC", a Principal Galaxy Catalog galaxy.
+            
+        case 'P':
+            if ( has_prefix ( str, "PNG" ) && len > 3 )
+            {
+                n = string_to_pngpk ( str.substr ( 3 ) );
+                if ( n )
+                    return SSIdentifier ( kCatPNG, n );
+            }
+            else if ( has_prefix ( str, "PK" ) && len > 2 )
+            {
+                n = string_to_pngpk ( str.substr ( 2 ) );
+                if ( n )
+                    return SSIdentifier ( kCatPK, n );
+            }
+            else if ( has_prefix ( str, "PGC" ) && len > 3 )
+            {
+                n = strtoint ( str.data() + 3, len - 3 );
+                if ( n )
+                    return SSIdentifier ( kCatPGC, n );
+            }
+            break;
+            
+        // "UGCA" and "UGC" are Uppsala Galaxy Catalog Appendix and Uppsala Galaxy Catalog galaxies.
+        // A string beginning with "UGCA" is never a UGC number, since its number would begin with "A".
+            
+        case 'U':
+            if ( has_prefix ( str, "UGCA" ) && len > 4 )
+            {
+                n = strtoint ( str.data() + 4, len - 4 );
+                if ( n )
+                    return SSIdentifier ( kCatUGCA, n );
+            }
+            else if ( has_prefix ( str, "UGC" ) && len > 3 )
+            {
+                n = strtoint ( str.data() + 3, len - 3 );
+                if ( n )
+                    return SSIdentifier ( kCatUGC, n );
+            }
+            break;
+            
+        // "HR", "HD", and "HIP" are Harvard Revised, Henry Draper, and Hipparcos stars.
+            
+        case 'H':
+            if ( has_prefix ( str, "HR" ) && find_number ( str, n ) )
+                return SSIdentifier ( kCatHR, n );
+            
+            if ( has_prefix ( str, "HD" ) && find_number ( str, n ) )
+                return SSIdentifier ( kCatHD, n );
+            
+            if ( has_prefix ( str, "HIP" ) && find_number ( str, n ) )
+                return SSIdentifier ( kCatHIP, n );
+            break;
+            
+        // "SAO" is a Smithsonian Astrophysical Observatory star. "SD", for Southern Durchmusterung,
+        // found in the SKY2000 Master Star Catalog, is a Bonner Durchmusterung star.
+            
+        case 'S':
+            if ( has_prefix ( str, "SAO" ) && find_number ( str, n ) )
+                return SSIdentifier ( kCatSAO, n );
+            
+            if ( has_prefix ( str, "SD" ) && find_dm ( str, n ) )
+                return SSIdentifier ( kCatBD, n );
+            break;
+            
+        // "BD" is a Bonner Durchmusterung star.
+            
+        case 'B':
+            if ( has_prefix ( str, "BD" ) && find_dm ( str, n ) )
+                return SSIdentifier ( kCatBD, n );
+            break;
+            
+        // "WDS" is a Washington Double Star; "Wo", a Gliese-Jahreiss nearby star.
+            
+        case 'W':
+            if ( has_prefix ( str, "WDS" ) && len > 3 )
+            {
+                n = string_to_wds ( str.substr ( 3 ) );
+                if ( n )
+                    return SSIdentifier ( kCatWDS, n );
+            }
+            else if ( has_prefix ( str, "Wo" ) && len > 2 )
+            {
+                n = string_to_gj ( str.substr ( 2 ) );
+                if ( n )
+                    return SSIdentifier ( kCatGJ, n );
+            }
+            break;
+            
+        // "GJ" and "Gl" are Gliese-Jahreiss nearby stars.
+            
+        case 'G':
+            if ( ( has_prefix ( str, "GJ" ) || has_prefix ( str, "Gl" ) ) && len > 2 )
+            {
+                n = string_to_gj ( str.substr ( 2 ) );
+                if ( n )
+                    return SSIdentifier ( kCatGJ, n );
+            }
+            break;
     }
     
-    // if string begins with "GJ", "Gl", "Wo", or "NN", attempt to parse a Gliese-Jahreiss Nearby Star Catalog identifier
+    // If the second word is a constellation abbrevation,
+    // attempt to parse Bayer/Flamsteed/GCVS identifier from the first word.
     
-    if ( ( str.find ( "GJ" ) == 0 || str.find ( "Gl" ) == 0 || str.find ( "NN" ) == 0 || str.find ( "Wo" ) == 0 ) && len > 2 )
-    {
-        int64_t gj = string_to_gj ( str.substr ( 2, len - 2 ) );
-        if ( gj )
-            return SSIdentifier ( kCatGJ, gj );
-    }
-
-    // Tokenize string into words separated by whitespace.
-    // if second token is a constellation abbrevation,
-    // attempt to parse Bayer/Flamsteed/GCVS identifier.
-
-    vector<string> tokens = tokenize ( str, " " );
-    int con = tokens.size() >= 2 ? _conmap[ tokens[1] ] : 0;
+    size_t pos = 0;
+    SSStringView word = next_word ( str, pos );
+    int con = string_to_con ( next_word ( str, pos ) );
     if ( con )
     {
-        string constr = tokens[1];
-
-        // try parsing first token as a variable star designation; return GCVS identifier if successful.
+        // try parsing first word as a variable star designation; return GCVS identifier if successful.
         
-        int64_t var = string_to_gcvs ( tokens[0] );
+        int64_t var = string_to_gcvs ( word );
         if ( var > 0 )
             return SSIdentifier ( kCatGCVS, var * 100 + con );
         
-        // If first token begins with a number, return a Flamsteed catalog identification
+        // If first word begins with a number, return a Flamsteed catalog identification
         
-        size_t pos = tokens[0].find_first_of ( "0123456789" );
-        if ( pos == 0 )
-            return SSIdentifier ( kCatFlamsteed, strtoint ( tokens[0] ) * 100 + con );
-
-        // If first token contains a number, convert numeric portion
-        // of token to integer, then erase numeric portion of token.
+        size_t digit = find_digit ( word );
+        if ( digit == 0 )
+            return SSIdentifier ( kCatFlamsteed, strtoint ( word.data(), word.length() ) * 100 + con );
+        
+        // If first word contains a number, convert numeric portion
+        // of word to integer, then remove numeric portion from word.
         
         int num = 0;
-        if ( pos != string::npos )
+        if ( digit != SSStringView::npos )
         {
-            num = strtoint ( tokens[0].substr ( pos, string::npos ) );
-            tokens[0].erase ( pos, string::npos );
+            num = strtoint ( word.data() + digit, word.length() - digit );
+            word = word.substr ( 0, digit );
         }
         
-        // Try parsing first token as a Bayer letter.  If successful, return
+        // Try parsing first word as a Bayer letter.  If successful, return
         // a Bayer designation with the numeric portion (if any) as superscript
         
-        int bay = string_to_bayer ( tokens[0] );
+        int bay = string_to_bayer ( word );
         if ( bay > 0 )
             return SSIdentifier ( kCatBayer, ( bay * 100 + num ) * 100 + con );
     }
     
     // if string is a number inside paratheses, attempt to parse as an asteroid number
     
-    if ( str[0] == '(' && str[len - 1] == ')' )
+    if ( len > 1 && str[0] == '(' && str[len - 1] == ')' )
     {
-        int64_t n = strtoint ( str.substr ( 1, len - 2 ) );
+        n = strtoint ( str.data() + 1, len - 2 );
         if ( n > 0 )
             return SSIdentifier ( kCatAstNum, n );
     }
     
     // if string is a number followed by "P", parse as a periodic comet number
     
-    if ( str.find ( "P" ) != string::npos )
+    pos = str.find ( 'P' );
+    if ( pos != SSStringView::npos )
     {
-        int64_t n = strtoint ( str.substr ( 0, str.find ( "P" ) ) );
+        n = strtoint ( str.data(), pos );
         if ( n > 0 )
             return SSIdentifier ( kCatComNum, n );
     }
@@ -665,140 +871,184 @@ SSIdentifier SSIdentifier::fromString ( string str )
     return SSIdentifier ( kCatUnknown, 0 );
 }
 
-string SSIdentifier::toString ( void )
-{
-    if ( _conmap.size() == 0 || _baymap.size() == 0 )
-        mapinit();
+// Writes an identifier's catalog (cat) and number in that catalog (id) as a string
+// to a character buffer (p) of at least kMaxChars characters, without a terminating null.
+// Returns a pointer to the character following the last one written.
 
-    SSCatalog cat = catalog();
-    int64_t id = identifier();
-    string str = "";
-    
+static constexpr int kMaxChars = 64;
+
+static char *ident_to_chars ( char *p, SSCatalog cat, int64_t id )
+{
     if ( cat == kCatBayer )
     {
         int64_t bay = id / 10000;
         int64_t num = ( id - bay * 10000 ) / 100;
         int64_t con = id % 100;
         
-        string baystr = bayer_to_string ( bay );
-        string constr = _convec[con - 1];
+        p = bayer_to_chars ( p, bay );
         if ( num > 0 )
-            str = baystr + to_string ( num ) + " " + constr;
-        else
-            str = baystr + " " + constr;
+            p = int_to_chars ( p, num );
+        *p++ = ' ';
+        p = con_to_chars ( p, con );
     }
     else if ( cat == kCatFlamsteed )
     {
         int64_t num = id / 100;
         int64_t con = id % 100;
-        str = to_string ( num ) + " " + _convec[con - 1];
+        p = int_to_chars ( p, num );
+        *p++ = ' ';
+        p = con_to_chars ( p, con );
     }
     else if ( cat == kCatGCVS )
     {
         int64_t num = id / 100;
         int64_t con = id % 100;
-        str = gcvs_to_string ( num ) + " " + _convec[con - 1];
+        p = gcvs_to_chars ( p, num );
+        *p++ = ' ';
+        p = con_to_chars ( p, con );
     }
     else if ( cat == kCatHR )
     {
-        str = "HR " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "HR " ), id );
     }
     else if ( cat == kCatHD )
     {
-        str = "HD " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "HD " ), id );
     }
     else if ( cat == kCatSAO )
     {
-        str = "SAO " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "SAO " ), id );
     }
     else if ( cat == kCatHIP )
     {
-        str = "HIP " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "HIP " ), id );
     }
     else if ( cat == kCatBD )
     {
-        str = "BD " + dm_to_string ( id );
+        p = dm_to_chars ( str_to_chars ( p, "BD " ), id );
     }
     else if ( cat == kCatCD )
     {
-        str = "CD " + dm_to_string ( id );
+        p = dm_to_chars ( str_to_chars ( p, "CD " ), id );
     }
     else if ( cat == kCatCP )
     {
-        str = "CP " + dm_to_string ( id );
+        p = dm_to_chars ( str_to_chars ( p, "CP " ), id );
     }
     else if ( cat == kCatWDS )
     {
-        str = "WDS " + wds_to_string ( id );
+        p = wds_to_chars ( str_to_chars ( p, "WDS " ), id );
     }
     else if ( cat == kCatGJ )
     {
-        str = "GJ " + gj_to_string ( id );
+        p = gj_to_chars ( str_to_chars ( p, "GJ " ), id );
     }
     else if ( cat == kCatMessier )
     {
-        str = "M " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "M " ), id );
     }
     else if ( cat == kCatCaldwell )
     {
-        str = "C " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "C " ), id );
     }
     else if ( cat == kCatNGC )
     {
-        str = "NGC " + ngcic_to_string ( id );
+        p = ngcic_to_chars ( str_to_chars ( p, "NGC " ), id );
     }
     else if ( cat == kCatIC )
     {
-        str = "IC " + ngcic_to_string ( id );
+        p = ngcic_to_chars ( str_to_chars ( p, "IC " ), id );
     }
     else if ( cat == kCatMel )
     {
-        str = "Mel " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "Mel " ), id );
     }
     else if ( cat == kCatLBN )
     {
-        str = "LBN " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "LBN " ), id );
     }
     else if ( cat == kCatPNG )
     {
-        str = "PNG " + pngpk_to_string ( id, cat );
+        p = pngpk_to_chars ( str_to_chars ( p, "PNG " ), id, cat );
     }
     else if ( cat == kCatPK )
     {
-        str = "PK " + pngpk_to_string ( id, cat );
+        p = pngpk_to_chars ( str_to_chars ( p, "PK " ), id, cat );
     }
     else if ( cat == kCatPGC )
     {
-        str = "PGC " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "PGC " ), id );
     }
     else if ( cat == kCatUGC )
     {
-        str = "UGC " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "UGC " ), id );
     }
     else if ( cat == kCatUGCA )
     {
-        str = "UGCA " + to_string ( id );
+        p = int_to_chars ( str_to_chars ( p, "UGCA " ), id );
     }
     else if ( cat == kCatAstNum )
     {
-        str = "(" + to_string ( id ) + ")";
+        *p++ = '(';
+        p = int_to_chars ( p, id );
+        *p++ = ')';
     }
     else if ( cat == kCatComNum )
     {
-        str = to_string ( id ) + "P";
+        p = int_to_chars ( p, id );
+        *p++ = 'P';
     }
     else if ( cat == kCatJPLanet )
     {
-        str = to_string ( id );
+        p = int_to_chars ( p, id );
     }
     else if ( cat == kCatNORADSat )
     {
-        str = to_string ( id );
+        p = int_to_chars ( p, id );
     }
     
+    return p;
+}
+
+// Converts this identifier to a string, like "alpha CMa", "HR 2491", or "M 31".
+// Returns an empty string if the identifier's catalog is unknown.
+
+string SSIdentifier::toString ( void )
+{
+    string str;
+    appendString ( str );
     return str;
 }
 
+// Appends the same string as toString() to an existing string (str),
+// without allocating memory if the string has room for it.
+
+void SSIdentifier::appendString ( string &str )
+{
+    char chars[kMaxChars];
+    str.append ( chars, ident_to_chars ( chars, catalog(), identifier() ) );
+}
+
+// Writes the same string as toString() to a caller-supplied character buffer (buf)
+// which can hold (size) characters, including a terminating null, without allocating any memory.
+// Like snprintf(), the output is truncated if the buffer is too small, and the length
+// of the whole string is returned; 32 characters hold any identifier in a real catalog.
+
+size_t SSIdentifier::toString ( char *buf, size_t size )
+{
+    char chars[kMaxChars];
+    size_t len = ident_to_chars ( chars, catalog(), identifier() ) - chars;
+    
+    if ( size > 0 )
+    {
+        size_t n = len < size ? len : size - 1;
+        memcpy ( buf, chars, n );
+        buf[n] = 0;
+    }
+    
+    return len;
+}
+
 bool compareSSIdentifiers ( const SSIdentifier &id1, const SSIdentifier &id2 )
 {
     return id1 < id2;
@@ -811,8 +1061,8 @@ int SSImportIdentifierNameMap ( const char *filename, SSIdentifierNameMap &nameM
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
 
     // Read file line-by-line until we reach end-of-file
@@ -820,7 +1070,7 @@ int SSImportIdentifierNameMap ( const char *filename, SSIdentifierNameMap &nameM
     string line = "";
     int paircount = 0;
     
-    while ( getline ( file, line ) )
+    while ( file.readLine ( line ) )
     {
         // Split line into tokens separated by commas.
         // Require at least 2 tokens.  First token is name.
@@ -850,7 +1100,7 @@ int SSImportIdentifierNameMap ( const char *filename, SSIdentifierNameMap &nameM
 // from the input identifier-to-name map.  If no names correspond to any identifier,
 // returns a zero-length vector.
 
-vector<string> SSIdentifiersToNames ( SSIdentifierVec &idents, SSIdentifierNameMap &nameMap )
+vector<string> SSIdentifiersToNames ( const SSIdentifierVec &idents, SSIdentifierNameMap &nameMap )
 {
     vector<string> names;
 
@@ -859,7 +1109,7 @@ vector<string> SSIdentifiersToNames ( SSIdentifierVec &idents, SSIdentifierNameM
         auto nameRange = nameMap.equal_range ( ident );
         for ( auto i = nameRange.first; i != nameRange.second; i++ )
         {
-            string name = i->second;
+            const string &name = i->second;
             
             if ( name.length() > 0 && find ( names.begin(), names.end(), name ) == names.end() )
                 names.push_back ( name );
@@ -869,6 +1119,22 @@ vector<string> SSIdentifiersToNames ( SSIdentifierVec &idents, SSIdentifierNameM
     return names;
 }
 
+// Appends the strings of all identifiers in a vector (idents) to an existing string (str),
+// each followed by a delimiter (delim), as in a CSV record. Identifiers of unknown catalogs
+// leave an empty field. No memory is allocated if the string has room for the result.
+// Returns the number of identifiers appended.
+
+int SSAppendIdentifiers ( string &str, const SSIdentifierVec &idents, char delim )
+{
+    for ( SSIdentifier ident : idents )
+    {
+        ident.appendString ( str );
+        str += delim;
+    }
+    
+    return (int) idents.size();
+}
+
 // Adds a new identifier to a vector of identifiers,
 // if the new identifier is valid and not already present in the vector.
 // Returns true if identifier was added, false otherwise;
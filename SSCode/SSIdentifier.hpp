@@ -14,6 +14,8 @@
 #include <string>
 #include <map>
 
+#include "SSStringView.hpp"
+
 using namespace std;
 
 enum SSCatalog
@@ -67,7 +69,9 @@ public:
     int64_t identifier ( void );
     
     string toString ( void );
-    static SSIdentifier fromString ( string s );
+    void appendString ( string &str );
+    size_t toString ( char *buf, size_t size );
+    static SSIdentifier fromString ( SSStringView str );
     
     bool operator > ( SSIdentifier other ) { return _id > other._id; }
     bool operator < ( SSIdentifier &other ) const { return _id < other._id; }
@@ -95,7 +99,8 @@ typedef multimap<SSIdentifier,SSIdentifier> SSIdentifierMap;
 typedef multimap<SSIdentifier,string> SSIdentifierNameMap;
 
 int SSImportIdentifierNameMap ( const char *filename, SSIdentifierNameMap &nameMap );
-vector<string> SSIdentifiersToNames ( SSIdentifierVec &idents, SSIdentifierNameMap &nameMap );
+vector<string> SSIdentifiersToNames ( const SSIdentifierVec &idents, SSIdentifierNameMap &nameMap );
+int SSAppendIdentifiers ( string &str, const SSIdentifierVec &idents, char delim );
 
 bool compareSSIdentifiers ( const SSIdentifier &id1, const SSIdentifier &id2 );
 
@@ -0,0 +1,286 @@
+// SSIdentifierIndex.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/24/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "SSIdentifierIndex.hpp"
+
+// Builds an index of the identifiers of all objects in a vector (objects)
+// in a particular catalog (cat). Objects with no identifier in that catalog are skipped.
+// If several objects share an identifier, the index refers to the first of them.
+
+SSIdentifierIndex::SSIdentifierIndex ( SSObjectVec &objects, SSCatalog cat )
+{
+    vector<pair<int64_t,int>> pairs;
+    pairs.reserve ( objects.size() );
+
+    for ( int i = 0; i < objects.size(); i++ )
+    {
+        SSObject *ptr = objects[i].get();
+        if ( ptr == nullptr )
+            continue;
+
+        SSIdentifier ident = ptr->getIdentifier ( cat );
+        if ( ident )
+            pairs.push_back ( { ident, i } );
+    }
+
+    build ( pairs );
+}
+
+// Builds an index from pairs of identifiers and object indices, in any order.
+// The pairs vector is sorted in place, unless it is already sorted.
+
+SSIdentifierIndex::SSIdentifierIndex ( vector<pair<int64_t,int>> &pairs )
+{
+    build ( pairs );
+}
+
+// Sorts pairs of identifiers and object indices, then copies them into the index,
+// keeping only the lowest object index for each identifier. Then makes the bucket directory.
+
+void SSIdentifierIndex::build ( vector<pair<int64_t,int>> &pairs )
+{
+    if ( ! is_sorted ( pairs.begin(), pairs.end() ) )
+        sort ( pairs.begin(), pairs.end() );
+
+    _keys.reserve ( pairs.size() );
+    _indices.reserve ( pairs.size() );
+
+    for ( size_t k = 0; k < pairs.size(); k++ )
+    {
+        if ( k > 0 && pairs[k].first == pairs[k - 1].first )
+            continue;
+
+        _keys.push_back ( pairs[k].first );
+        _indices.push_back ( pairs[k].second );
+    }
+
+    makeBuckets();
+}
+
+// Divides the range of identifier values in the index evenly into buckets,
+// and records where each bucket starts.
+
+void SSIdentifierIndex::makeBuckets ( void )
+{
+    size_t n = _keys.size();
+    size_t numBuckets = n / kKeysPerBucket + 1;
+    _scale = n > 0 ? numBuckets / ( (double) ( _keys[n - 1] - _keys[0] ) + 1.0 ) : 0.0;
+
+    _buckets.assign ( numBuckets + 1, 0 );
+    for ( size_t k = 0, b = 0; b <= numBuckets; b++ )
+    {
+        while ( k < n && bucket ( _keys[k] ) < b )
+            k++;
+
+        _buckets[b] = (unsigned int) k;
+    }
+}
+
+// Returns the bucket which would contain an identifier (key)
+// within the range of identifiers in this index.
+
+size_t SSIdentifierIndex::bucket ( int64_t key ) const
+{
+    size_t b = (size_t) ( (double) ( key - _keys[0] ) * _scale );
+    return min ( b, _buckets.size() - 2 );
+}
+
+// Returns the index of the object with a particular identifier (ident) in the object vector
+// from which this index was built, or -1 if no object has that identifier.
+
+int SSIdentifierIndex::find ( SSIdentifier ident ) const
+{
+    int64_t key = ident;
+    size_t n = _keys.size();
+
+    if ( n == 0 || key < _keys[0] || key > _keys[n - 1] )
+        return -1;
+
+    size_t b = bucket ( key );
+    vector<int64_t>::const_iterator first = _keys.begin() + _buckets[b];
+    vector<int64_t>::const_iterator last = _keys.begin() + _buckets[b + 1];
+    vector<int64_t>::const_iterator it = lower_bound ( first, last, key );
+
+    if ( it != last && *it == key )
+        return _indices[ it - _keys.begin() ];
+
+    return -1;
+}
+
+// Updates the index after objects have been added to or removed from the vector it was built from,
+// without visiting any objects. If not empty, the renumber vector gives the new index of the object
+// at each old index, or -1 if that object was removed; identifiers of removed objects are dropped,
+// even if another object shares them, since the index only knows the first object with each identifier.
+// Then pairs of identifiers and new object indices (added), in any order, are merged in; an identifier
+// already in the index keeps its object. The added vector is sorted in place, unless it is already sorted.
+// The index is copied once and its bucket directory rebuilt, but no other entries change.
+
+void SSIdentifierIndex::update ( vector<pair<int64_t,int>> &added, const vector<int> &renumber )
+{
+    if ( ! is_sorted ( added.begin(), added.end() ) )
+        sort ( added.begin(), added.end() );
+
+    vector<int64_t> keys;
+    vector<int> indices;
+    keys.reserve ( _keys.size() + added.size() );
+    indices.reserve ( _keys.size() + added.size() );
+
+    for ( size_t k = 0, j = 0; k <= _keys.size(); k++ )
+    {
+        // Copy added identifiers which sort before the next existing one, skipping duplicates.
+
+        while ( j < added.size() && ( k == _keys.size() || added[j].first < _keys[k] ) )
+        {
+            if ( keys.empty() || keys.back() != added[j].first )
+            {
+                keys.push_back ( added[j].first );
+                indices.push_back ( added[j].second );
+            }
+            j++;
+        }
+
+        if ( k == _keys.size() )
+            break;
+
+        // Copy existing identifier with its object's new index, unless the object was removed.
+
+        int index = _indices[k];
+        if ( index < renumber.size() )
+            index = renumber[index];
+
+        if ( index < 0 || ( ! keys.empty() && keys.back() == _keys[k] ) )
+            continue;
+
+        keys.push_back ( _keys[k] );
+        indices.push_back ( index );
+    }
+
+    _keys.swap ( keys );
+    _indices.swap ( indices );
+    makeBuckets();
+}
+
+// Given a catalog identifier (ident), an index of identifiers built from a vector of objects,
+// and that vector of objects, returns a smart pointer to the first object in the vector which
+// matches ident. If the identifier does not match any object, returns a smart pointer to null.
+// Unlike SSIdentifierToObject() with an SSObjectMap, the index is never modified.
+
+SSObjectPtr SSIdentifierToObject ( SSIdentifier ident, const SSIdentifierIndex &index, SSObjectVec &objects )
+{
+    int k = index.find ( ident );
+
+    if ( k >= 0 && k < objects.size() )
+        return objects[k];
+    else
+        return SSObjectPtr ( nullptr );
+}
+
+// Minimum number of objects worth giving to a thread of its own in SSMakeIdentifierIndexes().
+
+static constexpr size_t kMinObjectsPerThread = 16384;
+
+// Collects pairs of identifiers and object indices for objects [first,last) in a vector (objects),
+// walking each object's identifiers only once. The slot array maps each catalog to the vector of
+// pairs in (pairs) it belongs in, or -1 for catalogs which are not wanted. Each vector of pairs
+// is sorted when done.
+
+static void collectIdentifierPairs ( SSObjectVec &objects, size_t first, size_t last, const vector<int> &slot, vector<vector<pair<int64_t,int>>> &pairs )
+{
+    for ( size_t i = first; i < last; i++ )
+    {
+        SSObject *ptr = objects[i].get();
+        if ( ptr == nullptr )
+            continue;
+
+        int n = ptr->getIdentifierCount();
+        for ( int k = 0; k < n; k++ )
+        {
+            SSIdentifier ident = ptr->getIdentifierAtIndex ( k );
+            SSCatalog cat = ident.catalog();
+            if ( ident && cat >= 0 && cat < slot.size() && slot[cat] >= 0 )
+                pairs[ slot[cat] ].push_back ( { ident, (int) i } );
+        }
+    }
+
+    for ( vector<pair<int64_t,int>> &p : pairs )
+        sort ( p.begin(), p.end() );
+}
+
+// Builds an identifier index for each of several catalogs (cats) from a vector of objects,
+// walking each object's identifiers once instead of once per catalog. Unlike the single-catalog
+// SSIdentifierIndex constructor, an object with several identifiers in one catalog is indexed
+// under all of them. The object vector is split into contiguous chunks which are scanned in
+// parallel by up to (numThreads) threads; if zero, uses one thread per hardware core.
+// The sorted pairs from each chunk are then merged. On return, indexes[c] is the index for
+// catalog cats[c]. Returns the total number of identifiers indexed in all catalogs.
+
+int SSMakeIdentifierIndexes ( SSObjectVec &objects, const vector<SSCatalog> &cats, vector<SSIdentifierIndex> &indexes, int numThreads )
+{
+    size_t numCats = cats.size();
+    vector<int> slot;
+
+    for ( size_t c = 0; c < numCats; c++ )
+    {
+        if ( cats[c] >= slot.size() )
+            slot.resize ( cats[c] + 1, -1 );
+        slot[ cats[c] ] = (int) c;
+    }
+
+    // Choose number of chunks; never more than hardware threads, or than the object count justifies.
+
+    if ( numThreads < 1 )
+        numThreads = max ( 1, (int) thread::hardware_concurrency() );
+
+    size_t numChunks = min ( (size_t) numThreads, objects.size() / kMinObjectsPerThread + 1 );
+    size_t chunkSize = ( objects.size() + numChunks - 1 ) / numChunks;
+
+    // Each chunk collects sorted pairs for every catalog. The first chunk runs on this thread.
+
+    vector<vector<vector<pair<int64_t,int>>>> chunkPairs ( numChunks, vector<vector<pair<int64_t,int>>> ( numCats ) );
+    vector<thread> threads;
+
+    for ( size_t t = 1; t < numChunks; t++ )
+    {
+        size_t first = min ( t * chunkSize, objects.size() );
+        size_t last = min ( first + chunkSize, objects.size() );
+        threads.push_back ( thread ( collectIdentifierPairs, ref ( objects ), first, last, cref ( slot ), ref ( chunkPairs[t] ) ) );
+    }
+
+    collectIdentifierPairs ( objects, 0, min ( chunkSize, objects.size() ), slot, chunkPairs[0] );
+
+    for ( thread &t : threads )
+        t.join();
+
+    // Merge sorted pairs from all chunks for each catalog, then build that catalog's index.
+
+    int total = 0;
+    indexes.clear();
+    indexes.reserve ( numCats );
+
+    for ( size_t c = 0; c < numCats; c++ )
+    {
+        vector<pair<int64_t,int>> merged;
+        merged.swap ( chunkPairs[0][c] );
+
+        for ( size_t t = 1; t < numChunks; t++ )
+        {
+            vector<pair<int64_t,int>> &next = chunkPairs[t][c];
+            vector<pair<int64_t,int>> both ( merged.size() + next.size() );
+            merge ( merged.begin(), merged.end(), next.begin(), next.end(), both.begin() );
+            merged.swap ( both );
+            vector<pair<int64_t,int>>().swap ( next );
+        }
+
+        indexes.push_back ( SSIdentifierIndex ( merged ) );
+        total += (int) indexes.back().size();
+    }
+
+    return total;
+}
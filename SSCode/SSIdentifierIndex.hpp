@@ -0,0 +1,57 @@
+// SSIdentifierIndex.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/24/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// A read-optimized index of the objects in a vector by their identifiers in one catalog.
+// The index is a flat array of identifiers sorted in ascending order, with a parallel array
+// of object indices. Lookups interpolate the identifier's position between the smallest
+// and largest identifiers in a directory of buckets, then binary-search only the few
+// identifiers in that bucket; for the evenly-spaced catalog numbers in most star and deep sky
+// catalogs, that is one or two comparisons. Once built, an index changes only when update()
+// is called, so any number of threads may search it at once between updates.
+// SSMakeIdentifierIndexes() builds indexes for several catalogs at once, in one parallel
+// pass over the object vector.
+
+#ifndef SSIdentifierIndex_hpp
+#define SSIdentifierIndex_hpp
+
+#include <utility>
+#include <vector>
+
+#include "SSObject.hpp"
+
+class SSIdentifierIndex
+{
+protected:
+
+    vector<int64_t> _keys;          // identifiers, sorted in ascending order, without duplicates
+    vector<int> _indices;           // index of object with each identifier in object vector
+    vector<unsigned int> _buckets;  // index in _keys of first identifier in each bucket; one extra entry marks end of last bucket
+    double _scale;                  // number of buckets per unit of identifier value
+
+    void build ( vector<pair<int64_t,int>> &pairs );
+    void makeBuckets ( void );
+    size_t bucket ( int64_t key ) const;
+
+public:
+
+    static constexpr int kKeysPerBucket = 2;    // average number of identifiers in each bucket
+
+    SSIdentifierIndex ( void ) { _scale = 0.0; }
+    SSIdentifierIndex ( SSObjectVec &objects, SSCatalog cat );
+    SSIdentifierIndex ( vector<pair<int64_t,int>> &pairs );
+
+    size_t size ( void ) const { return _keys.size(); }
+    SSIdentifier getIdentifier ( size_t k ) const { return SSIdentifier ( _keys[k] ); }
+    int getIndex ( size_t k ) const { return _indices[k]; }
+
+    int find ( SSIdentifier ident ) const;
+    void update ( vector<pair<int64_t,int>> &added, const vector<int> &renumber );
+};
+
+SSObjectPtr SSIdentifierToObject ( SSIdentifier ident, const SSIdentifierIndex &index, SSObjectVec &objects );
+int SSMakeIdentifierIndexes ( SSObjectVec &objects, const vector<SSCatalog> &cats, vector<SSIdentifierIndex> &indexes, int numThreads = 0 );
+
+#endif /* SSIdentifierIndex_hpp */
@@ -5,12 +5,13 @@
 // Copyright © 2020 Southern Stars. All rights reserved.
 
 #include <algorithm>
-#include <iostream>
-#include <fstream>
 
 #include "SSDynamics.hpp"
+#include "SSIdentifierIndex.hpp"
 #include "SSImportHIP.hpp"
 #include "SSImportGJ.hpp"
+#include "SSLineReader.hpp"
+#include "SSStringView.hpp"
 
 // Comverts total proper motion (pm), position angle of motion (pa), and declination (dec)
 // to proper motion in R.A. (pmra) and proper motion in Dec. (pmdec).  All angles in radians.
@@ -66,227 +67,250 @@ int addGJComponentStars ( SSStarPtr pStar, string strGJ, string comps, SSObjectV
     }
 }
 
-// Imports Gliese-Jahreiss Catalog of Nearby Stars, 3rd (preliminary) Ed.:
-// ftp://cdsarc.u-strasbg.fr/cats/V/70A/
-// Imported stars are stored in the provided vector of SSObjects (stars).
-// Names are added from nameMap, wherever possible.
-// Accurate coordinates, proper motion, and HIP identifiers are added from hipStars.
-// CNS lines representing multiple components are split into single components.
-// Returns the total number of stars imported (should be 3849 if successful);
-// original CNS3 contains 3803 lines; but multiples are split and Sun is excluded.
+// Replaces a CNS3 component star's coordinates, distance, and proper motion with values
+// from the matching GJ star with accurate coordinates (found in gjACStars via acMap),
+// adds its HIP, Bayer, Flamsteed, and GCVS identifiers, then adds common names from nameMap.
 
-int SSImportGJCNS3 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &gjACStars, SSObjectVec &stars )
+static void addGJAccurateData ( SSStarPtr pStar, SSIdentifierNameMap &nameMap, SSObjectVec &gjACStars, const SSIdentifierIndex &acMap )
 {
-    // Open file; return on failure.
-
-    ifstream file ( filename );
-    if ( ! file )
-        return ( 0 );
-
-    // Set up matrix for precessing B1950 coordinates and proper motion to J2000
+    SSIdentifierVec idents;
+    SSIdentifier identGJ = pStar->getIdentifier ( kCatGJ );
     
-    SSMatrix precession = SSCoords::getPrecessionMatrix ( SSTime::kB1950 ).transpose();
+    // Look up GJ star with accurate coordinates.  If we find one,
+    // replace CNS3 coordinates and motion with accurate GJ coordinates, distance,
+    // and proper motion (but not radial velocity!), and add HIP identifier.
     
-    // Read file line-by-line until we reach end-of-file
-
-    string line = "";
-    int numStars = 0;
-
-    while ( getline ( file, line ) )
+    SSStarPtr pACStar = SSGetStarPtr ( SSIdentifierToObject ( identGJ, acMap, gjACStars ) );
+    if ( pACStar != nullptr )
     {
-        size_t len = line.length();
-        if ( line.length() < 119 )
-            continue;
-        
-        // Get GJ identifier and components (A, B, C, etc.)
-        // Note we are ignoring the identifier prefix (GJ, Gl, NN, Wo)
-        // and treating all identifiers as GJ numbers.
-        
-        string strGJ = trim ( line.substr ( 2, 6 ) );
-         string comps = trim ( line.substr ( 8, 2 ) );
-
-        // Get Identifier, HD, DM catalog numbers.
+        SSSpherical coords = pStar->getFundamentalCoords();
+        SSSpherical motion = pStar->getFundamentalMotion();
 
-        string strHD = len < 153 ? "" : trim ( line.substr ( 146, 6 ) );
-        string strDM = len < 165 ? "" : trim ( line.substr ( 153, 12 ) );
-
-        // Extract RA and Dec. If either are blank, skip this line.
+        SSSpherical accCoords = pACStar->getFundamentalCoords();
+        SSSpherical accMotion = pACStar->getFundamentalMotion();
         
-        string strRA = trim ( line.substr ( 12,8 ) );
-        string strDec = trim ( line.substr ( 21, 8 ) );
-        if ( strRA.empty() || strDec.empty() )
-            continue;
-        
-        // Extract proper motion and position angle of proper motion
+        coords.lon = accCoords.lon;
+        coords.lat = accCoords.lat;
+        coords.rad = isinf ( accCoords.rad ) ? coords.rad : accCoords.rad;
         
-        string strPM = trim ( line.substr ( 30, 6 ) );
-        string strPA = trim ( line.substr ( 37, 5 ) );
+        motion.lon = accMotion.lon;
+        motion.lat = accMotion.lat;
+        motion.rad = isinf ( accMotion.rad ) ? motion.rad : accMotion.rad;
+
+        idents = pStar->getIdentifiers();
         
-        // Extract radial velocity and spectral type.
+        SSAddIdentifier ( pACStar->getIdentifier ( kCatHIP ), idents );
+        SSAddIdentifier ( pACStar->getIdentifier ( kCatBayer ), idents );
+        SSAddIdentifier ( pACStar->getIdentifier ( kCatFlamsteed ), idents );
+        SSAddIdentifier ( pACStar->getIdentifier ( kCatGCVS ), idents );
         
-        string strRV = trim ( line.substr ( 43, 6 ) );
-        string strSpec = trim ( line.substr ( 54, 12 ) );
+        sort ( idents.begin(), idents.end(), compareSSIdentifiers );
+        pStar->setIdentifiers ( idents );
+        pStar->setFundamentalMotion ( coords, motion );
+    }
+    
+    // Finally add common names to individual stars
+    
+    vector<string> names = SSIdentifiersToNames ( idents, nameMap );
+    if ( names.size() > 0 )
+        pStar->setNames ( names );
+}
 
-        // Extract Johnson V magnitude and B-V color index.
-        
-        string strVmag = trim ( line.substr ( 67, 6 ) );
-        string strBmV = trim ( line.substr ( 76, 5 ) );
+// Converts one line of the CNS3 into one star per component, each updated with accurate
+// coordinates, identifiers, and names as described for SSImportGJCNS3(). Appends the
+// component stars to the star vector; returns the number of stars appended.
+// The precession matrix converts B1950 coordinates to J2000.
 
-        // Extract resulting parallax and standard error of parallax.
-        
-        string strPlx = trim ( line.substr ( 108, 6 ) );
-        string strPlxErr = trim ( line.substr ( 114, 5 ) );
-        
-        // Get B1950 Right Ascension and Declination
-        
-        double ra = degtorad ( strtodeg ( strRA ) * 15.0 );
-        double dec = degtorad ( strtodeg ( strDec ) );
-                
-        // Get B1950 proper motion and position angle;
-        // if both present convert to proper motion in R.A and Dec.
-
-        double pmRA = HUGE_VAL, pmDec = HUGE_VAL;
-        if ( ! strPM.empty() && ! strPA.empty() )
-        {
-            double pm = SSAngle::fromArcsec ( strtofloat64 ( strPM ) );
-            double pa = SSAngle::fromDegrees ( strtofloat64 ( strPA ) );
-            pm_pa_to_pmra_pmdec ( pm, pa, dec, pmRA, pmDec );
-        }
-        
-        // Precess B1950 position and proper motion to J2000
-        
-        SSSpherical coords ( ra, dec, 1.0 );
-        SSSpherical motion ( pmRA, pmDec, 0.0 );
-        
-        SSUpdateStarCoordsAndMotion ( 1950.0, &precession, coords, motion );
+static int parseGJCNS3Record ( SSStringView record, SSMatrix &precession, SSIdentifierNameMap &nameMap, SSObjectVec &gjACStars, const SSIdentifierIndex &acMap, SSObjectVec &stars )
+{
+    size_t len = record.length();
+    if ( record.length() < 119 )
+        return 0;
 
-        // Get parallax in milliarcsec and convert to distance if > 1 mas.
-        
-        float plx = strtofloat ( strPlx );
-        if ( plx > 1.0 )
-            coords.rad = 1000.0 * SSDynamics::kLYPerParsec / plx;
-        
-        // Get radial velocity in km/sec and convert to light speed.
-        
-        motion.rad = strRV.empty() ? HUGE_VAL : strtofloat ( strRV ) / SSDynamics::kLightKmPerSec;
-        
-        // Get Johnson V magnitude
-        
-        float vmag = HUGE_VAL;
-        if ( ! strVmag.empty() )
-            vmag = strtofloat ( strVmag );
-        
-        // Get Johnson B magnitude from color index
-        
-        float bmag = HUGE_VAL;
-        if ( ! strBmV.empty() )
-            bmag = strtofloat ( strBmV ) + vmag;
+    // Get GJ identifier and components (A, B, C, etc.)
+    // Note we are ignoring the identifier prefix (GJ, Gl, NN, Wo)
+    // and treating all identifiers as GJ numbers.
+    
+    SSStringView strGJ = record.column ( 2, 6 );
+    SSStringView comps = record.column ( 8, 2 );
 
-        // Set up identifier vector.  Parse HD, DM identifiers.
-        // We'll add GJ identifier when adding components to star vector.
+    // Get Identifier, HD, DM catalog numbers.
 
-        vector<SSIdentifier> idents ( 0 );
-        SSIdentifier identHD, identDM;
-        
-        if ( ! strHD.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatHD, strtoint ( strHD ) ), idents );
-        
-        if ( ! strDM.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( strDM ), idents );
+    SSStringView strHD = len < 153 ? SSStringView() : record.column ( 146, 6 );
+    SSStringView strDM = len < 165 ? SSStringView() : record.column ( 153, 12 );
 
-        // Attempt to parse variable-star designation.  Avoid strings that start with
-        // "MU", "NU"; these are just capitalized Bayer letters, not legit GCVS idents.
-        
-        if ( len > 189 )
-        {
-            string strName = trim ( line.substr ( 188, string::npos ) );
-            if ( strName.find ( "MU" ) == 0 || strName.find ( "NU" ) == 0 )
-                strName = "";
-            
-            SSIdentifier ident = SSIdentifier::fromString ( strName );
-            SSCatalog cat = ident.catalog();
-            if ( cat == kCatGCVS )
-                SSAddIdentifier ( ident, idents );
-        }
-        
-        // Construct star and insert components into star vector.
+    // Extract RA and Dec. If either are blank, skip this line.
+    
+    SSStringView strRA = record.column ( 12, 8 );
+    SSStringView strDec = record.column ( 21, 8 );
+    if ( strRA.empty() || strDec.empty() )
+        return 0;
+    
+    // Extract proper motion and position angle of proper motion
+    
+    SSStringView strPM = record.column ( 30, 6 );
+    SSStringView strPA = record.column ( 37, 5 );
+    
+    // Extract radial velocity and spectral type.
+    
+    SSStringView strRV = record.column ( 43, 6 );
+    SSStringView strSpec = record.column ( 54, 12 );
 
-        SSObjectPtr pObj = SSNewObject ( kTypeStar );
-        SSStarPtr pStar = SSGetStarPtr ( pObj );
-        if ( pStar == nullptr )
-            continue;
+    // Extract Johnson V magnitude and B-V color index.
+    
+    SSStringView strVmag = record.column ( 67, 6 );
+    SSStringView strBmV = record.column ( 76, 5 );
 
-        pStar->setIdentifiers ( idents );
-        pStar->setFundamentalMotion ( coords, motion );
-        pStar->setVMagnitude ( vmag );
-        pStar->setBMagnitude ( bmag );
-        pStar->setSpectralType ( strSpec );
+    // Extract resulting parallax.
+    
+    SSStringView strPlx = record.column ( 108, 6 );
+    
+    // Get B1950 Right Ascension and Declination
+    
+    double ra = degtorad ( strRA.toSexagesimal() * 15.0 );
+    double dec = degtorad ( strDec.toSexagesimal() );
+            
+    // Get B1950 proper motion and position angle;
+    // if both present convert to proper motion in R.A and Dec.
 
-        // cout << pStar->toCSV() << endl;
-        numStars += addGJComponentStars ( pStar, strGJ, comps, stars );
+    double pmRA = HUGE_VAL, pmDec = HUGE_VAL;
+    if ( ! strPM.empty() && ! strPA.empty() )
+    {
+        double pm = SSAngle::fromArcsec ( strPM.toFloat64() );
+        double pa = SSAngle::fromDegrees ( strPA.toFloat64() );
+        pm_pa_to_pmra_pmdec ( pm, pa, dec, pmRA, pmDec );
     }
     
-    // Set up GJ identifier mapping for retrieving accurate GJ coordinates and HIP identifiers.
+    // Precess B1950 position and proper motion to J2000
     
-    SSObjectMap map = SSMakeObjectMap ( gjACStars, kCatGJ );
+    SSSpherical coords ( ra, dec, 1.0 );
+    SSSpherical motion ( pmRA, pmDec, 0.0 );
     
-    // For each component star in CNS3, find a GJ star with GJ accurate coordinates
-    // and update original CNS3 star's coordinates, parallax, and identifiers.
+    SSUpdateStarCoordsAndMotion ( 1950.0, &precession, coords, motion );
+
+    // Get parallax in milliarcsec and convert to distance if > 1 mas.
     
-    for ( int i = 0; i < stars.size(); i++ )
-    {
-        SSStarPtr pStar = SSGetStarPtr ( stars[i] );
-        if ( pStar == nullptr )
-            continue;
-        
-        SSIdentifierVec idents;
-        SSIdentifier identGJ = pStar->getIdentifier ( kCatGJ );
-        
-        // Look up GJ star with accurate coordinates.  If we find one,
-        // replace CNS3 coordinates and motion with accurate GJ coordinates, distance,
-        // and proper motion (but not radial velocity!), and add HIP identifier.
-        
-        SSStarPtr pACStar = SSGetStarPtr ( SSIdentifierToObject ( identGJ, map, gjACStars ) );
-        if ( pACStar != nullptr )
-        {
-            SSSpherical coords = pStar->getFundamentalCoords();
-            SSSpherical motion = pStar->getFundamentalMotion();
+    float plx = strPlx.toFloat();
+    if ( plx > 1.0 )
+        coords.rad = 1000.0 * SSDynamics::kLYPerParsec / plx;
+    
+    // Get radial velocity in km/sec and convert to light speed.
+    
+    motion.rad = strRV.empty() ? HUGE_VAL : strRV.toFloat() / SSDynamics::kLightKmPerSec;
+    
+    // Get Johnson V magnitude
+    
+    float vmag = HUGE_VAL;
+    if ( ! strVmag.empty() )
+        vmag = strVmag.toFloat();
+    
+    // Get Johnson B magnitude from color index
+    
+    float bmag = HUGE_VAL;
+    if ( ! strBmV.empty() )
+        bmag = strBmV.toFloat() + vmag;
 
-            SSSpherical accCoords = pACStar->getFundamentalCoords();
-            SSSpherical accMotion = pACStar->getFundamentalMotion();
-            
-            coords.lon = accCoords.lon;
-            coords.lat = accCoords.lat;
-            coords.rad = isinf ( accCoords.rad ) ? coords.rad : accCoords.rad;
-            
-            motion.lon = accMotion.lon;
-            motion.lat = accMotion.lat;
-            motion.rad = isinf ( accMotion.rad ) ? motion.rad : accMotion.rad;
+    // Set up identifier vector.  Parse HD, DM identifiers.
+    // We'll add GJ identifier when adding components to star vector.
 
-            idents = pStar->getIdentifiers();
-            
-            SSAddIdentifier ( pACStar->getIdentifier ( kCatHIP ), idents );
-            SSAddIdentifier ( pACStar->getIdentifier ( kCatBayer ), idents );
-            SSAddIdentifier ( pACStar->getIdentifier ( kCatFlamsteed ), idents );
-            SSAddIdentifier ( pACStar->getIdentifier ( kCatGCVS ), idents );
-            
-            sort ( idents.begin(), idents.end(), compareSSIdentifiers );
-            pStar->setIdentifiers ( idents );
-            pStar->setFundamentalMotion ( coords, motion );
-        }
-        
-        // Finally add common names to individual stars
-        
-        vector<string> names = SSIdentifiersToNames ( idents, nameMap );
-        if ( names.size() > 0 )
-            pStar->setNames ( names );
+    vector<SSIdentifier> idents ( 0 );
+    SSIdentifier identHD, identDM;
+    
+    if ( ! strHD.empty() )
+        SSAddIdentifier ( SSIdentifier ( kCatHD, strHD.toInt() ), idents );
+    
+    if ( ! strDM.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( strDM ), idents );
+
+    // Attempt to parse variable-star designation.  Avoid strings that start with
+    // "MU", "NU"; these are just capitalized Bayer letters, not legit GCVS idents.
+    
+    if ( len > 189 )
+    {
+        string strName = record.substr ( 188 ).trim().toString();
+        if ( strName.find ( "MU" ) == 0 || strName.find ( "NU" ) == 0 )
+            strName = "";
+        
+        SSIdentifier ident = SSIdentifier::fromString ( strName );
+        SSCatalog cat = ident.catalog();
+        if ( cat == kCatGCVS )
+            SSAddIdentifier ( ident, idents );
     }
     
-    // Return imported star count; file is closed automatically.
+    // Construct star and insert components into star vector.
+
+    SSObjectPtr pObj = SSNewObject ( kTypeStar );
+    SSStarPtr pStar = SSGetStarPtr ( pObj );
+    if ( pStar == nullptr )
+        return 0;
+
+    pStar->setIdentifiers ( idents );
+    pStar->setFundamentalMotion ( coords, motion );
+    pStar->setVMagnitude ( vmag );
+    pStar->setBMagnitude ( bmag );
+    pStar->setSpectralType ( strSpec.toString() );
+
+    // cout << pStar->toCSV() << endl;
+    size_t first = stars.size();
+    int numStars = addGJComponentStars ( pStar, strGJ.toString(), comps.toString(), stars );
+
+    // For each component star, find a GJ star with GJ accurate coordinates
+    // and update CNS3 star's coordinates, parallax, and identifiers.
+
+    for ( size_t i = first; i < stars.size(); i++ )
+        addGJAccurateData ( SSGetStarPtr ( stars[i] ), nameMap, gjACStars, acMap );
 
     return numStars;
 }
 
+// Returns a record parser which converts one line of the CNS3 into component stars, as described
+// for SSImportGJCNS3(). The name map and accurate-coordinate star vector are used by reference
+// and must outlive the parser.
+
+SSRecordParser SSGJCNS3RecordParser ( SSIdentifierNameMap &nameMap, SSObjectVec &gjACStars )
+{
+    // Set up matrix for precessing B1950 coordinates and proper motion to J2000.
+    // Set up GJ identifier mapping for retrieving accurate GJ coordinates and HIP identifiers.
+
+    SSMatrix precession = SSCoords::getPrecessionMatrix ( SSTime::kB1950 ).transpose();
+    shared_ptr<SSIdentifierIndex> pACIndex ( new SSIdentifierIndex ( gjACStars, kCatGJ ) );
+
+    return [precession, &nameMap, &gjACStars, pACIndex] ( SSStringView record, SSObjectVec &stars ) mutable
+    {
+        return parseGJCNS3Record ( record, precession, nameMap, gjACStars, *pACIndex, stars );
+    };
+}
+
+// Streams the CNS3 into an object sink, one component star at a time.
+// Arguments and cross-identification are the same as SSImportGJCNS3().
+// Returns number of stars accepted by the sink.
+
+int SSImportGJCNS3 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &gjACStars, SSObjectSink &sink )
+{
+    // Open file; return on failure.
+
+    SSCatalogReader reader ( filename, SSGJCNS3RecordParser ( nameMap, gjACStars ) );
+    if ( ! reader.isOpen() )
+        return 0;
+
+    return reader.read ( sink );
+}
+
+// Imports Gliese-Jahreiss Catalog of Nearby Stars, 3rd (preliminary) Ed.:
+// ftp://cdsarc.u-strasbg.fr/cats/V/70A/
+// Imported stars are stored in the provided vector of SSObjects (stars).
+// Names are added from nameMap, wherever possible.
+// Accurate coordinates, proper motion, and HIP identifiers are added from hipStars.
+// CNS lines representing multiple components are split into single components.
+// Returns the total number of stars imported (should be 3849 if successful);
+// original CNS3 contains 3803 lines; but multiples are split and Sun is excluded.
+
+int SSImportGJCNS3 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &gjACStars, SSObjectVec &stars )
+{
+    SSObjectVecSink sink ( stars );
+    return SSImportGJCNS3 ( filename, nameMap, gjACStars, sink );
+}
+
 // Imports Accurate Coordinates for Gliese Catalog Stars:
 // https://cdsarc.unistra.fr/ftp/J/PASP/122/885
 // Imported stars are stored in the provided vector of SSObjects (stars).
@@ -299,29 +323,29 @@ int SSImportGJAC ( const char *filename, SSObjectVec &hipStars, SSObjectVec &sta
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Set up HIP identifier mapping for retrieving Hipparcos stars.
     
-    SSObjectMap map = SSMakeObjectMap ( hipStars, kCatHIP );
+    SSIdentifierIndex map ( hipStars, kCatHIP );
     
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numStars = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        if ( line.length() < 124 )
+        if ( record.length() < 124 )
             continue;
-        
+
         // Get Gl/GJ/NN/Wo Identifier (including component A, B, C, etc.)
         // Get HIP or other identifier.
         
-        string strGJ = trim ( line.substr ( 2, 20 ) );
-        string strHIP = trim ( line.substr ( 22, 13 ) );
+        string strGJ = record.column ( 2, 20 ).toString();
+        SSStringView strHIP = record.column ( 22, 13 );
         
         // Extract components from GJ identifier, then erase from identifier
         
@@ -339,43 +363,38 @@ int SSImportGJAC ( const char *filename, SSObjectVec &hipStars, SSObjectVec &sta
 
         // Extract RA and Dec. If either are blank, skip this line.
         
-        string strRA = trim ( line.substr ( 36, 11 ) );
-        string strDec = trim ( line.substr ( 48, 11 ) );
+        SSStringView strRA = record.column ( 36, 11 );
+        SSStringView strDec = record.column ( 48, 11 );
         if ( strRA.empty() || strDec.empty() )
             continue;
         
         // Extract proper motion in R.A. and Dec.
         
-        string strPMRA = trim ( line.substr ( 61, 6 ) );
-        string strPMDec = trim ( line.substr ( 69, 6 ) );
+        SSStringView strPMRA = record.column ( 61, 6 );
+        SSStringView strPMDec = record.column ( 69, 6 );
         
-        // Extract 2MASS J and H magnitudes
-        
-        string strJmag = trim ( line.substr ( 94, 6 ) );
-        string strHmag = trim ( line.substr ( 101, 6 ) );
-
         // Get J2000 Right Ascension and Declination
         
-        double ra = degtorad ( strtodeg ( strRA ) * 15.0 );
-        double dec = degtorad ( strtodeg ( strDec ) );
+        double ra = degtorad ( strRA.toSexagesimal() * 15.0 );
+        double dec = degtorad ( strDec.toSexagesimal() );
         
         // Convert J2000 proper motion from arcsec to radians
         
         float pmRA = HUGE_VAL;
         if ( ! strPMRA.empty() )
-            pmRA = SSAngle::fromArcsec ( strtofloat ( strPMRA ) ) / cos ( dec );
+            pmRA = SSAngle::fromArcsec ( strPMRA.toFloat() ) / cos ( dec );
         
         float pmDec = HUGE_VAL;
         if ( ! strPMDec.empty() )
-            pmDec = SSAngle::fromArcsec ( strtofloat ( strPMDec ) );
+            pmDec = SSAngle::fromArcsec ( strPMDec.toFloat() );
 
         SSSpherical coords ( ra, dec, HUGE_VAL );
         SSSpherical motion ( pmRA, pmDec, HUGE_VAL );
 
-        // Get 2MASS J and H magnitudes.  Ignored for now.
+        // 2MASS J and H magnitudes in cols 95-100 and 102-107 are ignored for now.
         
-        float vmag = HUGE_VAL; // strJmag.empty() ? HUGE_VAL : strtofloat ( strJmag );
-        float bmag = HUGE_VAL; // strHmag.empty() ? HUGE_VAL : strtofloat ( strHmag );
+        float vmag = HUGE_VAL;
+        float bmag = HUGE_VAL;
 
         // Set up name and identifier vectors.
 
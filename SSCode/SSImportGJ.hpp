@@ -9,8 +9,11 @@
 #define SSImportGJ_hpp
 
 #include "SSStar.hpp"
+#include "SSCatalogStream.hpp"
 
 int SSImportGJCNS3 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &acStars, SSObjectVec &gjStars );
+int SSImportGJCNS3 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &acStars, SSObjectSink &sink );
+SSRecordParser SSGJCNS3RecordParser ( SSIdentifierNameMap &nameMap, SSObjectVec &acStars );
 int SSImportGJAC ( const char *filename, SSObjectVec &hipStars, SSObjectVec &acStars );
 
 #endif /* SSImportGJ_hpp */
@@ -6,10 +6,12 @@
 
 #include <algorithm>
 #include <iostream>
-#include <fstream>
 
 #include "SSDynamics.hpp"
+#include "SSIdentifierIndex.hpp"
 #include "SSImportHIP.hpp"
+#include "SSLineReader.hpp"
+#include "SSStringView.hpp"
 
 // Cleans up some oddball conventions in the Hipparcos star name identification tables
 // for Bayer, Flamsteed, and variable star names so SSIdentifier understands them.
@@ -56,26 +58,26 @@ int SSImportHIPNames ( const char *filename, SSIdentifierNameMap &nameMap )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int nameCount = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        string strHIP = trim ( line.substr ( 17, 6 ) );
-        string strName = trim ( line.substr ( 0, 16 ) );
+        SSStringView strHIP = record.column ( 17, 6 );
+        SSStringView strName = record.column ( 0, 16 );
         
-        int hip = strtoint ( strHIP );
+        int hip = strHIP.toInt();
         if ( ! hip )
             continue;
         
         // cout << hip << "," << strName << endl;
-        nameMap.insert ( { SSIdentifier ( kCatHIP, hip ), strName } );
+        nameMap.insert ( { SSIdentifier ( kCatHIP, hip ), strName.toString() } );
         nameCount++;
     }
 
@@ -130,81 +132,73 @@ int SSImportHIC ( const char *filename, SSObjectVec &stars )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
     
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numStars = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        string strHIP = trim ( line.substr ( 0, 6 ) );
-        string strRA = trim ( line.substr ( 13, 12 ) );
-        string strDec = trim ( line.substr ( 26, 12 ) );
-        string strPMRA = trim ( line.substr ( 155, 6 ) );
-        string strPMDec = trim ( line.substr ( 162, 6 ) );
-        string strMag = trim ( line.substr ( 190, 6 ) );
-        string strBmV = trim ( line.substr ( 202, 6 ) );
-        string strSpec = trim ( line.substr ( 216, 11 ) );
-        string strPlx = trim ( line.substr ( 230, 6 ) );
-        string strRV = trim ( line.substr ( 241, 6 ) );
-        string strVar = trim ( line.substr ( 251, 9 ) );
-        string strVarType = trim ( line.substr ( 261, 3 ) );
-        string strVarPer = trim ( line.substr ( 265, 6 ) );
-        string strVarMax = trim ( line.substr ( 272, 4 ) );
-        string strVarMin = trim ( line.substr ( 277, 4 ) );
-        string strHD = trim ( line.substr ( 359, 6 ) );
-        string strBD = trim ( line.substr ( 320, 10 ) );
-        string strCD = trim ( line.substr ( 334, 10 ) );
-        string strCP = trim ( line.substr ( 348, 10 ) );
-        string strSAO = trim ( line.substr ( 385, 6 ) );
+        SSStringView strHIP = record.column ( 0, 6 );
+        SSStringView strRA = record.column ( 13, 12 );
+        SSStringView strDec = record.column ( 26, 12 );
+        SSStringView strPMRA = record.column ( 155, 6 );
+        SSStringView strPMDec = record.column ( 162, 6 );
+        SSStringView strMag = record.column ( 190, 6 );
+        SSStringView strBmV = record.column ( 202, 6 );
+        SSStringView strSpec = record.column ( 216, 11 );
+        SSStringView strPlx = record.column ( 230, 6 );
+        SSStringView strRV = record.column ( 241, 6 );
+        SSStringView strHD = record.column ( 359, 6 );
+        SSStringView strSAO = record.column ( 385, 6 );
 
         // Get J2000 Right Ascension and Declination
         
         SSSpherical position ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
         SSSpherical velocity ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
         
-        position.lon = SSHourMinSec ( strRA );
-        position.lat = SSDegMinSec ( strDec );
+        position.lon = SSHourMinSec ( strRA.toSexagesimal() );
+        position.lat = SSDegMinSec ( strDec.toSexagesimal() );
         
         // If we have a parallax, use it to compute distance in light years
         
-        float plx = strPlx.empty() ? 0.0 : strtofloat ( strPlx );
+        float plx = strPlx.empty() ? 0.0 : strPlx.toFloat();
         if ( plx > 0.0 )
             position.rad = 1000.0 * SSDynamics::kLYPerParsec / plx;
         
         // Convert proper motion to radians per year
         
         if ( ! strPMRA.empty() )
-            velocity.lon = SSAngle::fromArcsec ( strtofloat ( strPMRA ) ) / cos ( position.lat );
+            velocity.lon = SSAngle::fromArcsec ( strPMRA.toFloat() ) / cos ( position.lat );
         
         if ( ! strPMDec.empty() )
-            velocity.lat = SSAngle::fromArcsec ( strtofloat ( strPMDec ) );
+            velocity.lat = SSAngle::fromArcsec ( strPMDec.toFloat() );
         
         // Convert radial velocity from km/sec to fraction of light speed
         
         if ( ! strRV.empty() )
-            velocity.rad = strtofloat ( strRV ) / SSDynamics::kLightKmPerSec;
+            velocity.rad = strRV.toFloat() / SSDynamics::kLightKmPerSec;
         
         // Get Johnson V magnitude; get B magnitude from B-V color index.
         
-        float vmag = strMag.empty() ? HUGE_VAL : strtofloat ( strMag );
-        float bmag = strBmV.empty() ? HUGE_VAL : strtofloat ( strBmV ) + vmag;
+        float vmag = strMag.empty() ? HUGE_VAL : strMag.toFloat();
+        float bmag = strBmV.empty() ? HUGE_VAL : strBmV.toFloat() + vmag;
         
         vector<SSIdentifier> idents ( 0 );
         vector<string> names ( 0 );
         
         if ( ! strHD.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatHD, strtoint ( strHD ) ), idents );
+            SSAddIdentifier ( SSIdentifier ( kCatHD, strHD.toInt() ), idents );
 
         if ( ! strSAO.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatSAO, strtoint ( strSAO ) ), idents );
+            SSAddIdentifier ( SSIdentifier ( kCatSAO, strSAO.toInt() ), idents );
 
         if ( ! strHIP.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatHIP, strtoint ( strHIP ) ), idents );
+            SSAddIdentifier ( SSIdentifier ( kCatHIP, strHIP.toInt() ), idents );
         
         // Sert identifier vector.  Get name string(s) corresponding to identifier(s).
         // Construct star and insert into star vector.
@@ -222,7 +216,7 @@ int SSImportHIC ( const char *filename, SSObjectVec &stars )
             pStar->setFundamentalMotion ( position, velocity );
             pStar->setVMagnitude ( vmag );
             pStar->setBMagnitude ( bmag );
-            pStar->setSpectralType ( strSpec );
+            pStar->setSpectralType ( strSpec.toString() );
 
             // cout << pStar->toCSV() << endl;
             stars.push_back ( pObj );
@@ -243,25 +237,25 @@ int SSImportHIP2 ( const char *filename, SSObjectVec &stars )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numStars = 0;
     
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        string strHIP = trim ( line.substr ( 0, 6 ) );
-        string strRA = trim ( line.substr ( 15, 13 ) );
-        string strDec = trim ( line.substr ( 29, 13 ) );
-        string strPMRA = trim ( line.substr ( 51, 8 ) );
-        string strPMDec = trim ( line.substr ( 60, 8 ) );
-        string strMag = trim ( line.substr ( 129, 7 ) );
-        string strBmV = trim ( line.substr ( 152, 6 ) );
-        string strPlx = trim ( line.substr ( 43, 7 ) );
+        SSStringView strHIP = record.column ( 0, 6 );
+        SSStringView strRA = record.column ( 15, 13 );
+        SSStringView strDec = record.column ( 29, 13 );
+        SSStringView strPMRA = record.column ( 51, 8 );
+        SSStringView strPMDec = record.column ( 60, 8 );
+        SSStringView strMag = record.column ( 129, 7 );
+        SSStringView strBmV = record.column ( 152, 6 );
+        SSStringView strPlx = record.column ( 43, 7 );
 
         if ( strRA.empty() || strDec.empty() )
             continue;
@@ -271,16 +265,16 @@ int SSImportHIP2 ( const char *filename, SSObjectVec &stars )
 
         // Get right ascension and declination in radians
         
-        position.lon = strtofloat ( strRA );
-        position.lat = strtofloat ( strDec );
+        position.lon = strRA.toFloat();
+        position.lat = strDec.toFloat();
         
         // Get proper motion in RA and Dec and convert to radians per year
         
         if ( ! strPMRA.empty() )
-            velocity.lon = SSAngle::fromArcsec ( strtofloat ( strPMRA ) / 1000.0 ) / cos ( position.lat );
+            velocity.lon = SSAngle::fromArcsec ( strPMRA.toFloat() / 1000.0 ) / cos ( position.lat );
         
         if ( ! strPMDec.empty() )
-            velocity.lat = SSAngle::fromArcsec ( strtofloat ( strPMDec ) / 1000.0 );
+            velocity.lat = SSAngle::fromArcsec ( strPMDec.toFloat() / 1000.0 );
         
         // If proper motion is valid, use it to bring position from J1991.25 to J2000
         
@@ -291,14 +285,14 @@ int SSImportHIP2 ( const char *filename, SSObjectVec &stars )
         
         float vmag = HUGE_VAL;
         if ( ! strMag.empty() )
-            vmag = strtofloat ( strMag );
+            vmag = strMag.toFloat();
         
         // Get B-V color index and use it to convert Hipparcos magnitude to Johnson B and V
         
         float bmv = HUGE_VAL, bmag = HUGE_VAL;
         if ( ! strBmV.empty() )
         {
-            bmv = strtofloat ( strBmV );
+            bmv = strBmV.toFloat();
             vmag += -0.2964 * bmv + 0.1110 * bmv * bmv;
             bmag = vmag + bmv;
         }
@@ -307,7 +301,7 @@ int SSImportHIP2 ( const char *filename, SSObjectVec &stars )
         
         if ( ! strPlx.empty() )
         {
-            float plx = strtofloat ( strPlx );
+            float plx = strPlx.toFloat();
             if ( plx > 1.0 )
                 position.rad = 1000.0 * SSDynamics::kLYPerParsec / plx;
         }
@@ -317,7 +311,7 @@ int SSImportHIP2 ( const char *filename, SSObjectVec &stars )
         vector<SSIdentifier> idents ( 0 );
         vector<string> names ( 0 );
 
-        int hip = strtoint ( strHIP );
+        int hip = strHIP.toInt();
         SSAddIdentifier ( SSIdentifier ( kCatHIP, hip ), idents );
         
         // Sert identifier vector.  Get name string(s) corresponding to identifier(s).
@@ -348,179 +342,202 @@ int SSImportHIP2 ( const char *filename, SSObjectVec &stars )
     return numStars;
 }
 
-// Imports the main Hipparcos star catalog.
-// Adds HR, Bayer/Flamsteed, and GCVS identifiers from auxiliary identification tables (mapHIPtoHR, mapHIPtoBF, mapHIPtoVar).
-// Adds SAO identifiers and radial velocity from Hipparcos Input Catalog (hicStars).
-// Uses position and proper motion with values from Hippacos New Reduction (hip2Stars) if possible.
-// Adds star name strings from a mapping of identifiers to names (nameMap).
-// Stores results in vector of SSObjects (stars).
-// Returns number of objects imported (118218 if successful).
+// Converts one line of the main Hipparcos catalog into a star, cross-identified with
+// the HR, Bayer, and GCVS identifier maps, the HIC and HIP2 stars, and the name map.
+// Appends the star to the star vector and returns 1, or returns 0 on failure.
 
-int SSImportHIP ( const char *filename, SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &gcvsMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars, SSObjectVec &stars )
+static int parseHIPRecord ( SSStringView record, SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &gcvsMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, const SSIdentifierIndex &hicMap, SSObjectVec &hip2Stars, const SSIdentifierIndex &hip2Map, SSObjectVec &stars )
 {
-    // Open file; return on failure.
+    SSStringView strHIP = record.column ( 8, 6 );
+    SSStringView strRA = record.column ( 51, 12 );
+    SSStringView strDec = record.column ( 64, 12 );
+    SSStringView strPMRA = record.column ( 87, 8 );
+    SSStringView strPMDec = record.column ( 96, 8 );
+    SSStringView strMag = record.column ( 41, 5 );
+    SSStringView strBmV = record.column ( 245, 6 );
+    SSStringView strPlx = record.column ( 79, 7 );
+    SSStringView strSpec = record.column ( 435, 12 );
+    SSStringView strHD = record.column ( 390, 6 );
+    SSStringView strBD = record.column ( 398, 9 );
+    SSStringView strCD = record.column ( 409, 9 );
+    SSStringView strCP = record.column ( 420, 9 );
 
-    ifstream file ( filename );
-    if ( ! file )
-        return 0;
+    SSSpherical position ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
+    SSSpherical velocity ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
+    
+    // Get right ascension and convert to radians
+    
+    if ( ! strRA.empty() )
+        position.lon = SSAngle::fromDegrees ( strRA.toFloat() );
+    else
+        position.lon = SSHourMinSec ( record.column ( 17, 11 ).toSexagesimal() );
+    
+    // Get declination and convert to radians
+    
+    if ( ! strDec.empty() )
+        position.lat = SSAngle::fromDegrees ( strDec.toFloat() );
+    else
+        position.lat = SSDegMinSec ( record.column ( 29, 11 ).toSexagesimal() );
+    
+    // Get proper motion in RA and convert to radians per year
+    
+    if ( ! strPMRA.empty() )
+        velocity.lon = SSAngle::fromArcsec ( strPMRA.toFloat() / 1000.0 ) / cos ( position.lat );
+    
+    // Get proper motion in Dec and convert to radians per year
+    
+    if ( ! strPMDec.empty() )
+        velocity.lat = SSAngle::fromArcsec ( strPMDec.toFloat() / 1000.0 );
+    
+    // If proper motion is valid, use it to update position and proper motion from J1991.25 to J2000.
+    
+    if ( ! isinf ( velocity.lon ) && ! isinf ( velocity.lat ) )
+        SSUpdateStarCoordsAndMotion ( 1991.25, nullptr, position, velocity );
+    
+    // Get Johnson V magnitude, and (if present) get B-V color index then compute Johnson B magnitude.
+    
+    float vmag = strMag.empty() ? HUGE_VAL : strMag.toFloat();
+    float bmag = strBmV.empty() ? HUGE_VAL : strBmV.toFloat() + vmag;
 
-    // Make mappings of HIP identifiers to object indices
-    // in HIC and HIP2 star vectors.
+    // If we have a parallax > 1 milliarcsec, use it to compute distance in light years.
+    
+    float plx = strPlx.empty() ? 0.0 : strPlx.toFloat();
+    if ( plx > 0.0 )
+        position.rad = 1000.0 * SSDynamics::kLYPerParsec / plx;
     
-    SSObjectMap hicMap = SSMakeObjectMap ( hicStars, kCatHIP );
-    SSObjectMap hip2Map = SSMakeObjectMap ( hip2Stars, kCatHIP );
+    // Set up name and identifier vectors.
 
-    // Read file line-by-line until we reach end-of-file
+    vector<SSIdentifier> idents ( 0 );
+    vector<string> names ( 0 );
 
-    string line = "";
-    int numStars = 0;
+    // Parse HIP catalog number and add Hipparcos identifier.
+
+    int hip = strHIP.toInt();
+    SSIdentifier hipID = SSIdentifier ( kCatHIP, hip );
+    SSAddIdentifier ( hipID, idents );
+
+    // Add Henry Draper and Durchmusterung identifiers.
     
-    while ( getline ( file, line ) )
-    {
-        string strHIP = trim ( line.substr ( 8, 6 ) );
-        string strRA = trim ( line.substr ( 51, 12 ) );
-        string strDec = trim ( line.substr ( 64, 12 ) );
-        string strPMRA = trim ( line.substr ( 87, 8 ) );
-        string strPMDec = trim ( line.substr ( 96, 8 ) );
-        string strMag = trim ( line.substr ( 41, 5 ) );
-        string strBmV = trim ( line.substr ( 245, 6 ) );
-        string strPlx = trim ( line.substr ( 79, 7 ) );
-        string strSpec = trim ( line.substr ( 435, 12 ) );
-        string strHD = trim ( line.substr ( 390, 6 ) );
-        string strBD = trim ( line.substr ( 398, 9 ) );
-        string strCD = trim ( line.substr ( 409, 9 ) );
-        string strCP = trim ( line.substr ( 420, 9 ) );
+    if ( ! strHD.empty() )
+        SSAddIdentifier ( SSIdentifier ( kCatHD, strHD.toInt() ), idents );
 
-        SSSpherical position ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
-        SSSpherical velocity ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
-        
-        // Get right ascension and convert to radians
-        
-        if ( ! strRA.empty() )
-            position.lon = SSAngle::fromDegrees ( strtofloat ( strRA ) );
-        else
-            position.lon = SSHourMinSec ( trim ( line.substr ( 17, 11 ) ) );
-        
-        // Get declination and convert to radians
-        
-        if ( ! strDec.empty() )
-            position.lat = SSAngle::fromDegrees ( strtofloat ( strDec ) );
-        else
-            position.lat = SSDegMinSec ( trim ( line.substr ( 29, 11 ) ) );
-        
-        // Get proper motion in RA and convert to radians per year
-        
-        if ( ! strPMRA.empty() )
-            velocity.lon = SSAngle::fromArcsec ( strtofloat ( strPMRA ) / 1000.0 ) / cos ( position.lat );
-        
-        // Get proper motion in Dec and convert to radians per year
-        
-        if ( ! strPMDec.empty() )
-            velocity.lat = SSAngle::fromArcsec ( strtofloat ( strPMDec ) / 1000.0 );
-        
-        // If proper motion is valid, use it to update position and proper motion from J1991.25 to J2000.
-        
-        if ( ! isinf ( velocity.lon ) && ! isinf ( velocity.lat ) )
-            SSUpdateStarCoordsAndMotion ( 1991.25, nullptr, position, velocity );
-        
-        // Get Johnson V magnitude, and (if present) get B-V color index then compute Johnson B magnitude.
-        
-        float vmag = strMag.empty() ? HUGE_VAL : strtofloat ( strMag );
-        float bmag = strBmV.empty() ? HUGE_VAL : strtofloat ( strBmV ) + vmag;
+    if ( ! strBD.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( "BD " + strBD.toString() ), idents );
+    
+    if ( ! strCD.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( "CD " + strCD.toString() ), idents );
 
-        // If we have a parallax > 1 milliarcsec, use it to compute distance in light years.
-        
-        float plx = strPlx.empty() ? 0.0 : strtofloat ( strPlx );
-        if ( plx > 0.0 )
-            position.rad = 1000.0 * SSDynamics::kLYPerParsec / plx;
-        
-        // Set up name and identifier vectors.
+    if ( ! strCP.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( "CP " + strCP.toString() ), idents );
 
-        vector<SSIdentifier> idents ( 0 );
-        vector<string> names ( 0 );
+    // Add HR identification (if present) from Bright Star identification table.
+    // Add Bayer and Flamsteed identifier(s) (if present) from Bayer identification table.
+    // Add GCVS identifier(s) from the variable star ident table.
 
-        // Parse HIP catalog number and add Hipparcos identifier.
+    SSAddIdentifiers ( hipID, hrMap, idents );
+    SSAddIdentifiers ( hipID, bayMap, idents );
+    SSAddIdentifiers ( hipID, gcvsMap, idents );
 
-        int hip = strtoint ( strHIP );
-        SSIdentifier hipID = SSIdentifier ( kCatHIP, hip );
-        SSAddIdentifier ( hipID, idents );
+    // Add names(s) from identifier-to-name map.
 
-        // Add Henry Draper and Durchmusterung identifiers.
-        
-        if ( ! strHD.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatHD, strtoint ( strHD ) ), idents );
+    names = SSIdentifiersToNames ( idents, nameMap );
 
-        if ( ! strBD.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( "BD " + strBD ), idents );
+    // If we found a matching Hipparcos New Reduction star,
+    // replace position and velocity with newer values.
+    
+    SSStarPtr pStar = SSGetStarPtr ( SSIdentifierToObject ( hipID, hip2Map, hip2Stars ) );
+    if ( pStar != nullptr )
+    {
+        position = pStar->getFundamentalCoords();
+        velocity = pStar->getFundamentalMotion();
+    }
+
+    // If we found a matching Hipparcos Input Catalog star,
+    // splice in SAO identifier and radial velocity.
+    
+    pStar = SSGetStarPtr ( SSIdentifierToObject ( hipID, hicMap, hicStars ) );
+    if ( pStar != nullptr )
+    {
+        SSIdentifier saoID = pStar->getIdentifier ( kCatSAO );
+        if ( saoID )
+            SSAddIdentifier ( saoID, idents );
         
-        if ( ! strCD.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( "CD " + strCD ), idents );
+        velocity.rad = pStar->getRadVel();
+    }
 
-        if ( ! strCP.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( "CP " + strCP ), idents );
+    // Sert identifier vector.  Get name string(s) corresponding to identifier(s).
+    // Construct star and insert into star vector.
 
-        // Add HR identification (if present) from Bright Star identification table.
-        // Add Bayer and Flamsteed identifier(s) (if present) from Bayer identification table.
-        // Add GCVS identifier(s) from the variable star ident table.
+    sort ( idents.begin(), idents.end(), compareSSIdentifiers );
+    SSObjectType type = kTypeStar;
 
-        SSAddIdentifiers ( hipID, hrMap, idents );
-        SSAddIdentifiers ( hipID, bayMap, idents );
-        SSAddIdentifiers ( hipID, gcvsMap, idents );
+    SSObjectPtr pObj = SSNewObject ( type );
+     pStar = SSGetStarPtr ( pObj );
+    
+    if ( pStar != nullptr )
+    {
+        pStar->setNames ( names );
+        pStar->setIdentifiers ( idents );
+        pStar->setFundamentalMotion ( position, velocity );
+        pStar->setVMagnitude ( vmag );
+        pStar->setBMagnitude ( bmag );
+        pStar->setSpectralType ( strSpec.toString() );
+
+        // cout << pStar->toCSV() << endl;
+        stars.push_back ( pObj );
+        return 1;
+    }
 
-        // Add names(s) from identifier-to-name map.
+    return 0;
+}
 
-        names = SSIdentifiersToNames ( idents, nameMap );
+// Returns a record parser which converts one line of the main Hipparcos catalog into a star,
+// cross-identified as described for SSImportHIP(). The identifier and name maps, and the
+// HIC and HIP2 star vectors, are used by reference and must outlive the parser. Only the main
+// catalog is streamed: the whole HIC and HIP2 catalogs, and an identifier index over each,
+// stay in memory for as long as the parser exists.
 
-        // If we found a matching Hipparcos New Reduction star,
-        // replace position and velocity with newer values.
-        
-        SSStarPtr pStar = SSGetStarPtr ( SSIdentifierToObject ( hipID, hip2Map, hip2Stars ) );
-        if ( pStar != nullptr )
-        {
-            position = pStar->getFundamentalCoords();
-            velocity = pStar->getFundamentalMotion();
-        }
+SSRecordParser SSHIPRecordParser ( SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &gcvsMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars )
+{
+    // Make mappings of HIP identifiers to object indices
+    // in HIC and HIP2 star vectors.
 
-        // If we found a matching Hipparcos Input Catalog star,
-        // splice in SAO identifier and radial velocity.
-        
-        pStar = SSGetStarPtr ( SSIdentifierToObject ( hipID, hicMap, hicStars ) );
-        if ( pStar != nullptr )
-        {
-            SSIdentifier saoID = pStar->getIdentifier ( kCatSAO );
-            if ( saoID )
-                SSAddIdentifier ( saoID, idents );
-            
-            velocity.rad = pStar->getRadVel();
-        }
+    shared_ptr<SSIdentifierIndex> pHICIndex ( new SSIdentifierIndex ( hicStars, kCatHIP ) );
+    shared_ptr<SSIdentifierIndex> pHIP2Index ( new SSIdentifierIndex ( hip2Stars, kCatHIP ) );
 
-        // Sert identifier vector.  Get name string(s) corresponding to identifier(s).
-        // Construct star and insert into star vector.
+    return [&hrMap, &bayMap, &gcvsMap, &nameMap, &hicStars, &hip2Stars, pHICIndex, pHIP2Index] ( SSStringView record, SSObjectVec &stars )
+    {
+        return parseHIPRecord ( record, hrMap, bayMap, gcvsMap, nameMap, hicStars, *pHICIndex, hip2Stars, *pHIP2Index, stars );
+    };
+}
 
-        sort ( idents.begin(), idents.end(), compareSSIdentifiers );
-        SSObjectType type = kTypeStar;
+// Streams the main Hipparcos catalog into an object sink, one star at a time.
+// Arguments and cross-identification are the same as SSImportHIP().
+// Returns number of stars accepted by the sink.
 
-        SSObjectPtr pObj = SSNewObject ( type );
-         pStar = SSGetStarPtr ( pObj );
-        
-        if ( pStar != nullptr )
-        {
-            pStar->setNames ( names );
-            pStar->setIdentifiers ( idents );
-            pStar->setFundamentalMotion ( position, velocity );
-            pStar->setVMagnitude ( vmag );
-            pStar->setBMagnitude ( bmag );
-            pStar->setSpectralType ( strSpec );
+int SSImportHIP ( const char *filename, SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &gcvsMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars, SSObjectSink &sink )
+{
+    // Open file; return on failure.
 
-            // cout << pStar->toCSV() << endl;
-            stars.push_back ( pObj );
-            numStars++;
-        }
-    }
+    SSCatalogReader reader ( filename, SSHIPRecordParser ( hrMap, bayMap, gcvsMap, nameMap, hicStars, hip2Stars ) );
+    if ( ! reader.isOpen() )
+        return 0;
 
-    // Return imported star count; file is closed automatically.
-    
-    return numStars;
+    return reader.read ( sink );
+}
+
+// Imports the main Hipparcos star catalog.
+// Adds HR, Bayer/Flamsteed, and GCVS identifiers from auxiliary identification tables (mapHIPtoHR, mapHIPtoBF, mapHIPtoVar).
+// Adds SAO identifiers and radial velocity from Hipparcos Input Catalog (hicStars).
+// Uses position and proper motion with values from Hippacos New Reduction (hip2Stars) if possible.
+// Adds star name strings from a mapping of identifiers to names (nameMap).
+// Stores results in vector of SSObjects (stars).
+// Returns number of objects imported (118218 if successful).
+
+int SSImportHIP ( const char *filename, SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &gcvsMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars, SSObjectVec &stars )
+{
+    SSObjectVecSink sink ( stars );
+    return SSImportHIP ( filename, hrMap, bayMap, gcvsMap, nameMap, hicStars, hip2Stars, sink );
 }
 
 // Imports Hipparcos HR (Bright Star) identifier table (IDENT3.DOC).
@@ -531,21 +548,21 @@ int SSImportHIPHRIdentifiers ( const char *filename, SSIdentifierMap &map )
 {
     // Open file; return on failure.
     
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
     
     // Read file line-by-line until we reach end-of-file
 
-    string line ( "" );
+    SSStringView record;
     int count = 0;
     
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        string strHR = trim ( line.substr ( 0, 6 ) );
-        string strHIP = trim ( line.substr ( 7, 6 ) );
-        int hip = strtoint ( strHIP );
-        int hr = strtoint ( strHR );
+        SSStringView strHR = record.column ( 0, 6 );
+        SSStringView strHIP = record.column ( 7, 6 );
+        int hip = strHIP.toInt();
+        int hr = strHR.toInt();
         
         if ( hip == 0 || hr == 0 )
             continue;
@@ -568,22 +585,22 @@ int SSImportHIPBayerIdentifiers ( const char *filename, SSIdentifierMap &map )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
     
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int count = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        string strBF = trim ( line.substr ( 0, 11 ) );
-        string strHIP = trim ( line.substr ( 12, 6 ) );
+        SSStringView strBF = record.column ( 0, 11 );
+        SSStringView strHIP = record.column ( 12, 6 );
 
-        SSIdentifier id = SSIdentifier::fromString ( cleanHIPNameString ( strBF ) );
-        int hip = strtoint ( strHIP );
+        SSIdentifier id = SSIdentifier::fromString ( cleanHIPNameString ( strBF.toString() ) );
+        int hip = strHIP.toInt();
 
         if ( hip == 0 || id == 0 )
             continue;
@@ -606,28 +623,28 @@ int SSImportHIPGCVSIdentifiers ( const char *filename, SSIdentifierMap &map )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
     
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int count = 0;
     
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        string strVar = trim ( line.substr ( 0, 11 ) );
-        string strHIP = trim ( line.substr ( 12, 6 ) );
+        SSStringView strVar = record.column ( 0, 11 );
+        SSStringView strHIP = record.column ( 12, 6 );
 
-        int hip = strtoint ( strHIP );
-        SSIdentifier id = SSIdentifier::fromString ( cleanHIPNameString ( strVar ) );
+        int hip = strHIP.toInt();
+        SSIdentifier id = SSIdentifier::fromString ( cleanHIPNameString ( strVar.toString() ) );
         
         // cout << hip << "," << id.toString() << endl;
         
         if ( id == 0 || hip == 0 )
         {
-            cout << "Warning: con't convert " << strVar << " for HIP " << hip << endl;
+            cout << "Warning: con't convert " << strVar.toString() << " for HIP " << hip << endl;
             continue;
         }
         
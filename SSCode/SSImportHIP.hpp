@@ -14,6 +14,7 @@
 #include <string>
 
 #include "SSStar.hpp"
+#include "SSCatalogStream.hpp"
 
 void SSUpdateStarCoordsAndMotion ( double jyear, SSMatrix *pMatrix, SSSpherical &position, SSSpherical &velocity );
 
@@ -25,5 +26,7 @@ int SSImportHIPNames ( const char *filename, SSIdentifierNameMap &nameMap );
 int SSImportHIC ( const char *filename, SSObjectVec &stars );
 int SSImportHIP2 ( const char *filename, SSObjectVec &stars );
 int SSImportHIP ( const char *filename, SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &varMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars, SSObjectVec &stars );
+int SSImportHIP ( const char *filename, SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &varMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars, SSObjectSink &sink );
+SSRecordParser SSHIPRecordParser ( SSIdentifierMap &hrMap, SSIdentifierMap &bayMap, SSIdentifierMap &varMap, SSIdentifierNameMap &nameMap, SSObjectVec &hicStars, SSObjectVec &hip2Stars );
 
 #endif /* SSHipparcos_hpp */
@@ -4,11 +4,10 @@
 // Created by Tim DeBenedictis on 3/24/20.
 // Copyright © 2020 Southern Stars. All rights reserved.
 
-#include <iostream>
-#include <fstream>
-
 #include "SSTime.hpp"
 #include "SSImportMPC.hpp"
+#include "SSLineReader.hpp"
+#include "SSStringView.hpp"
 
 // Reads comet data from a Minor Planet Center comet orbit export file:
 // https://www.minorplanetcenter.net/iau/MPCORB/CometEls.txt
@@ -19,82 +18,79 @@ int SSImportMPCComets ( const string &filename, SSObjectVec &comets )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numLines = 0, numComets = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
         numLines++;
-        if ( line.length() < 160 )
+        if ( record.length() < 160 )
             continue;
         
         // col 1-4: periodic or interstellar comet number, denoted with 'P' or 'I' in column 5.
         // col 6-12: provisional designation. Both currently unused.
 
-        string field = line.substr ( 0, 4 );
-        field = line.substr ( 5, 7 );
-        
         // col 15-18: year/month/day of perihelion passage (TDT)
 
-        int year = strtoint ( line.substr ( 14, 4 ) );
-        int month = strtoint ( line.substr ( 19, 2 ) );
-        double day = strtofloat64 ( line.substr ( 22, 7 ) );
+        int year = record.substr ( 14, 4 ).toInt();
+        int month = record.substr ( 19, 2 ).toInt();
+        double day = record.substr ( 22, 7 ).toFloat64();
         double peridate = year && month && day ? SSTime ( SSDate ( kGregorian, 0.0, year, month, day, 0, 0, 0 ) ).jd : 0.0;
         if ( peridate == 0.0 )
             continue;
                 
         // col 31-39: perihelion distance (AU)
         
-        field = trim ( line.substr ( 30, 9 ) );
-        double q = field.empty() ? HUGE_VAL : strtofloat64 ( field );
+        SSStringView field = record.column ( 30, 9 );
+        double q = field.empty() ? HUGE_VAL : field.toFloat64();
         
         // col 42-49: orbital eccentricity
         
-        field = trim ( line.substr ( 41, 8 ) );
-        double e = field.empty() ? HUGE_VAL : strtofloat64 ( field );
+        field = record.column ( 41, 8 );
+        double e = field.empty() ? HUGE_VAL : field.toFloat64();
         
         // col 52-59: argument of perihelion, J2000.0 (degrees)
         
-        field = trim ( line.substr ( 51, 8 ) );
-        double w = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.column ( 51, 8 );
+        double w = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 62-69: longitude of ascending node, J2000.0 (degrees)
         
-        field = line.substr ( 61, 8 );
-        double n = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.substr ( 61, 8 );
+        double n = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 72-79: inclination, J2000.0 (degrees)
         
-        field = line.substr ( 71, 8 );
-        double i = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.substr ( 71, 8 );
+        double i = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 82-85: epoch for perturbed solution - may be blank
 
-        year = strtoint ( line.substr ( 81, 4 ) );
-        month = strtoint ( line.substr ( 85, 2 ) );
-        day = strtofloat64 ( line.substr ( 87, 2 ) );
+        year = record.substr ( 81, 4 ).toInt();
+        month = record.substr ( 85, 2 ).toInt();
+        day = record.substr ( 87, 2 ).toFloat64();
         double epoch = year && month && day ? SSTime ( SSDate ( kGregorian, 0.0, year, month, day, 0, 0, 0 ) ).jd : 0.0;
         
         // col 92-95: absolute magnitude
         
-        field = trim ( line.substr ( 91, 4 ) );
-        float hmag = field.empty() ? HUGE_VAL : strtofloat ( field );
+        field = record.column ( 91, 4 );
+        float hmag = field.empty() ? HUGE_VAL : field.toFloat();
         
         // col 97-100: magnitude slope parameter
         
-        field = trim ( line.substr ( 96, 5 ) );
-        float gmag = field.empty() ? HUGE_VAL : strtofloat ( field );
+        field = record.column ( 96, 5 );
+        float gmag = field.empty() ? HUGE_VAL : field.toFloat();
 
         // col 103 - 159: name including provisional desingation and/or periodic comet number
         
         vector<string> names;
-        field = trim ( line.substr ( 102, 56 ) );
+        field = record.column ( 102, 56 );
         SSIdentifier number = SSIdentifier::fromString ( field );
         
         // for numbered periodic comets, extract name following slash.
@@ -102,31 +98,31 @@ int SSImportMPCComets ( const string &filename, SSObjectVec &comets )
         if ( number )
         {
             size_t pos = field.find ( "P/" );
-            string name = ( pos == string::npos ) ? field : field.substr ( pos + 2, string::npos );
+            SSStringView name = ( pos == SSStringView::npos ) ? field : field.substr ( pos + 2 );
             if ( ! name.empty() )
-                names.push_back ( name );
+                names.push_back ( name.toString() );
         }
         else
         {
             // extract name in parantheses (if any), preceded by provisional designation
             
-            size_t pos1 = field.find ( "(" );
-            size_t pos2 = field.find ( ")" );
+            size_t pos1 = field.find ( '(' );
+            size_t pos2 = field.find ( ')' );
             
-            if ( pos1 == string::npos || pos2 == string::npos )
+            if ( pos1 == SSStringView::npos || pos2 == SSStringView::npos )
             {
-                names.push_back ( field );
+                names.push_back ( field.toString() );
             }
             else
             {
-                string name1 = trim ( field.substr ( 0, pos1 - 1 ) );
-                string name2 = trim ( field.substr ( pos1 + 1, pos2 - pos1 - 1 ) );
+                SSStringView name1 = field.substr ( 0, pos1 - 1 ).trim();
+                SSStringView name2 = field.substr ( pos1 + 1, pos2 - pos1 - 1 ).trim();
                 
                 if ( ! name1.empty() )
-                    names.push_back ( name1 );
+                    names.push_back ( name1.toString() );
                 
                 if ( ! name2.empty() )
-                    names.push_back ( name2 );
+                    names.push_back ( name2.toString() );
             }
         }
 
@@ -170,36 +166,36 @@ int SSImportMPCAsteroids ( const string &filename, SSObjectVec &asteroids )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numLines = 0, numAsteroids = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
         numLines++;
-        if ( line.length() < 195 )
+        if ( record.length() < 195 )
             continue;
 
         // col 9-13: absolute magnitude
         
-        string field = trim ( line.substr ( 8, 5 ) );
-        float hmag = field.empty() ? HUGE_VAL : strtofloat ( field );
+        SSStringView field = record.column ( 8, 5 );
+        float hmag = field.empty() ? HUGE_VAL : field.toFloat();
         
         // col 15-19: magnitude slope parameter
         
-        field = trim ( line.substr ( 14, 5 ) );
-        float gmag = field.empty() ? HUGE_VAL : strtofloat ( field );
+        field = record.column ( 14, 5 );
+        float gmag = field.empty() ? HUGE_VAL : field.toFloat();
         
         // col 21-25: epoch in packed form
         
-        field = line.substr ( 20, 5 );
+        field = record.substr ( 20, 5 );
         int year = 100 * ( 20 + toupper ( field[0] ) - 'K' );  // century
-        year += strtoint ( field.substr ( 1, 2 ) );
+        year += field.substr ( 1, 2 ).toInt();
         
         int month = 0;
         if ( field[3] >= '1' && field[3] <= '9' )
@@ -221,52 +217,51 @@ int SSImportMPCAsteroids ( const string &filename, SSObjectVec &asteroids )
         
         // col 27-35: Mean anomaly in degrees
         
-        field = trim ( line.substr ( 26, 9 ) );
-        double m = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.column ( 26, 9 );
+        double m = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 38-46: Argument of perihelion in degrees
         
-        field = trim ( line.substr ( 37, 9 ) );
-        double w = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.column ( 37, 9 );
+        double w = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 49-57: Longitude of ascending node in degrees
         
-        field = trim ( line.substr ( 48, 9 ) );
-        double n = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.column ( 48, 9 );
+        double n = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 60-68: Inclination in degrees
         
-        field = trim ( line.substr ( 59, 9 ) );
-        double i = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.column ( 59, 9 );
+        double i = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 71-79: Eccentricity
         
-        field = trim ( line.substr ( 70, 9 ) );
-        double e = field.empty() ? HUGE_VAL : strtofloat64 ( field );
+        field = record.column ( 70, 9 );
+        double e = field.empty() ? HUGE_VAL : field.toFloat64();
         
         // col 81-91: Mean motion in degrees per day
         
-        field = trim ( line.substr ( 80, 11 ) );
-        double mm = field.empty() ? HUGE_VAL : degtorad ( strtofloat64 ( field ) );
+        field = record.column ( 80, 11 );
+        double mm = field.empty() ? HUGE_VAL : degtorad ( field.toFloat64() );
         
         // col 93-103: Semimajor axis in AU.  If not found, compute from mean motion.
         
-        field = trim ( line.substr ( 92, 11 ) );
-        double a = strtofloat64 ( field );
+        double a = record.column ( 92, 11 ).toFloat64();
         if ( a <= 0.0 )
             a = pow ( SSOrbit::kGaussGravHelio / ( mm * mm ), 1.0 / 3.0 );
         
         // col 167-254: asteroid number (may be blank)
         
-        field = trim ( line.substr ( 166, 8 ) );
+        field = record.column ( 166, 8 );
         SSIdentifier number = SSIdentifier::fromString ( field );
         
         // col 167-254: Name or provisional designation
 
         vector<string> names;
-        field = trim ( line.substr ( 175, 19 ) );
+        field = record.column ( 175, 19 );
         if ( ! field.empty() )
-            names.push_back ( field );
+            names.push_back ( field.toString() );
         
         // Allocate new asteroid object with default values
         
@@ -291,3 +286,39 @@ int SSImportMPCAsteroids ( const string &filename, SSObjectVec &asteroids )
 
     return numAsteroids;
 }
+
+// Applies a Minor Planet Center comet orbit file (filename) to a vector of comets (comets)
+// previously imported with SSImportMPCComets(), as described for SSMergeObjects().
+// Periodic comets are matched by number, and other comets by name. If provided, pIndex is
+// an index of the comets' periodic comet numbers, and is updated to match. Counts of changes
+// are returned in summary. Returns the number of comets added, updated, and retired, or 0 if
+// the file could not be read; a failure never retires comets.
+
+int SSUpdateMPCComets ( const string &filename, SSObjectVec &comets, bool retire, SSMergeSummary &summary, SSIdentifierIndex *pIndex )
+{
+    SSObjectVec updates;
+    summary = SSMergeSummary();
+
+    if ( SSImportMPCComets ( filename, updates ) == 0 )
+        return 0;
+
+    return SSMergeObjects ( comets, updates, kCatComNum, retire, summary, pIndex );
+}
+
+// Applies a Minor Planet Center asteroid orbit file (filename) to a vector of asteroids (asteroids)
+// previously imported with SSImportMPCAsteroids(), as described for SSMergeObjects().
+// Numbered asteroids are matched by number, and others by name or provisional designation.
+// If provided, pIndex is an index of the asteroids' numbers, and is updated to match.
+// Counts of changes are returned in summary. Returns the number of asteroids added, updated,
+// and retired, or 0 if the file could not be read; a failure never retires asteroids.
+
+int SSUpdateMPCAsteroids ( const string &filename, SSObjectVec &asteroids, bool retire, SSMergeSummary &summary, SSIdentifierIndex *pIndex )
+{
+    SSObjectVec updates;
+    summary = SSMergeSummary();
+
+    if ( SSImportMPCAsteroids ( filename, updates ) == 0 )
+        return 0;
+
+    return SSMergeObjects ( asteroids, updates, kCatAstNum, retire, summary, pIndex );
+}
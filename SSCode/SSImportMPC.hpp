@@ -9,8 +9,12 @@
 #define SSImportMPC_hpp
 
 #include "SSPlanet.hpp"
+#include "SSCatalogMerge.hpp"
 
 int SSImportMPCComets ( const string &filename, SSObjectVec &comets );
 int SSImportMPCAsteroids ( const string &filename, SSObjectVec &comets );
 
+int SSUpdateMPCComets ( const string &filename, SSObjectVec &comets, bool retire, SSMergeSummary &summary, SSIdentifierIndex *pIndex = nullptr );
+int SSUpdateMPCAsteroids ( const string &filename, SSObjectVec &asteroids, bool retire, SSMergeSummary &summary, SSIdentifierIndex *pIndex = nullptr );
+
 #endif /* SSImportMPC_hpp */
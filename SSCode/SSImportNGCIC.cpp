@@ -7,12 +7,13 @@
 //
 
 #include "SSDynamics.hpp"
+#include "SSIdentifierIndex.hpp"
 #include "SSImportHIP.hpp"
 #include "SSImportNGCIC.hpp"
+#include "SSLineReader.hpp"
+#include "SSStringView.hpp"
 
 #include <algorithm>
-#include <iostream>
-#include <fstream>
 
 // Mapping of NGC-IC numbers to Messier numbers.
 // M 76 has two entries (NGC 650 and NGC 651).
@@ -272,8 +273,10 @@ void addMCIdentifiers ( vector<SSIdentifier> &idents, string ngcicStr )
 
 void addNGCICObjectData ( SSObjectVec &clusters, SSObjectVec &objects )
 {
-    SSObjectMap ngcMap = SSMakeObjectMap ( clusters, kCatNGC );
-    SSObjectMap icMap = SSMakeObjectMap ( clusters, kCatIC );
+    vector<SSIdentifierIndex> indexes;
+    SSMakeIdentifierIndexes ( clusters, { kCatNGC, kCatIC }, indexes );
+    SSIdentifierIndex &ngcIndex = indexes[0];
+    SSIdentifierIndex &icIndex = indexes[1];
 
     // For each NGC-IC object...
     
@@ -289,12 +292,12 @@ void addNGCICObjectData ( SSObjectVec &clusters, SSObjectVec &objects )
         // first using object's NGC identifier, then IC identifier.
         
         SSIdentifier ident = objects[i]->getIdentifier ( kCatNGC );
-        SSDeepSkyPtr pCluster = SSGetDeepSkyPtr ( SSIdentifierToObject ( ident, ngcMap, clusters ) );
+        SSDeepSkyPtr pCluster = SSGetDeepSkyPtr ( SSIdentifierToObject ( ident, ngcIndex, clusters ) );
         
         if ( pCluster == nullptr )
         {
             SSIdentifier ident = objects[i]->getIdentifier ( kCatIC );
-            pCluster = SSGetDeepSkyPtr ( SSIdentifierToObject ( ident, icMap, clusters ) );
+            pCluster = SSGetDeepSkyPtr ( SSIdentifierToObject ( ident, icIndex, clusters ) );
         }
         
         // Continue if we don't find other corresponding object.
@@ -345,39 +348,40 @@ int SSImportNGCIC ( const char *filename, SSIdentifierNameMap &nameMap, SSObject
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
+    vector<SSStringView> tokens;
     int numObjects = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
         // Split line into tokens separated by tabs.
         // Require at least 27 tokens.
         
-        vector<string> tokens = split ( line, "\t" );
+        record.split ( "\t", tokens );
         if ( tokens.size() < 27 )
             continue;
         
         // Trim leading and trailing whitespace from tokens.
         
         for ( int i = 0; i < tokens.size(); i++ )
-            tokens[i] = trim ( tokens[i] );
+            tokens[i] = tokens[i].trim();
         
         // Skip entries that are duplicates of the same NGC or IC number.
 
         if ( ! tokens[3].empty() )
-            if ( strtoint ( tokens[3] ) > 1 )
+            if ( tokens[3].toInt() > 1 )
                 continue;
         
         // Get object type from status. Status 7 and 8 are duplicates of other objects; skip them.
         // Status 9 indicates stars and status 10 (not found) are unknown/nonexistent objects.
         
-        int status = strtoint ( tokens[5] );
+        int status = tokens[5].toInt();
         SSObjectType type = kTypeNonexistent;
         
         if ( status == 1 )
@@ -404,8 +408,8 @@ int SSImportNGCIC ( const char *filename, SSIdentifierNameMap &nameMap, SSObject
         
         // Get RA and Dec and convert to radians.
         
-        string strRA = tokens[8] + " " + tokens[9] + " " + tokens[10];
-        string strDec = tokens[11] + tokens[12] + " " + tokens[13] + " " + tokens[14];
+        string strRA = tokens[8].toString() + " " + tokens[9].toString() + " " + tokens[10].toString();
+        string strDec = tokens[11].toString() + tokens[12].toString() + " " + tokens[13].toString() + " " + tokens[14].toString();
         
         SSHourMinSec ra ( strRA );
         SSDegMinSec dec ( strDec );
@@ -415,29 +419,29 @@ int SSImportNGCIC ( const char *filename, SSIdentifierNameMap &nameMap, SSObject
         
         // Get Johnson V and B magnitudes, if present.
         
-        float vmag = tokens[16].empty() ? HUGE_VAL : strtofloat ( tokens[16] );
-        float bmag = tokens[15].empty() ? HUGE_VAL : strtofloat ( tokens[15] );
+        float vmag = tokens[16].empty() ? HUGE_VAL : tokens[16].toFloat();
+        float bmag = tokens[15].empty() ? HUGE_VAL : tokens[15].toFloat();
 
         // Get angular dimensions in arcmin and position angle in arcsec, and convert to radians
         
-        float sizeX = tokens[19].empty() ? HUGE_VAL : strtofloat ( tokens[19] ) * SSAngle::kRadPerArcmin;
-        float sizeY = tokens[20].empty() ? HUGE_VAL : strtofloat ( tokens[20] ) * SSAngle::kRadPerArcmin;
-        float pa = tokens[21].empty() ? HUGE_VAL : strtofloat ( tokens[21] ) * SSAngle::kRadPerDeg;
+        float sizeX = tokens[19].empty() ? HUGE_VAL : tokens[19].toFloat() * SSAngle::kRadPerArcmin;
+        float sizeY = tokens[20].empty() ? HUGE_VAL : tokens[20].toFloat() * SSAngle::kRadPerArcmin;
+        float pa = tokens[21].empty() ? HUGE_VAL : tokens[21].toFloat() * SSAngle::kRadPerDeg;
 
         // Get redshift and convert to radial velocity as fraction of light speed.
         
-        motion.rad = tokens[23].empty() ? HUGE_VAL : SSDynamics::redShiftToRadVel ( strtofloat ( tokens[23] ) );
+        motion.rad = tokens[23].empty() ? HUGE_VAL : SSDynamics::redShiftToRadVel ( tokens[23].toFloat() );
         
         // Get distance in megaparsecs and convert to light years.  Prefer metric distance over redshift-derived.
         
         if ( ! tokens[25].empty() )
-            coords.rad = strtofloat ( tokens[25] ) * 1.0e6 * SSDynamics::kLYPerParsec;
+            coords.rad = tokens[25].toFloat() * 1.0e6 * SSDynamics::kLYPerParsec;
         else if ( ! tokens[24].empty() )
-            coords.rad = strtofloat ( tokens[24] ) * 1.0e6 * SSDynamics::kLYPerParsec;
+            coords.rad = tokens[24].toFloat() * 1.0e6 * SSDynamics::kLYPerParsec;
         
         // Get Hubble morphological type
         
-        string strType = tokens[22];
+        string strType = tokens[22].toString();
         
         // Generate NGC-IC identifier, if present.
         
@@ -451,9 +455,9 @@ int SSImportNGCIC ( const char *filename, SSIdentifierNameMap &nameMap, SSObject
         string ngcicStr = "";
         
         if ( tokens[0][0] == 'N' )
-            ngcicStr = "NGC " + tokens[1] + tokens[2];
+            ngcicStr = "NGC " + tokens[1].toString() + tokens[2].toString();
         else if ( tokens[0][0] == 'I' )
-            ngcicStr = "IC " + tokens[1] + tokens[2];
+            ngcicStr = "IC " + tokens[1].toString() + tokens[2].toString();
 
         SSAddIdentifier ( SSIdentifier::fromString ( ngcicStr ), idents );
         addMCIdentifiers ( idents, ngcicStr );
@@ -461,7 +465,7 @@ int SSImportNGCIC ( const char *filename, SSIdentifierNameMap &nameMap, SSObject
         // Get Principal Galaxy Catalog number, if any.
         
         if ( ! tokens[26].empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatPGC, strtoint ( tokens[26] ) ), idents );
+            SSAddIdentifier ( SSIdentifier ( kCatPGC, tokens[26].toInt() ), idents );
 
         // Get additional identifiers from remaining tokens.
         
@@ -517,56 +521,56 @@ int SSImportDAML02 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjec
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numClusters = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
         // Get R.A. and Dec; convert to radians
         
-        string strRA = line.substr ( 18, 8 );
-        string strDec = line.substr ( 28, 9 );
+        SSStringView strRA = record.substr ( 18, 8 );
+        SSStringView strDec = record.substr ( 28, 9 );
         
-        SSHourMinSec ra ( strRA );
-        SSDegMinSec dec ( strDec );
+        SSHourMinSec ra ( strRA.toSexagesimal() );
+        SSDegMinSec dec ( strDec.toSexagesimal() );
         
         SSSpherical coords ( SSAngle ( ra ), SSAngle ( dec ), HUGE_VAL );
         SSSpherical motion ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
 
         // Get proper motion in R.A. and convert to radians/year
 
-        string strPMRA = trim ( line.substr ( 84, 6 ) );
+        SSStringView strPMRA = record.column ( 84, 6 );
         if ( ! strPMRA.empty() )
-            motion.lon = SSAngle::fromArcsec ( strtofloat ( strPMRA ) / 1000.0 ) / cos ( coords.lat );
+            motion.lon = SSAngle::fromArcsec ( strPMRA.toFloat() / 1000.0 ) / cos ( coords.lat );
 
         // Get proper motion in Dec. and convert to radians/year
 
-        string strPMDec = trim ( line.substr ( 100, 6 ) );
+        SSStringView strPMDec = record.column ( 100, 6 );
         if ( ! strPMDec.empty() )
-            motion.lat = SSAngle::fromArcsec ( strtofloat ( strPMDec ) / 1000.0 );
+            motion.lat = SSAngle::fromArcsec ( strPMDec.toFloat() / 1000.0 );
 
         // Get radial velocity in km/sec and convert to fraction of light speed
         
-        string strRV = trim ( line.substr ( 127, 6 ) );
+        SSStringView strRV = record.column ( 127, 6 );
         if ( ! strRV.empty() )
-            motion.rad = strtofloat ( strRV ) / SSDynamics::kLightKmPerSec;
+            motion.rad = strRV.toFloat() / SSDynamics::kLightKmPerSec;
 
         // Get distance in parsecs and convert to light years
 
-        string strDist = trim ( line.substr ( 55, 5 ) );
+        SSStringView strDist = record.column ( 55, 5 );
         if ( ! strDist.empty() )
-            coords.rad = strtofloat ( strDist ) * SSDynamics::kLYPerParsec;
+            coords.rad = strDist.toFloat() * SSDynamics::kLYPerParsec;
         
         // Get angular diameter in arcmin and convert to radians
         
-        string strDiam = trim ( line.substr ( 46, 5 ) );
-        float diam = strDiam.empty() ? HUGE_VAL : degtorad ( strtofloat ( strDiam ) / 60.0 );
+        SSStringView strDiam = record.column ( 46, 5 );
+        float diam = strDiam.empty() ? HUGE_VAL : degtorad ( strDiam.toFloat() / 60.0 );
 
         // Get name. Attempt to parse identifier from it.  If we recognize the name
         // as an identifier, add Messier and Caldwell numbers; get names from identifiers,
@@ -575,7 +579,7 @@ int SSImportDAML02 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjec
         vector<string> names;
         vector<SSIdentifier> idents;
         
-        string name = trim ( line.substr ( 0, 18 ) );
+        string name = record.column ( 0, 18 ).toString();
         SSIdentifier ident = SSIdentifier::fromString ( name );
         
         if ( ident )
@@ -622,58 +626,58 @@ int SSImportMWGC ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectV
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return ( 0 );
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int numClusters = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
         // Get R.A. and Dec; convert to radians
         
-        string strRA = line.substr ( 24, 11 );
-        string strDec = line.substr ( 37, 11 );
+        SSStringView strRA = record.substr ( 24, 11 );
+        SSStringView strDec = record.substr ( 37, 11 );
         
-        SSHourMinSec ra ( strRA );
-        SSDegMinSec dec ( strDec );
+        SSHourMinSec ra ( strRA.toSexagesimal() );
+        SSDegMinSec dec ( strDec.toSexagesimal() );
         
         SSSpherical coords ( SSAngle ( ra ), SSAngle ( dec ), HUGE_VAL );
         SSSpherical motion ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
 
         // Get V magnitude
         
-        string strVmag = trim ( line.substr ( 126, 5 ) );
-        float vmag = strVmag.empty() ? HUGE_VAL : strtofloat ( strVmag );
+        SSStringView strVmag = record.column ( 126, 5 );
+        float vmag = strVmag.empty() ? HUGE_VAL : strVmag.toFloat();
         
         // Get B magnitude from color index
         
-        string strBmV = trim ( line.substr ( 147, 4 ) );
-        float bmag = strBmV.empty() ? HUGE_VAL : strtofloat ( strBmV ) + vmag;
+        SSStringView strBmV = record.column ( 147, 4 );
+        float bmag = strBmV.empty() ? HUGE_VAL : strBmV.toFloat() + vmag;
             
         // Get radial velocity in km/sec and convert to fraction of light speed
         
-        string strRV = trim ( line.substr ( 177, 6 ) );
+        SSStringView strRV = record.column ( 177, 6 );
         if ( ! strRV.empty() )
-            motion.rad = strtofloat ( strRV ) / SSDynamics::kLightKmPerSec;
+            motion.rad = strRV.toFloat() / SSDynamics::kLightKmPerSec;
 
         // Get distance in kiloparsecs and convert to light years
 
-        string strDist = trim ( line.substr ( 67, 5 ) );
+        SSStringView strDist = record.column ( 67, 5 );
         if ( ! strDist.empty() )
-            coords.rad = strtofloat ( strDist ) * 1000.0 * SSDynamics::kLYPerParsec;
+            coords.rad = strDist.toFloat() * 1000.0 * SSDynamics::kLYPerParsec;
         
         // Get half-light radius in arcmin and convert to diameter in radians
         
-        string strRad = trim ( line.substr ( 230, 4 ) );
-        float diam = strRad.empty() ? HUGE_VAL : 2.0 * degtorad ( strtofloat ( strRad ) / 60.0 );
+        SSStringView strRad = record.column ( 230, 4 );
+        float diam = strRad.empty() ? HUGE_VAL : 2.0 * degtorad ( strRad.toFloat() / 60.0 );
 
         // Get spectral type
         
-        string specStr = trim ( line.substr ( 165, 4 ) );
+        SSStringView specStr = record.column ( 165, 4 );
 
         // Get name. Attempt to parse identifier from it.  If we recognize the name
         // as an identifier, add Messier and Caldwell numbers; get names from identifiers,
@@ -682,7 +686,7 @@ int SSImportMWGC ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectV
         vector<string> names;
         vector<SSIdentifier> idents;
 
-        string name = trim ( line.substr ( 0, 9 ) );
+        string name = record.column ( 0, 9 ).toString();
         SSIdentifier ident = SSIdentifier::fromString ( name );
 
         if ( ident )
@@ -709,7 +713,7 @@ int SSImportMWGC ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectV
         pObject->setVMagnitude ( vmag );
         pObject->setBMagnitude ( bmag );
         pObject->setMajorAxis ( diam );
-        pObject->setSpectralType ( specStr );
+        pObject->setSpectralType ( specStr.toString() );
         
         // cout << pObject->toCSV() << endl;
         clusters.push_back ( shared_ptr<SSObject> ( pObject ) );
@@ -731,7 +735,7 @@ int SSImportMWGC ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectV
 
 int SSImportPNG ( const char *main_filename, const char *dist_filename, const char *diam_filename, const char *vel_filename, SSIdentifierNameMap &nameMap, SSObjectVec &nebulae )
 {
-    string line = "";
+    SSStringView record;
     map<SSIdentifier,float> distMap;
     map<SSIdentifier,float> diamMap;
     map<SSIdentifier,float> velMap;
@@ -739,30 +743,30 @@ int SSImportPNG ( const char *main_filename, const char *dist_filename, const ch
     // First open distance distance file.
     // If successful create mapping of PNG identifiers to distances.
     
-    ifstream file ( dist_filename );
-    if ( file )
+    SSLineReader file ( dist_filename );
+    if ( file.isOpen() )
     {
         int n = 0;
         SSIdentifier lastIdent ( kCatUnknown, 0 );
         
         // Read file line-by-line until we reach end-of-file
         
-        while ( getline ( file, line ) )
+        while ( file.readLine ( record ) )
         {
-            if ( line.length() < 28 )
+            if ( record.length() < 28 )
                 continue;
 
             // Get PNG identifier
             
-            string strPNG = trim ( line.substr ( 0, 10 ) );
-            SSIdentifier ident = SSIdentifier::fromString ( "PNG " + strPNG );
+            SSStringView strPNG = record.column ( 0, 10 );
+            SSIdentifier ident = SSIdentifier::fromString ( "PNG " + strPNG.toString() );
             if ( ! ident )
                 continue;
             
             // Get distance in kiloparsecs and convert to light years
             
-            string distStr = trim ( line.substr ( 22, 6 ) );
-            float dist = distStr.empty() ? HUGE_VAL : strtofloat ( distStr ) * 1000.0 * SSDynamics::kLYPerParsec;
+            SSStringView distStr = record.column ( 22, 6 );
+            float dist = distStr.empty() ? HUGE_VAL : distStr.toFloat() * 1000.0 * SSDynamics::kLYPerParsec;
             if ( isinf ( dist ) )
                 continue;
             
@@ -784,73 +788,67 @@ int SSImportPNG ( const char *main_filename, const char *dist_filename, const ch
         }
     }
 
-    // Close previous file; open diameter file.
+    // Open diameter file.
     // If successful create mapping of PNG identifiers to angular diameters.
 
-    file.close();
-    file.open ( diam_filename );
-    if ( file )
+    if ( file.open ( diam_filename ) )
     {
         // Read file line-by-line until we reach end-of-file
         
-        while ( getline ( file, line ) )
+        while ( file.readLine ( record ) )
         {
-            if ( line.length() < 18 )
+            if ( record.length() < 18 )
                 continue;
-            
+
             // Get PNG identifier
             
-            string strPNG = trim ( line.substr ( 0, 10 ) );
-            SSIdentifier ident = SSIdentifier::fromString ( "PNG " + strPNG );
+            SSStringView strPNG = record.column ( 0, 10 );
+            SSIdentifier ident = SSIdentifier::fromString ( "PNG " + strPNG.toString() );
             if ( ! ident )
                 continue;
             
             // Get angular diameter in arcsec and convert to radians
             // If nonzero, store diameter in mapping of PNG identifiers
 
-            string diamStr = trim ( line.substr ( 12, 6 ) );
-            float diam = strtofloat ( diamStr ) * SSAngle::kRadPerArcsec;
+            SSStringView diamStr = record.column ( 12, 6 );
+            float diam = diamStr.toFloat() * SSAngle::kRadPerArcsec;
             if ( diam != 0.0 )
                 diamMap[ident] = diam;
         }
     }
 
-    // Close previous file; open velocity file.
+    // Open velocity file.
     // If successful create mapping of PNG identifiers to radial velocities.
 
-    file.close();
-    file.open ( vel_filename );
-    if ( file )
+    if ( file.open ( vel_filename ) )
     {
         // Read file line-by-line until we reach end-of-file
         
-        while ( getline ( file, line ) )
+        while ( file.readLine ( record ) )
         {
-            if ( line.length() < 18 )
+            if ( record.length() < 18 )
                 continue;
 
             // Get PNG identifier
             
-            string strPNG = trim ( line.substr ( 1, 10 ) );
-            SSIdentifier ident = SSIdentifier::fromString ( "PNG " + strPNG );
+            SSStringView strPNG = record.column ( 1, 10 );
+            SSIdentifier ident = SSIdentifier::fromString ( "PNG " + strPNG.toString() );
             if ( ! ident )
                 continue;
             
             // Get radial velocity in km/sec and convert to fraction of light speed
             // If valid, store radial velocity in mapping of PNG identifiers
 
-            string velStr = trim ( line.substr ( 12, 6 ) );
-            float radVel = strtofloat ( velStr ) / SSDynamics::kLightKmPerSec;
+            SSStringView velStr = record.column ( 12, 6 );
+            float radVel = velStr.toFloat() / SSDynamics::kLightKmPerSec;
             if ( radVel != 0.0 )
                 velMap[ident] = radVel;
         }
     }
 
-    // Close previous file; open main file and return on failure.
+    // Open main file and return on failure.
 
-    file.close();
-    file.open ( main_filename );
-    if ( ! file )
+    if ( ! file.open ( main_filename ) )
         return 0;
     
     // Set up matrix for precessing B1950 coordinates and proper motion to J2000.
@@ -859,18 +857,18 @@ int SSImportPNG ( const char *main_filename, const char *dist_filename, const ch
     SSMatrix precession = SSCoords::getPrecessionMatrix ( SSTime::kB1950 ).transpose();
     int numNebulae = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        if ( line.length() < 58 )
+        if ( record.length() < 58 )
             continue;
 
         // Get B1950 R.A. and Dec; convert to radians.
         
-        string strRA = line.substr ( 12, 11 );
-        string strDec = line.substr ( 23, 11 );
+        SSStringView strRA = record.substr ( 12, 11 );
+        SSStringView strDec = record.substr ( 23, 11 );
         
-        SSHourMinSec ra ( strRA );
-        SSDegMinSec dec ( strDec );
+        SSHourMinSec ra ( strRA.toSexagesimal() );
+        SSDegMinSec dec ( strDec.toSexagesimal() );
         
         // Precess B1950 coords and motion to J2000!
 
@@ -884,13 +882,13 @@ int SSImportPNG ( const char *main_filename, const char *dist_filename, const ch
         vector<string> names;
         vector<SSIdentifier> idents;
         
-        string strPNG = trim ( line.substr ( 0, 10 ) );
+        SSStringView strPNG = record.column ( 0, 10 );
         if ( ! strPNG.empty() )
-            idents.push_back ( SSIdentifier::fromString ( "PNG " + strPNG ) );
+            idents.push_back ( SSIdentifier::fromString ( "PNG " + strPNG.toString() ) );
     
-        string strPK = trim ( line.substr ( 59, 9 ) );
+        SSStringView strPK = record.column ( 59, 9 );
         if ( ! strPK.empty() )
-            idents.push_back ( SSIdentifier::fromString ( "PK " + strPK ) );
+            idents.push_back ( SSIdentifier::fromString ( "PK " + strPK.toString() ) );
 
         // Use distance from PNG-identifier-to-distance mapping created above, if nonzero.
         
@@ -913,7 +911,7 @@ int SSImportPNG ( const char *main_filename, const char *dist_filename, const ch
         // Get name. If it's an NGC-IC, parse identifier from it, add Messier and Caldwell numbers;
         // get names from identifiers, sort identifier list. Otherwise, use name verbatim.
 
-        string name = trim ( line.substr ( 45, 13 ) );
+        string name = record.column ( 45, 13 ).toString();
         
         if ( name.find ( "NGC" ) == 0 || name.find ( "IC" ) == 0 )
         {
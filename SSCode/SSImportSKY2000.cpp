@@ -5,15 +5,17 @@
 //  Copyright © 2020 Southern Stars. All rights reserved.
 
 #include "SSDynamics.hpp"
+#include "SSIdentifierIndex.hpp"
 #include "SSImportSKY2000.hpp"
+#include "SSLineReader.hpp"
+#include "SSStringView.hpp"
 
 #include <algorithm>
 #include <iostream>
-#include <fstream>
 
 // Adds identifiers from other star catalog (stars) to a SKY2000 star (pStars).
 
-void addSKY2000StarData ( SSObjectVec &stars, SSObjectMap &map, SSStarPtr pSkyStar )
+void addSKY2000StarData ( SSObjectVec &stars, const SSIdentifierIndex &map, SSStarPtr pSkyStar )
 {
     // Find pointer to corresponding star in other star vector,
     // using SKY2000 star's HD identifier.
@@ -53,32 +55,32 @@ int SSImportIAUStarNames ( const char *filename, SSIdentifierNameMap &nameMap )
 {
     // Open file; return on failure.
 
-    ifstream file ( filename );
-    if ( ! file )
+    SSLineReader file ( filename );
+    if ( ! file.isOpen() )
         return 0;
 
     // Read file line-by-line until we reach end-of-file
 
-    string line = "";
+    SSStringView record;
     int count = 0;
 
-    while ( getline ( file, line ) )
+    while ( file.readLine ( record ) )
     {
-        if ( line.length() < 96 )
+        if ( record.length() < 96 )
             continue;
-        
+
         // Extract main identifier, Hipparcos number, and name
         
-        string strIdent = trim ( line.substr ( 36, 13 ) );
-        string strHIP = trim ( line.substr ( 91, 6 ) );
-        string strName = trim ( line.substr ( 0, 18 ) );
+        SSStringView strIdent = record.column ( 36, 13 );
+        SSStringView strHIP = record.column ( 91, 6 );
+        SSStringView strName = record.column ( 0, 18 );
         
         // Construct identifier from main ident string, or HIP number if that fails.
         
         SSIdentifier ident = SSIdentifier::fromString ( strIdent );
         if ( ! ident )
         {
-            int hip = strtoint ( strHIP );
+            int hip = strHIP.toInt();
             if ( hip )
                 ident = SSIdentifier ( kCatHIP, hip );
         }
@@ -87,11 +89,11 @@ int SSImportIAUStarNames ( const char *filename, SSIdentifierNameMap &nameMap )
         
         if ( ! ident )
         {
-            cout << "Warning: can't convert " << strIdent << " for " << strName << endl;
+            cout << "Warning: can't convert " << strIdent.toString() << " for " << strName.toString() << endl;
             continue;
         }
         
-        nameMap.insert ( { ident, strName } );
+        nameMap.insert ( { ident, strName.toString() } );
         count++;
     }
 
@@ -177,291 +179,308 @@ string SKY2000VariableTypeString ( int type )
     return vartypes[ type ];
 };
 
-// Imports SKY2000 Master Star Catalog v5:
-// https://cdsarc.unistra.fr/ftp/V/145
-// Adds name strings from nameNap.
-// Adds additional HIP, Bayer, and GJ identifiers from vectors of
-// Hipparcos stars (hipStars) and Gliese-Jahreiss nearby stars (gjStars).
-// Nothing will be added if these star vectors are empty.
-// Returns number of SKY2000 stars imported (299460 if successful).
-
-// TODO: add HIP numbers and add'l Bayer letters from Hipparcos. Add nearby stars from RECONS.
+// Converts one line of the SKY2000 Master Star Catalog into a star, with names from nameMap,
+// and additional HIP, Bayer, and GJ identifiers from hipStars and gjStars (found via hipMap and gjMap).
+// Appends the star to the star vector and returns 1, or returns 0 on failure.
 
-int SSImportSKY2000 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars, SSObjectVec &stars )
+static int parseSKY2000Record ( SSStringView record, SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, const SSIdentifierIndex &hipMap, SSObjectVec &gjStars, const SSIdentifierIndex &gjMap, SSObjectVec &stars )
 {
-    // Open file; return on failure.
-
-    ifstream file ( filename );
-    if ( ! file )
+    if ( record.length() < 521 )
         return 0;
 
-    // Make index of HD catalog numbers in the Hipparcos and GJ star vectors.
+    SSStringView strHD = record.column ( 35, 6 );
+    SSStringView strSAO = record.column ( 43, 6 );
+    string strDM = record.column ( 50, 5 ).toString() + " " + record.column ( 55, 5 ).toString();
+    SSStringView strHR = record.column ( 63, 4 );
+    SSStringView strWDS = record.column ( 67, 12 );
     
-    SSObjectMap hipMap = SSMakeObjectMap ( hipStars, kCatHD );
-    SSObjectMap gjMap = SSMakeObjectMap ( gjStars, kCatHD );
-
-    // Read file line-by-line until we reach end-of-file
-
-    string line = "";
-    int numStars = 0;
-
-    while ( getline ( file, line ) )
-    {
-        if ( line.length() < 521 )
-            continue;
-        
-        string strHD = trim ( line.substr ( 35, 6 ) );
-        string strSAO = trim ( line.substr ( 43, 6 ) );
-        string strDM = trim ( line.substr ( 50, 5 ) ) + " " + trim ( line.substr ( 55, 5 ) );
-        string strHR = trim ( line.substr ( 63, 4 ) );
-        string strWDS = trim ( line.substr ( 67, 12 ) );
-        
-        // Extract Bayer/Flamsteed names like "21alp And", "1pi 3Ori", and "kap1Scl"; ignore AG catalog numbers.
-        
-        string strBay = "";
-        string strNum = "";
-        string strFlm = "";
-        string strName = line.substr ( 98, 10 );
+    // Extract Bayer/Flamsteed names like "21alp And", "1pi 3Ori", and "kap1Scl"; ignore AG catalog numbers.
+    
+    string strBay = "";
+    string strNum = "";
+    string strFlm = "";
+    SSStringView strName = record.substr ( 98, 10 );
  
-        if ( strName.find ( "AG" ) != 0 )
+    if ( strName.find ( "AG" ) != 0 )
+    {
+        SSStringView strCon = record.column ( 105, 3 );
+        if ( ! strCon.empty() )
         {
-            string strCon = trim ( line.substr ( 105, 3 ) );
-            if ( ! strCon.empty() )
-            {
-                strFlm = trim ( line.substr ( 98, 3 ) );
-                strBay = trim ( line.substr ( 101, 3 ) );
-                strNum = trim ( line.substr ( 104, 1 ) );
-                
-                if ( ! strFlm.empty() )
-                    strFlm = strFlm + " " + strCon;
-                
-                if ( ! strBay.empty() )
-                    strBay = strBay + strNum + " " + strCon;
-            }
+            strFlm = record.column ( 98, 3 ).toString();
+            strBay = record.column ( 101, 3 ).toString();
+            strNum = record.column ( 104, 1 ).toString();
+            
+            if ( ! strFlm.empty() )
+                strFlm = strFlm + " " + strCon.toString();
+            
+            if ( ! strBay.empty() )
+                strBay = strBay + strNum + " " + strCon.toString();
         }
-        
-        string strVar = trim ( line.substr ( 108, 10 ) );
+    }
+    
+    SSStringView strVar = record.column ( 108, 10 );
 
-        // Extract RA and Dec, adding whitespace to separate hour/deg, min, sec
-        
-        string strRA = trim ( line.substr ( 118, 2 ) ) + " "
-                     + trim ( line.substr ( 120, 2 ) ) + " "
-                     + trim ( line.substr ( 122, 7 ) );
-        
-        string strDec = trim ( line.substr ( 129, 1 ) )
-                      + trim ( line.substr ( 130, 2 ) ) + " "
-                      + trim ( line.substr ( 132, 2 ) ) + " "
-                      + trim ( line.substr ( 134, 6 ) );
+    // Extract RA and Dec, adding whitespace to separate hour/deg, min, sec
+    
+    string strRA = record.column ( 118, 2 ).toString() + " "
+                 + record.column ( 120, 2 ).toString() + " "
+                 + record.column ( 122, 7 ).toString();
+    
+    string strDec = record.column ( 129, 1 ).toString()
+                  + record.column ( 130, 2 ).toString() + " "
+                  + record.column ( 132, 2 ).toString() + " "
+                  + record.column ( 134, 6 ).toString();
 
-        // Extract proper motion, removing whitepace after sign of PM in Dec.
-        
-        string strPMRA = trim ( line.substr ( 149, 8 ) );
-        string strPMDec = trim ( line.substr ( 157, 1 ) )
-                        + trim ( line.substr ( 158, 7 ) );
-        
-        // Extract radial velocity, removing whitespace after sign
-        
-        string strRV = trim ( line.substr ( 167, 1 ) )
-                     + trim ( line.substr ( 168, 5 ) );
-        
-        // Extract parallax and standard error of parallax.
-        
-        string strPlx = trim ( line.substr ( 175, 8 ) );
-        string strPlxErr = trim ( line.substr ( 183, 8 ) );
-        
-        // Extract Johnson V magnitude and B-V color index.
-        // Get observed V if present; otherwise get derived V.
-        
-        string strMag = trim ( line.substr ( 232, 6 ) );
-        if ( strMag.empty() )
-            strMag = trim ( line.substr ( 238, 5 ) );
-        
-        string strBmV = trim ( line.substr ( 258, 6 ) );
+    // Extract proper motion, removing whitepace after sign of PM in Dec.
+    
+    SSStringView strPMRA = record.column ( 149, 8 );
+    string strPMDec = record.column ( 157, 1 ).toString()
+                    + record.column ( 158, 7 ).toString();
+    
+    // Extract radial velocity, removing whitespace after sign
+    
+    string strRV = record.column ( 167, 1 ).toString()
+                 + record.column ( 168, 5 ).toString();
+    
+    // Extract parallax.
+    
+    SSStringView strPlx = record.column ( 175, 8 );
+    
+    // Extract Johnson V magnitude and B-V color index.
+    // Get observed V if present; otherwise get derived V.
+    
+    SSStringView strMag = record.column ( 232, 6 );
+    if ( strMag.empty() )
+        strMag = record.column ( 238, 5 );
+    
+    SSStringView strBmV = record.column ( 258, 6 );
 
-        // Extract spectral type. Prefer full two-dimensional MK spectral type;
-        // use one-dimensional HD spectral type if MK is missing. ***/
-        
-        string strSpec = trim ( line.substr ( 304, 30 ) );
-        if ( strSpec.empty() )
-            strSpec = trim ( line.substr ( 336, 3 ) );
-        
-        // Extract separation and magnitude difference between components,
-        // position angle, year of measurement, and component identifiers.
+    // Extract spectral type. Prefer full two-dimensional MK spectral type;
+    // use one-dimensional HD spectral type if MK is missing. ***/
+    
+    SSStringView strSpec = record.column ( 304, 30 );
+    if ( strSpec.empty() )
+        strSpec = record.column ( 336, 3 );
+    
+    // Extract separation and magnitude difference between components,
+    // position angle, year of measurement, and component identifiers.
 
-        string strDblSep = trim ( line.substr ( 341, 7 ) );
-        string strDblMag = trim ( line.substr ( 348, 5 ) );
-        string strDblPA = trim ( line.substr ( 360, 3 ) );
-        string strDblPAyr = trim ( line.substr ( 363, 7 ) );
-        string strDblComp = trim ( line.substr ( 77, 5 ) );
+    SSStringView strDblSep = record.column ( 341, 7 );
+    SSStringView strDblMag = record.column ( 348, 5 );
+    SSStringView strDblPA = record.column ( 360, 3 );
+    SSStringView strDblPAyr = record.column ( 363, 7 );
+    SSStringView strDblComp = record.column ( 77, 5 );
 
-        // Extract variability data: magnitude at maximum and minimum light,
-        // period, epoch; convert numeric variability type code to GCVS type string.
-        
-        string strVarMax = trim ( line.substr ( 411, 5 ) );
-        string strVarMin = trim ( line.substr ( 416, 5 ) );
-        string strVarPer = trim ( line.substr ( 427, 8 ) );
-        string strVarEpoch = trim ( line.substr ( 435, 8 ) );
-        string strVarType = trim ( line.substr ( 443, 3 ) );
-        strVarType = SKY2000VariableTypeString ( strtoint ( strVarType ) );
-        
-        // Get J2000 Right Ascension and Declination
-        
-        SSHourMinSec ra ( strRA );
-        SSDegMinSec dec ( strDec );
-        
-        // Get J2000 proper in seconds of time per year (RA) and arcsec per year (Dec).
-        
-        double pmRA = HUGE_VAL;
-        if ( ! strPMRA.empty() )
-            pmRA = SSAngle::fromArcsec ( strtofloat ( strPMRA ) * 15.0 );
-        
-        double pmDec = HUGE_VAL;
-        if ( ! strPMDec.empty() )
-            pmDec = SSAngle::fromArcsec ( strtofloat ( strPMDec ) );
-        
-        SSSpherical position ( ra, dec, HUGE_VAL );
-        SSSpherical velocity ( pmRA, pmDec, HUGE_VAL );
-        
-        // Get parallax in arcsec and if > 1 mas convert to distance in light years.
-        
-        double plx = strtofloat ( strPlx );
-        if ( plx > 0.001 )
-            position.rad = SSDynamics::kLYPerParsec / plx;
-        
-        // Get radial velocity in km/sec and convert to fraction of light speed (light years per year).
-        
-        if ( ! strRV.empty() )
-            velocity.rad = strtofloat ( strRV ) / SSDynamics::kLightKmPerSec;
-        
-        // Get Johnson V magnitude
-        
-        float vmag = HUGE_VAL;
-        if ( ! strMag.empty() )
-            vmag = strtofloat ( strMag );
-        
-        // Get Johnson B magnitude from B-V color index
-        
-        float bmag = HUGE_VAL;
-        if ( ! strBmV.empty() )
-            bmag = strtofloat ( strBmV ) + vmag;
-        
-        // Set up name and identifier vectors.
+    // Extract variability data: magnitude at maximum and minimum light,
+    // period, epoch; convert numeric variability type code to GCVS type string.
+    
+    SSStringView strVarMax = record.column ( 411, 5 );
+    SSStringView strVarMin = record.column ( 416, 5 );
+    SSStringView strVarPer = record.column ( 427, 8 );
+    SSStringView strVarEpoch = record.column ( 435, 8 );
+    string strVarType = SKY2000VariableTypeString ( record.column ( 443, 3 ).toInt() );
+    
+    // Get J2000 Right Ascension and Declination
+    
+    SSHourMinSec ra ( strRA );
+    SSDegMinSec dec ( strDec );
+    
+    // Get J2000 proper in seconds of time per year (RA) and arcsec per year (Dec).
+    
+    double pmRA = HUGE_VAL;
+    if ( ! strPMRA.empty() )
+        pmRA = SSAngle::fromArcsec ( strPMRA.toFloat() * 15.0 );
+    
+    double pmDec = HUGE_VAL;
+    if ( ! strPMDec.empty() )
+        pmDec = SSAngle::fromArcsec ( strtofloat ( strPMDec ) );
+    
+    SSSpherical position ( ra, dec, HUGE_VAL );
+    SSSpherical velocity ( pmRA, pmDec, HUGE_VAL );
+    
+    // Get parallax in arcsec and if > 1 mas convert to distance in light years.
+    
+    double plx = strPlx.toFloat();
+    if ( plx > 0.001 )
+        position.rad = SSDynamics::kLYPerParsec / plx;
+    
+    // Get radial velocity in km/sec and convert to fraction of light speed (light years per year).
+    
+    if ( ! strRV.empty() )
+        velocity.rad = strtofloat ( strRV ) / SSDynamics::kLightKmPerSec;
+    
+    // Get Johnson V magnitude
+    
+    float vmag = HUGE_VAL;
+    if ( ! strMag.empty() )
+        vmag = strMag.toFloat();
+    
+    // Get Johnson B magnitude from B-V color index
+    
+    float bmag = HUGE_VAL;
+    if ( ! strBmV.empty() )
+        bmag = strBmV.toFloat() + vmag;
+    
+    // Set up name and identifier vectors.
 
-        vector<SSIdentifier> idents ( 0 );
-        vector<string> names ( 0 );
-        
-        if ( ! strBay.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( strBay ), idents );
-        
-        if ( ! strFlm.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( strFlm ), idents );
-        
-        if ( ! strVar.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( strVar ), idents );
+    vector<SSIdentifier> idents ( 0 );
+    vector<string> names ( 0 );
+    
+    if ( ! strBay.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( strBay ), idents );
+    
+    if ( ! strFlm.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( strFlm ), idents );
+    
+    if ( ! strVar.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( strVar ), idents );
 
-        if ( ! strHR.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatHR, strtoint ( strHR ) ), idents );
+    if ( ! strHR.empty() )
+        SSAddIdentifier ( SSIdentifier ( kCatHR, strHR.toInt() ), idents );
 
-        if ( ! strHD.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatHD, strtoint ( strHD ) ), idents );
-        
-        if ( ! strSAO.empty() )
-            SSAddIdentifier ( SSIdentifier ( kCatSAO, strtoint ( strSAO ) ), idents );
+    if ( ! strHD.empty() )
+        SSAddIdentifier ( SSIdentifier ( kCatHD, strHD.toInt() ), idents );
+    
+    if ( ! strSAO.empty() )
+        SSAddIdentifier ( SSIdentifier ( kCatSAO, strSAO.toInt() ), idents );
 
-        if ( ! strDM.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( strDM ), idents );
+    if ( ! strDM.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( strDM ), idents );
+    
+    if ( ! strWDS.empty() )
+        SSAddIdentifier ( SSIdentifier::fromString ( "WDS " + strWDS.toString() ), idents );
+    
+    // Get name string(s) corresponding to identifier(s).
+    // Construct star and insert into star vector.
+    
+    names = SSIdentifiersToNames ( idents, nameMap );
+    
+    bool isVar = ! ( strVarType.empty() && strVarMax.empty() && strVarMax.empty() && strVarPer.empty() );
+    bool isDbl = ! ( strWDS.empty() && strDblMag.empty() && strDblSep.empty() );
+
+    SSObjectType type = kTypeNonexistent;
+
+    if ( isDbl && isVar )
+        type = kTypeDoubleVariableStar;
+    else if ( isDbl )
+        type = kTypeDoubleStar;
+    else if ( isVar )
+        type = kTypeVariableStar;
+    else
+        type = kTypeStar;
+
+    SSObjectPtr pObj = SSNewObject ( type );
+    SSStarPtr pStar = SSGetStarPtr ( pObj );
+    if ( pStar == nullptr )
+        return 0;
+    
+    pStar->setNames ( names );
+    pStar->setIdentifiers ( idents );
+    pStar->setFundamentalMotion ( position, velocity );
+    pStar->setVMagnitude ( vmag );
+    pStar->setBMagnitude ( bmag );
+    pStar->setSpectralType ( strSpec.toString() );
+
+    // Add additional HIP, Bayer, and GJ identifiers from other catalogs.
+    // Sert star's identifier vector.
+    
+    addSKY2000StarData ( hipStars, hipMap, pStar );
+    addSKY2000StarData ( gjStars, gjMap, pStar );
+    pStar->sortIdentifiers();
+    
+    SSVariableStarPtr pVar = SSGetVariableStarPtr ( pObj );
+    if ( pVar != nullptr )
+    {
+        // Minimum magnitude is magnitude at maximum light, and vice-vera!
         
-        if ( ! strWDS.empty() )
-            SSAddIdentifier ( SSIdentifier::fromString ( "WDS " + strWDS ), idents );
+        if ( ! strVarMin.empty() )
+            pVar->setMinimumMagnitude ( strVarMax.toFloat() );
+
+        if ( ! strVarMax.empty() )
+            pVar->setMaximumMagnitude ( strVarMin.toFloat() );
+
+        // Get variability period in days and convert epoch to Julian Date.
         
-        // Get name string(s) corresponding to identifier(s).
-        // Construct star and insert into star vector.
+        if ( ! strVarPer.empty() )
+            pVar->setPeriod ( strVarPer.toFloat() );
+
+        if ( ! strVarEpoch.empty() )
+            pVar->setEpoch ( strVarEpoch.toFloat() + 2400000.0 );
+
+        // Store variability type
         
-        names = SSIdentifiersToNames ( idents, nameMap );
+        if ( ! strVarType.empty() )
+            pVar->setVariableType ( strVarType );
+    }
+    
+    SSDoubleStarPtr pDbl = SSGetDoubleStarPtr ( pObj );
+    if ( pDbl != nullptr )
+    {
+        if ( ! strDblComp.empty() )
+            pDbl->setComponents ( strDblComp.toString() );
         
-        bool isVar = ! ( strVarType.empty() && strVarMax.empty() && strVarMax.empty() && strVarPer.empty() );
-        bool isDbl = ! ( strWDS.empty() && strDblMag.empty() && strDblSep.empty() );
-
-        SSObjectType type = kTypeNonexistent;
-
-        if ( isDbl && isVar )
-            type = kTypeDoubleVariableStar;
-        else if ( isDbl )
-            type = kTypeDoubleStar;
-        else if ( isVar )
-            type = kTypeVariableStar;
-        else
-            type = kTypeStar;
-
-        SSObjectPtr pObj = SSNewObject ( type );
-        SSStarPtr pStar = SSGetStarPtr ( pObj );
-        if ( pStar == nullptr )
-            continue;
+        if ( ! strDblMag.empty() )
+            pDbl->setMagnitudeDelta ( strDblMag.toFloat() );
         
-        pStar->setNames ( names );
-        pStar->setIdentifiers ( idents );
-        pStar->setFundamentalMotion ( position, velocity );
-        pStar->setVMagnitude ( vmag );
-        pStar->setBMagnitude ( bmag );
-        pStar->setSpectralType ( strSpec );
-
-        // Add additional HIP, Bayer, and GJ identifiers from other catalogs.
-        // Sert star's identifier vector.
+        if ( ! strDblSep.empty() )
+            pDbl->setSeparation ( SSAngle::fromArcsec ( strDblSep.toFloat() ) );
         
-        addSKY2000StarData ( hipStars, hipMap, pStar );
-        addSKY2000StarData ( gjStars, gjMap, pStar );
-        pStar->sortIdentifiers();
+        if ( ! strDblPA.empty() )
+            pDbl->setPositionAngle( SSAngle::fromDegrees ( strDblPA.toFloat() ) );
         
-        SSVariableStarPtr pVar = SSGetVariableStarPtr ( pObj );
-        if ( pVar != nullptr )
-        {
-            // Minimum magnitude is magnitude at maximum light, and vice-vera!
-            
-            if ( ! strVarMin.empty() )
-                pVar->setMinimumMagnitude ( strtofloat ( strVarMax ) );
+        if ( ! strDblPAyr.empty() )
+            pDbl->setPositionAngleYear ( strDblPAyr.toFloat() );
+    }
+    
+    // cout << pStar->toCSV() << endl;
+    stars.push_back ( pObj );
+    return 1;
+}
 
-            if ( ! strVarMax.empty() )
-                pVar->setMaximumMagnitude ( strtofloat ( strVarMin ) );
+// Returns a record parser which converts one line of the SKY2000 Master Star Catalog into a star,
+// cross-identified as described for SSImportSKY2000(). The name map and the Hipparcos and GJ
+// star vectors are used by reference and must outlive the parser.
 
-            // Get variability period in days and convert epoch to Julian Date.
-            
-            if ( ! strVarPer.empty() )
-                pVar->setPeriod ( strtofloat ( strVarPer ) );
+SSRecordParser SSSKY2000RecordParser ( SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars )
+{
+    // Make index of HD catalog numbers in the Hipparcos and GJ star vectors.
 
-            if ( ! strVarEpoch.empty() )
-                pVar->setEpoch ( strtofloat ( strVarEpoch ) + 2400000.0 );
+    shared_ptr<SSIdentifierIndex> pHIPIndex ( new SSIdentifierIndex ( hipStars, kCatHD ) );
+    shared_ptr<SSIdentifierIndex> pGJIndex ( new SSIdentifierIndex ( gjStars, kCatHD ) );
 
-            // Store variability type
-            
-            if ( ! strVarType.empty() )
-                pVar->setVariableType ( strVarType );
-        }
-        
-        SSDoubleStarPtr pDbl = SSGetDoubleStarPtr ( pObj );
-        if ( pDbl != nullptr )
-        {
-            if ( ! strDblComp.empty() )
-                pDbl->setComponents ( strDblComp );
-            
-            if ( ! strDblMag.empty() )
-                pDbl->setMagnitudeDelta ( strtofloat ( strDblMag ) );
-            
-            if ( ! strDblSep.empty() )
-                pDbl->setSeparation ( SSAngle::fromArcsec ( strtofloat ( strDblSep ) ) );
-            
-            if ( ! strDblPA.empty() )
-                pDbl->setPositionAngle( SSAngle::fromDegrees ( strtofloat ( strDblPA ) ) );
-            
-            if ( ! strDblPAyr.empty() )
-                pDbl->setPositionAngleYear ( strtofloat ( strDblPAyr ) );
-        }
-        
-        // cout << pStar->toCSV() << endl;
-        stars.push_back ( pObj );
-        numStars++;
-    }
+    return [&nameMap, &hipStars, &gjStars, pHIPIndex, pGJIndex] ( SSStringView record, SSObjectVec &stars )
+    {
+        return parseSKY2000Record ( record, nameMap, hipStars, *pHIPIndex, gjStars, *pGJIndex, stars );
+    };
+}
 
-    // Return imported star count; file is closed automatically.
-    
-    return numStars;
+// Streams the SKY2000 Master Star Catalog into an object sink, one star at a time.
+// Arguments and cross-identification are the same as SSImportSKY2000().
+// Returns number of stars accepted by the sink.
+
+int SSImportSKY2000 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars, SSObjectSink &sink )
+{
+    // Open file; return on failure.
+
+    SSCatalogReader reader ( filename, SSSKY2000RecordParser ( nameMap, hipStars, gjStars ) );
+    if ( ! reader.isOpen() )
+        return 0;
+
+    return reader.read ( sink );
+}
+
+// Imports SKY2000 Master Star Catalog v5:
+// https://cdsarc.unistra.fr/ftp/V/145
+// Adds name strings from nameNap.
+// Adds additional HIP, Bayer, and GJ identifiers from vectors of
+// Hipparcos stars (hipStars) and Gliese-Jahreiss nearby stars (gjStars).
+// Nothing will be added if these star vectors are empty.
+// Returns number of SKY2000 stars imported (299460 if successful).
+
+// TODO: add HIP numbers and add'l Bayer letters from Hipparcos. Add nearby stars from RECONS.
+
+int SSImportSKY2000 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars, SSObjectVec &stars )
+{
+    SSObjectVecSink sink ( stars );
+    return SSImportSKY2000 ( filename, nameMap, hipStars, gjStars, sink );
 }
@@ -14,8 +14,11 @@
 #include <string>
 
 #include "SSStar.hpp"
+#include "SSCatalogStream.hpp"
 
 int SSImportIAUStarNames ( const char *filename, SSIdentifierNameMap &nameMap );
 int SSImportSKY2000 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars, SSObjectVec &stars );
+int SSImportSKY2000 ( const char *filename, SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars, SSObjectSink &sink );
+SSRecordParser SSSKY2000RecordParser ( SSIdentifierNameMap &nameMap, SSObjectVec &hipStars, SSObjectVec &gjStars );
 
 #endif /* SSImportSKY2000_hpp */
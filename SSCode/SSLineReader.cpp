@@ -0,0 +1,81 @@
+// SSLineReader.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/29/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <cstring>
+
+#include "SSLineReader.hpp"
+
+// Constructs a line reader with no file open.
+
+SSLineReader::SSLineReader ( void )
+{
+    _pos = 0;
+}
+
+// Constructs a line reader and opens a file (filename) for reading.
+// Call isOpen() to find out whether the file was opened successfully.
+
+SSLineReader::SSLineReader ( const string &filename )
+{
+    _pos = 0;
+    open ( filename );
+}
+
+// Opens a file (filename) for reading from its first line. Any file already open is closed first.
+// Returns true if successful or false on failure.
+
+bool SSLineReader::open ( const string &filename )
+{
+    _pos = 0;
+    return _file.open ( filename );
+}
+
+// Closes the file. Any line views returned by readLine() become invalid.
+
+void SSLineReader::close ( void )
+{
+    _file.close();
+    _pos = 0;
+}
+
+// Reads the next line from the file into a view (line), without its line ending.
+// Like getline(), returns false at end-of-file, or if no file is open; a last line
+// without a line ending is still returned, but a line ending at end-of-file does not
+// start another, empty line.
+
+bool SSLineReader::readLine ( SSStringView &line )
+{
+    const char *data = _file.data();
+    size_t size = _file.size();
+
+    if ( data == nullptr || _pos >= size )
+        return false;
+
+    const char *start = data + _pos;
+    const char *eol = (const char *) memchr ( start, '\n', size - _pos );
+    size_t len = eol ? eol - start : size - _pos;
+
+    _pos += eol ? len + 1 : len;
+
+    if ( len > 0 && start[len - 1] == '\r' )
+        len--;
+
+    line = SSStringView ( start, len );
+    return true;
+}
+
+// Reads the next line from the file into a string (line), as above. The string's memory
+// is reused, so reading many lines into the same string rarely allocates.
+
+bool SSLineReader::readLine ( string &line )
+{
+    SSStringView view;
+    if ( ! readLine ( view ) )
+        return false;
+
+    line.assign ( view.data(), view.size() );
+    return true;
+}
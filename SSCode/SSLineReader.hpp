@@ -0,0 +1,39 @@
+// SSLineReader.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/29/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Reads a text file one line at a time, like getline(), but without copying: the file is
+// mapped into memory (see SSMappedFile), and each line is returned as a view of the mapped
+// contents. Lines may be any length. Unix (LF) and Windows (CRLF) line endings are both
+// recognized, and are not included in the returned line. A line view stays valid until the
+// reader is closed, reopened, or destroyed.
+
+#ifndef SSLineReader_hpp
+#define SSLineReader_hpp
+
+#include "SSMappedFile.hpp"
+#include "SSStringView.hpp"
+
+class SSLineReader
+{
+protected:
+
+    SSMappedFile _file;     // mapped file contents
+    size_t _pos;            // offset of start of next line in file contents
+
+public:
+
+    SSLineReader ( void );
+    SSLineReader ( const string &filename );
+
+    bool open ( const string &filename );
+    void close ( void );
+    bool isOpen ( void ) { return _file.isOpen(); }
+
+    bool readLine ( SSStringView &line );
+    bool readLine ( string &line );
+};
+
+#endif /* SSLineReader_hpp */
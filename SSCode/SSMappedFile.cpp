@@ -0,0 +1,180 @@
+// SSMappedFile.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/20/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SSMappedFile.hpp"
+#include "SSUtilities.hpp"
+
+// Contents of every empty file, which can't be mapped.
+
+static const char _empty[1] = { 0 };
+
+// Constructs a mapped file object with no file open.
+
+SSMappedFile::SSMappedFile ( void )
+{
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+#ifdef _WIN32
+    _hFile = INVALID_HANDLE_VALUE;
+    _hMapping = nullptr;
+#endif
+}
+
+// Destructor unmaps the file, if open.
+
+SSMappedFile::~SSMappedFile ( void )
+{
+    close();
+}
+
+// Maps the contents of a file into memory, read-only. Any file already open is closed first.
+// If the file can't be mapped, its contents are read into a heap buffer instead.
+// Returns true if the file's contents are available, or false on failure.
+
+bool SSMappedFile::open ( const string &filename )
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE hFile = CreateFileA ( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if ( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size = { 0 };
+    GetFileSizeEx ( hFile, &size );
+    _size = (size_t) size.QuadPart;
+
+    if ( _size == 0 )
+    {
+        CloseHandle ( hFile );
+        _data = _empty;
+        return true;
+    }
+
+    HANDLE hMapping = CreateFileMappingA ( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+    if ( hMapping != NULL )
+    {
+        _data = (const char *) MapViewOfFile ( hMapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( _data != nullptr )
+        {
+            _hFile = hFile;
+            _hMapping = hMapping;
+            _mapped = true;
+            return true;
+        }
+
+        CloseHandle ( hMapping );
+    }
+
+    CloseHandle ( hFile );
+#else
+    int fd = ::open ( filename.c_str(), O_RDONLY );
+    if ( fd >= 0 )
+    {
+        struct stat st;
+        if ( fstat ( fd, &st ) != 0 )
+        {
+            ::close ( fd );
+            return false;
+        }
+
+        _size = (size_t) st.st_size;
+        if ( _size == 0 )
+        {
+            ::close ( fd );
+            _data = _empty;
+            return true;
+        }
+
+        void *addr = mmap ( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close ( fd );
+
+        if ( addr != MAP_FAILED )
+        {
+            _data = (const char *) addr;
+            _mapped = true;
+            return true;
+        }
+    }
+#endif
+
+    // Mapping failed, or (on Android) the file is an asset inside the app package, which
+    // can only be opened with fopen(); fall back to reading the whole file into memory.
+
+    FILE *file = fopen ( filename.c_str(), "rb" );
+    if ( file == nullptr )
+        return false;
+
+    long end = -1;
+    if ( fseek ( file, 0, SEEK_END ) == 0 )
+        end = ftell ( file );
+
+    if ( end < 0 || fseek ( file, 0, SEEK_SET ) != 0 )
+    {
+        fclose ( file );
+        _size = 0;
+        return false;
+    }
+
+    _size = (size_t) end;
+    char *buffer = (char *) malloc ( _size + 1 );
+    if ( buffer != nullptr && fread ( buffer, 1, _size, file ) == _size )
+    {
+        buffer[_size] = 0;
+        _data = buffer;
+    }
+    else
+    {
+        free ( buffer );
+        _size = 0;
+    }
+
+    fclose ( file );
+    return _data != nullptr;
+}
+
+// Unmaps the file, or releases the buffer containing its contents.
+// Any pointers into the file's contents become invalid.
+
+void SSMappedFile::close ( void )
+{
+    if ( _data != nullptr && _data != _empty )
+    {
+        if ( _mapped )
+        {
+#ifdef _WIN32
+            UnmapViewOfFile ( _data );
+            CloseHandle ( (HANDLE) _hMapping );
+            CloseHandle ( (HANDLE) _hFile );
+            _hFile = INVALID_HANDLE_VALUE;
+            _hMapping = nullptr;
+#else
+            munmap ( (void *) _data, _size );
+#endif
+        }
+        else
+        {
+            free ( (void *) _data );
+        }
+    }
+
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+}
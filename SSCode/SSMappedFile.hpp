@@ -0,0 +1,49 @@
+// SSMappedFile.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/20/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Maps the contents of a file into memory, read-only, so it can be used without
+// copying or parsing. Uses mmap() on MacOS, iOS, Linux, and Android, and file mapping
+// objects on Windows. If the operating system can't map the file, it is read into
+// an ordinary memory buffer instead, so callers never need a second code path.
+
+#ifndef SSMappedFile_hpp
+#define SSMappedFile_hpp
+
+#include <string>
+
+using namespace std;
+
+class SSMappedFile
+{
+protected:
+
+    const char *_data;      // pointer to first byte of file contents; null if not open
+    size_t _size;           // size of file contents in bytes
+    bool _mapped;           // true if _data is a memory mapping; false if it was read into a heap buffer
+
+#ifdef _WIN32
+    void *_hFile;           // Windows file handle
+    void *_hMapping;        // Windows file mapping object handle
+#endif
+
+public:
+
+    SSMappedFile ( void );
+    ~SSMappedFile ( void );
+
+    SSMappedFile ( const SSMappedFile & ) = delete;              // not copyable, since the mapping is owned
+    SSMappedFile &operator = ( const SSMappedFile & ) = delete;
+
+    bool open ( const string &filename );
+    void close ( void );
+
+    bool isOpen ( void ) { return _data != nullptr; }
+    bool isMapped ( void ) { return _mapped; }
+    const char *data ( void ) { return _data; }
+    size_t size ( void ) { return _size; }
+};
+
+#endif /* SSMappedFile_hpp */
@@ -0,0 +1,208 @@
+// SSNameIndex.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 5/2/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+
+#include "SSNameIndex.hpp"
+
+// Appends a string (text) to a key, lowercased, with whitespace removed.
+
+static void appendKey ( SSStringView text, string &key )
+{
+    for ( char c : text )
+    {
+        if ( c == ' ' || ( c >= '\t' && c <= '\r' ) )
+            continue;
+
+        key.push_back ( c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c );
+    }
+}
+
+// Compares two keys (key1, key2) character by character, like strcmp(), but without
+// requiring them to be null-terminated. Returns a negative number if key1 sorts first,
+// a positive number if key2 sorts first, or zero if they are the same.
+
+static int compareKeys ( SSStringView key1, SSStringView key2 )
+{
+    size_t len = key1.length() < key2.length() ? key1.length() : key2.length();
+    int cmp = memcmp ( key1.data(), key2.data(), len );
+    if ( cmp != 0 )
+        return cmp;
+
+    return key1.length() < key2.length() ? -1 : key1.length() > key2.length() ? 1 : 0;
+}
+
+// Builds an index of the names and identifiers of all objects in a vector (objects).
+// If provided, pNameMap is an identifier-to-name map, like those read by SSImportIdentifierNameMap();
+// names it gives for any of an object's identifiers are indexed as that object's too.
+// JPL planet and moon numbers are not indexed, since they are not written with the object's name.
+// If several objects share a string, searches return all of them, in order of their indices.
+
+SSNameIndex::SSNameIndex ( SSObjectVec &objects, SSIdentifierNameMap *pNameMap )
+{
+    SSIdentifierVec idents;
+    string identStr;
+
+    for ( int i = 0; i < objects.size(); i++ )
+    {
+        SSObject *pObject = objects[i].get();
+        if ( pObject == nullptr )
+            continue;
+
+        for ( const SSInternedString &name : pObject->getNames() )
+            add ( name, i );
+
+        idents.clear();
+        for ( int k = 0; k < pObject->getIdentifierCount(); k++ )
+        {
+            SSIdentifier ident = pObject->getIdentifierAtIndex ( k );
+            if ( ident && ident.catalog() != kCatJPLanet )
+            {
+                identStr.clear();
+                ident.appendString ( identStr );
+                add ( identStr, i );
+                idents.push_back ( ident );
+            }
+        }
+
+        if ( pNameMap != nullptr && idents.size() > 0 )
+            for ( const string &name : SSIdentifiersToNames ( idents, *pNameMap ) )
+                add ( name, i );
+    }
+
+    // Sort entries by key, then by object index. The sort is stable, so if an object has
+    // the same key more than once ("M 31" and "M31"), the first string added is kept.
+
+    stable_sort ( _entries.begin(), _entries.end(), [this] ( const Entry &entry1, const Entry &entry2 )
+    {
+        int cmp = compareKeys ( getKey ( entry1 ), getKey ( entry2 ) );
+        return cmp < 0 || ( cmp == 0 && entry1.index < entry2.index );
+    } );
+
+    auto last = unique ( _entries.begin(), _entries.end(), [this] ( const Entry &entry1, const Entry &entry2 )
+    {
+        return entry1.index == entry2.index && getKey ( entry1 ) == getKey ( entry2 );
+    } );
+
+    _entries.erase ( last, _entries.end() );
+    _entries.shrink_to_fit();
+    _chars.shrink_to_fit();
+}
+
+// Adds a string (text) for the object at an index in the object vector (index) to the end of the
+// entry array, unsorted. Strings which are empty, all whitespace, or too long for an entry are skipped.
+// If the string is already a valid key, the entry's key and original string share the same characters.
+
+void SSNameIndex::add ( const string &text, int index )
+{
+    if ( text.empty() || text.length() > UINT16_MAX )
+        return;
+
+    Entry entry;
+    entry.index = index;
+    entry.text = (uint32_t) _chars.size();
+    entry.textLength = (uint16_t) text.length();
+    _chars.append ( text );
+
+    entry.key = (uint32_t) _chars.size();
+    appendKey ( text, _chars );
+    entry.keyLength = (uint16_t) ( _chars.size() - entry.key );
+
+    if ( entry.keyLength == 0 )
+    {
+        _chars.resize ( entry.text );
+        return;
+    }
+
+    if ( getKey ( entry ) == SSStringView ( text ) )
+    {
+        _chars.resize ( entry.key );
+        entry.key = entry.text;
+    }
+
+    _entries.push_back ( entry );
+}
+
+// Returns the position of the first entry whose key does not sort before a key (key),
+// or the number of entries if all of them do.
+
+size_t SSNameIndex::lowerBound ( const string &key ) const
+{
+    size_t first = 0, count = _entries.size();
+
+    while ( count > 0 )
+    {
+        size_t half = count / 2;
+        if ( compareKeys ( getKey ( _entries[first + half] ), key ) < 0 )
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    return first;
+}
+
+// Returns the index in the object vector from which this index was built of the first object
+// with a name or identifier string (name), ignoring case and whitespace, or -1 if none has it.
+
+int SSNameIndex::find ( SSStringView name ) const
+{
+    string key;
+    appendKey ( name, key );
+
+    size_t k = lowerBound ( key );
+    if ( k < _entries.size() && getKey ( _entries[k] ) == SSStringView ( key ) )
+        return _entries[k].index;
+
+    return -1;
+}
+
+// Finds the names and identifier strings which begin with a prefix (prefix), ignoring case and whitespace,
+// and stores them in a vector of matches (matches), in alphabetical order of their keys. The matches vector
+// is cleared first, so a vector reused from keystroke to keystroke stops allocating once it is big enough.
+// An object may match once for each of its strings. If maxMatches is greater than zero, no more than
+// that many matches are returned. Returns the number of matches.
+
+int SSNameIndex::search ( SSStringView prefix, vector<SSNameMatch> &matches, int maxMatches ) const
+{
+    matches.clear();
+
+    string key;
+    appendKey ( prefix, key );
+
+    for ( size_t k = lowerBound ( key ); k < _entries.size(); k++ )
+    {
+        const Entry &entry = _entries[k];
+        if ( entry.keyLength < key.length() || memcmp ( _chars.data() + entry.key, key.data(), key.length() ) != 0 )
+            break;
+
+        if ( maxMatches > 0 && matches.size() >= maxMatches )
+            break;
+
+        matches.push_back ( { entry.index, SSStringView ( _chars.data() + entry.text, entry.textLength ) } );
+    }
+
+    return (int) matches.size();
+}
+
+// Returns a smart pointer to the first object in a vector (objects) with a name or identifier string (name),
+// ignoring case and whitespace, using a name index built from the vector (index); or a smart pointer to null
+// if no object has that string. Unlike SSNameToObject() without an index, the vector is never searched.
+
+SSObjectPtr SSNameToObject ( const string &name, const SSNameIndex &index, SSObjectVec &objects )
+{
+    int k = index.find ( name );
+
+    if ( k >= 0 && k < objects.size() )
+        return objects[k];
+    else
+        return SSObjectPtr ( nullptr );
+}
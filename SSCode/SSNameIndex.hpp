@@ -0,0 +1,68 @@
+// SSNameIndex.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 5/2/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// A read-optimized index of the objects in a vector by every string a user might type to find
+// them: their names, their identifiers in every catalog ("alpha CMa", "9 CMa", "HR 2491", "M 31"),
+// and common names of those identifiers from an identifier-to-name map. Strings are compared
+// without regard to case or whitespace, so "m31", "M 31", and "M31" are the same.
+// The index is a flat array of entries sorted by their lowercased, whitespace-free keys; the keys
+// and original strings are packed into one character array. A lookup binary-searches the sorted
+// entries, and every key beginning with a prefix follows the first one, so search-as-you-type
+// costs one binary search no matter how many objects are indexed. Once built, an index is never
+// modified, so any number of threads may search it at once.
+
+#ifndef SSNameIndex_hpp
+#define SSNameIndex_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SSObject.hpp"
+#include "SSStringView.hpp"
+
+// A string which matched a search, and the object it belongs to.
+
+struct SSNameMatch
+{
+    int index;              // index of object in object vector
+    SSStringView text;      // name or identifier string as originally written; valid while index exists
+};
+
+class SSNameIndex
+{
+protected:
+
+    struct Entry
+    {
+        uint32_t key;           // offset of lowercased, whitespace-free key in _chars
+        uint32_t text;          // offset of original string in _chars
+        uint16_t keyLength;     // number of characters in key
+        uint16_t textLength;    // number of characters in original string
+        int index;              // index of object in object vector
+    };
+
+    string _chars;              // keys and original strings of all entries, packed end to end
+    vector<Entry> _entries;     // entries sorted by key, then by object index, without duplicates
+
+    void add ( const string &text, int index );
+    SSStringView getKey ( const Entry &entry ) const { return SSStringView ( _chars.data() + entry.key, entry.keyLength ); }
+    size_t lowerBound ( const string &key ) const;
+
+public:
+
+    SSNameIndex ( void ) { }
+    SSNameIndex ( SSObjectVec &objects, SSIdentifierNameMap *pNameMap = nullptr );
+
+    size_t size ( void ) const { return _entries.size(); }
+
+    int find ( SSStringView name ) const;
+    int search ( SSStringView prefix, vector<SSNameMatch> &matches, int maxMatches = 0 ) const;
+};
+
+SSObjectPtr SSNameToObject ( const string &name, const SSNameIndex &index, SSObjectVec &objects );
+
+#endif /* SSNameIndex_hpp */
@@ -6,20 +6,23 @@
 //
 // Base class for all types of celestial objects (stars, planets, constellations, etc.)
 
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <thread>
 
 #include "SSObject.hpp"
 #include "SSPlanet.hpp"
 #include "SSStar.hpp"
 #include "SSConstellation.hpp"
 #include "SSDynamics.hpp"
+#include "SSArena.hpp"
+#include "SSMappedFile.hpp"
 
 typedef map<SSObjectType,string> SSTypeStringMap;
-typedef map<string,SSObjectType> SSStringTypeMap;
 
-static SSTypeStringMap _typeStrings =
+static const SSTypeStringMap _typeStrings =
 {
     { kTypeNonexistent, "NO" },
     { kTypePlanet, "PL" },
@@ -42,37 +45,49 @@ static SSTypeStringMap _typeStrings =
     { kTypeAsterism, "AM" }
 };
 
-static SSStringTypeMap _stringTypes =
+// Two-character object type codes with their types, sorted by code.
+
+static constexpr SSNameValue kTypeCodes[] =
 {
-    { "NO", kTypeNonexistent },
-    { "PL", kTypePlanet },
-    { "MN", kTypeMoon },
+    { "AM", kTypeAsterism },
     { "AS", kTypeAsteroid },
+    { "BN", kTypeBrightNebula },
     { "CM", kTypeComet },
-    { "ST", kTypeSatellite },
-    { "SC", kTypeSpacecraft },
-    { "SS", kTypeStar },
+    { "CN", kTypeConstellation },
+    { "DN", kTypeDarkNebula },
     { "DS", kTypeDoubleStar },
-    { "VS", kTypeVariableStar },
     { "DV", kTypeDoubleVariableStar },
-    { "OC", kTypeOpenCluster },
     { "GC", kTypeGlobularCluster },
-    { "BN", kTypeBrightNebula },
-    { "DN", kTypeDarkNebula },
-    { "PN", kTypePlanetaryNebula },
     { "GX", kTypeGalaxy },
-    { "CN", kTypeConstellation },
-    { "AM", kTypeAsterism }
+    { "MN", kTypeMoon },
+    { "NO", kTypeNonexistent },
+    { "OC", kTypeOpenCluster },
+    { "PL", kTypePlanet },
+    { "PN", kTypePlanetaryNebula },
+    { "SC", kTypeSpacecraft },
+    { "SS", kTypeStar },
+    { "ST", kTypeSatellite },
+    { "VS", kTypeVariableStar }
 };
 
-string SSObject::typeToCode ( SSObjectType type )
+static_assert ( namessorted ( kTypeCodes ), "Object type codes must be sorted" );
+
+// Converts object type to two-character code, or empty string if type is not recognized.
+// The type map is never modified, so this may be called from several threads at once.
+
+const string &SSObject::typeToCode ( SSObjectType type )
 {
-    return _typeStrings[ type ];
+    static const string empty = "";
+    SSTypeStringMap::const_iterator it = _typeStrings.find ( type );
+    return it == _typeStrings.end() ? empty : it->second;
 }
 
-SSObjectType SSObject::codeToType ( string code )
+// Converts two-character code to object type, or kTypeNonexistent if code is not recognized.
+// The code table is a constant, built at compile time, so this may be called from several threads at once.
+
+SSObjectType SSObject::codeToType ( SSStringView code )
 {
-    return _stringTypes[ code ];
+    return (SSObjectType) findname ( kTypeCodes, sizeof ( kTypeCodes ) / sizeof ( kTypeCodes[0] ), code.data(), code.length(), kTypeNonexistent );
 }
 
 SSObject::SSObject ( void ) : SSObject ( kTypeNonexistent )
@@ -83,18 +98,41 @@ SSObject::SSObject ( void ) : SSObject ( kTypeNonexistent )
 SSObject::SSObject ( SSObjectType type )
 {
     _type = type;
-    _names = vector<string> ( 0 );
+    _names = vector<SSInternedString> ( 0 );
     _direction = SSVector ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
     _distance = HUGE_VAL;
     _magnitude = HUGE_VAL;
 }
 
-string SSObject::getName ( int i )
+const string &SSObject::getName ( int i )
 {
+    static const string empty = "";
+
     if ( i >= 0 && i < _names.size() )
-        return _names[i];
+        return _names[i].str();
     else
-        return string ( "" );
+        return empty;
+}
+
+// Replaces this object's names with interned copies of the given name strings.
+
+void SSObject::setNames ( const vector<string> &names )
+{
+    _names.resize ( names.size() );
+    for ( size_t i = 0; i < names.size(); i++ )
+        _names[i] = SSStringTable::intern ( names[i] );
+}
+
+// Returns true if any of this object's names is the given interned name.
+// Since names are interned, each comparison is a pointer compare.
+
+bool SSObject::hasName ( SSInternedString name )
+{
+    for ( SSInternedString myName : _names )
+        if ( myName == name )
+            return true;
+
+    return false;
 }
 
 // Default implementation of getIdentifer; overridden by subclasses.
@@ -104,6 +142,20 @@ SSIdentifier SSObject::getIdentifier ( SSCatalog cat )
     return SSIdentifier();
 }
 
+// Default implementation of getIdentifierCount; overridden by subclasses.
+
+int SSObject::getIdentifierCount ( void )
+{
+    return 0;
+}
+
+// Default implementation of getIdentifierAtIndex; overridden by subclasses.
+
+SSIdentifier SSObject::getIdentifierAtIndex ( int i )
+{
+    return SSIdentifier();
+}
+
 // Default implementation of addIdentifer; overridden by subclasses.
 
 bool SSObject::addIdentifier ( SSIdentifier ident )
@@ -111,11 +163,32 @@ bool SSObject::addIdentifier ( SSIdentifier ident )
     return false;
 }
 
-// Default implementation of toCSV; overridden by subclasses.
+// Default implementation of appendCSV; overridden by subclasses.
+
+void SSObject::appendCSV ( string &csv )
+{
+}
+
+// Appends a numeric CSV field to a string (csv): the value with (precision) decimal places,
+// and a leading '+' if (plus) is true, then a comma; or just a comma if the value is infinite (unknown).
+// Same output as format ( "%.*f,", precision, value ), without allocating memory.
+
+void SSObject::appendCSVField ( string &csv, double value, int precision, bool plus )
+{
+    if ( ! isinf ( value ) )
+        appendfixed ( csv, value, precision, 0, plus );
+
+    csv += ',';
+}
+
+// Returns CSV representation of the object as a new string.
+// Subclasses override appendCSV() to build it.
 
 string SSObject::toCSV ( void )
 {
-    return "";
+    string csv;
+    appendCSV ( csv );
+    return csv;
 }
 
 // Default implementation of compteEphemeris; overridden by subclasses.
@@ -152,126 +225,246 @@ SSObjectMap SSMakeObjectMap ( SSObjectVec &objects, SSCatalog cat )
 // and a vector of smart pointers to objects (objects), this function returns a smart pointer
 // to the first object in the vector which matches ident.  If the identifier does not map to
 // any object in the vector, this function returns a smart pointer to null!
+// The map is only searched, never modified. For catalogs that are searched often,
+// an SSIdentifierIndex is faster and more compact.
 
-SSObjectPtr SSIdentifierToObject ( SSIdentifier ident, SSObjectMap &map, SSObjectVec &objects )
+SSObjectPtr SSIdentifierToObject ( SSIdentifier ident, const SSObjectMap &map, SSObjectVec &objects )
 {
-    int k = map[ ident ];
+    SSObjectMap::const_iterator it = map.find ( ident );
 
-    if ( k > 0 )
-        return objects[ k - 1 ];
+    if ( it != map.end() && it->second > 0 )
+        return objects[ it->second - 1 ];
     else
         return SSObjectPtr ( nullptr );
 }
 
+// Returns a smart pointer to the first object in a vector (objects) with a particular name,
+// or a smart pointer to null if no object has that name. The name is looked up in the string
+// table once; if it was never interned, no object can have it, and the vector isn't searched.
+
+SSObjectPtr SSNameToObject ( const string &name, SSObjectVec &objects )
+{
+    SSInternedString interned;
+    if ( name.empty() || ! SSStringTable::find ( name, interned ) )
+        return SSObjectPtr ( nullptr );
+
+    for ( SSObjectPtr &pObject : objects )
+        if ( pObject && pObject->hasName ( interned ) )
+            return pObject;
+
+    return SSObjectPtr ( nullptr );
+}
+
+// Allocates a new object of class T, constructed with the given arguments. If an arena
+// is provided, the object and its shared pointer control block are allocated together
+// from the arena; otherwise the object is allocated from the heap.
+
+template <class T, class... Args> static shared_ptr<T> newObject ( SSArena *pArena, Args... args )
+{
+    if ( pArena != nullptr )
+        return allocate_shared<T> ( SSArenaAllocator<T> ( *pArena ), args... );
+    else
+        return shared_ptr<T> ( new T ( args... ) );
+}
+
 // Allocates a new object of the specific object type and returns a shared pointer to it.
-// On failure, returns a shared pointer to null.
+// If an arena is provided (pArena), the object is allocated from it; the arena must then
+// outlive the object. On failure, returns a shared pointer to null.
 
-SSObjectPtr SSNewObject ( SSObjectType type )
+SSObjectPtr SSNewObject ( SSObjectType type, SSArena *pArena )
 {
     if ( type >= kTypePlanet && type <= kTypeSpacecraft )
-        return shared_ptr<SSPlanet> ( new SSPlanet ( type ) );
+        return newObject<SSPlanet> ( pArena, type );
     else if ( type == kTypeStar )
-        return shared_ptr<SSStar> ( new SSStar );
+        return newObject<SSStar> ( pArena );
     else if ( type == kTypeDoubleStar )
-        return shared_ptr<SSDoubleStar> ( new SSDoubleStar );
+        return newObject<SSDoubleStar> ( pArena );
     else if ( type == kTypeVariableStar )
-        return shared_ptr<SSVariableStar> ( new SSVariableStar );
+        return newObject<SSVariableStar> ( pArena );
     else if ( type == kTypeDoubleVariableStar )
-        return shared_ptr<SSDoubleVariableStar> ( new SSDoubleVariableStar );
+        return newObject<SSDoubleVariableStar> ( pArena );
     else if ( type >= kTypeOpenCluster && type <= kTypeGalaxy )
-        return shared_ptr<SSDeepSky> ( new SSDeepSky ( type ) );
+        return newObject<SSDeepSky> ( pArena, type );
     else if ( type >= kTypeConstellation && type <= kTypeAsterism )
-        return shared_ptr<SSConstellation> ( new SSConstellation ( type ) );
+        return newObject<SSConstellation> ( pArena, type );
     else
         return shared_ptr<class SSObject> ( nullptr );
 }
 
+// Releases a vector of objects allocated from an arena, then the arena's memory. Each object's
+// destructor still runs, since its name and identifier vectors live on the heap; only the objects
+// themselves are freed together when the arena is cleared.
+// If any object is still referenced from outside the vector, the objects are released but
+// the arena is not cleared, and this function returns false; otherwise it returns true.
+// After it returns false, the objects still referenced live in the arena's blocks, so the caller
+// must release those references before the arena is cleared or destroyed, then clear it.
+
+bool SSReleaseObjects ( SSObjectVec &objects, SSArena &arena )
+{
+    bool shared = false;
+    for ( SSObjectPtr &pObject : objects )
+        if ( pObject.use_count() > 1 )
+            shared = true;
+
+    SSObjectVec().swap ( objects );
+    if ( shared )
+        return false;
+
+    arena.clear();
+    return true;
+}
+
+// Size of the buffer SSExportObjectsToCSV() fills before each write.
+
+static constexpr size_t kExportBufferSize = 1 << 16;
+
 // Exports a vector of objects to a CSV-formatted text file.
 // If the filename is an empty string, streams CSV to standard output.
+// Objects are appended to one reusable buffer, which is written out whenever it fills,
+// so exporting makes no per-object allocations and no per-line flushes.
 // Returns the number of objects exported.
 
 int SSExportObjectsToCSV ( const string &filename, SSObjectVec &objects )
 {
-    int i = 0;
-    
-    // If filename is empty, just stream everything to stdout
-    
-    if ( filename.empty() )
-    {
-        for ( i = 0; i < objects.size(); i++ )
-            cout << objects[i].get()->toCSV() << endl;
-        
-        return i;
-    }
-
+    // If filename is empty, just stream everything to stdout.
     // Otherwise open file; return on failure.
 
-    ofstream file ( filename );
+    FILE *file = filename.empty() ? stdout : fopen ( filename.c_str(), "w" );
     if ( ! file )
         return 0;
-    
-    // Stream everything to file.
-    
+
+    string csv;
+    csv.reserve ( kExportBufferSize + 1024 );
+
+    int i = 0;
     for ( i = 0; i < objects.size(); i++ )
-        file << objects[i].get()->toCSV() << endl;
+    {
+        objects[i]->appendCSV ( csv );
+        csv += '\n';
+
+        if ( csv.size() >= kExportBufferSize )
+        {
+            fwrite ( csv.data(), 1, csv.size(), file );
+            csv.clear();
+        }
+    }
+
+    fwrite ( csv.data(), 1, csv.size(), file );
+
+    if ( file == stdout )
+        fflush ( file );
+    else
+        fclose ( file );
+
+    // Return object count.
 
-    // Return object count; file will close automatically.
-    
     return i;
 }
 
-// Imports objects from CSV-formatted text file (filename).
-// Imported objects are appended to the input vector of SSObjects (objects).
-// Returns number of objects successfully imported.
+// Creates a new object from a CSV-formatted text string: first tries to parse
+// a solar system object, then a star or deep sky object, then a constellation.
+// If an arena is provided (pArena), the object is allocated from it.
+// Returns null pointer if the string can't be parsed as any kind of object.
 
-int SSImportObjectsFromCSV ( const string &filename, SSObjectVec &objects )
+SSObjectPtr SSObjectFromCSV ( const string &csv, SSArena *pArena )
 {
-    // Open file; return on failure.
+    SSObjectPtr pObject = SSPlanet::fromCSV ( csv, pArena );
+    if ( pObject == nullptr )
+        pObject = SSStar::fromCSV ( csv, pArena );
+    if ( pObject == nullptr )
+        pObject = SSConstellation::fromCSV ( csv, pArena );
 
-    FILE *file = fopen ( filename.c_str(), "r" );
-    if ( ! file )
-        return 0;
+    return pObject;
+}
+
+// Minimum number of bytes of CSV text worth giving to a thread of its own in SSImportObjectsFromCSV().
 
-    // Read file line-by-line until we reach end-of-file
+static constexpr size_t kMinBytesPerThread = 1 << 18;
 
-    string line = "";
-    int numObjects = 0;
+// Creates objects from each line of CSV text from (first) up to (last), which must end
+// with a newline or the end of the file, and appends them to a vector (objects).
+// If an arena is provided (pArena), objects are allocated from it.
+
+static void importObjectsFromCSV ( const char *first, const char *last, SSObjectVec &objects, SSArena *pArena )
+{
+    string line;
 
-    while ( fgetline ( file, line ) )
+    while ( first < last )
     {
-        // Attempt to create solar system object from CSV file line; if successful add to object vector.
-        
-        SSObjectPtr pObject = SSPlanet::fromCSV ( line );
-        if ( pObject )
-        {
-            objects.push_back ( pObject );
-            numObjects++;
-            continue;
-        }
+        const char *eol = (const char *) memchr ( first, '\n', last - first );
+        const char *next = eol ? eol + 1 : last;
 
-        // Attempt to create star from CSV file line; if successful add to object vector.
+        // Attempt to create object from CSV file line; if successful add to object vector.
 
-        pObject = SSStar::fromCSV ( line );
+        line.assign ( first, next );
+        SSObjectPtr pObject = SSObjectFromCSV ( line, pArena );
         if ( pObject )
-        {
             objects.push_back ( pObject );
-            numObjects++;
-            continue;
-        }
-        
-        // Attempt to create constellation from CSV file line; if successful add to object vector.
 
-        pObject = SSConstellation::fromCSV ( line );
-        if ( pObject )
-        {
-            objects.push_back ( pObject );
-            numObjects++;
-            continue;
-        }
+        first = next;
     }
-    
-    // Close file. Return number of objects added to object vector.
+}
+
+// Imports objects from CSV-formatted text file (filename).
+// Imported objects are appended to the input vector of SSObjects (objects),
+// in the same order as the lines of the file they came from.
+// If an arena is provided (pArena), objects are allocated from it.
+// The file is mapped into memory and split into chunks at line boundaries, which are parsed
+// in parallel by up to (numThreads) threads; if zero, uses one thread per hardware core.
+// Arenas are not thread-safe, so if one is provided, the file is parsed on this thread only.
+// Returns number of objects successfully imported.
+
+int SSImportObjectsFromCSV ( const string &filename, SSObjectVec &objects, SSArena *pArena, int numThreads )
+{
+    // Map file; return on failure.
+
+    SSMappedFile file;
+    if ( ! file.open ( filename ) )
+        return 0;
+
+    const char *data = file.data();
+    size_t size = file.size();
+
+    // Choose number of chunks; never more than hardware threads, or than the file size justifies.
+
+    if ( pArena != nullptr )
+        numThreads = 1;
+    else if ( numThreads < 1 )
+        numThreads = max ( 1, (int) thread::hardware_concurrency() );
+
+    size_t numChunks = min ( (size_t) numThreads, size / kMinBytesPerThread + 1 );
+
+    // Move each chunk boundary forward to the start of the next line.
+
+    vector<const char *> bounds ( numChunks + 1, data + size );
+    bounds[0] = data;
+
+    for ( size_t t = 1; t < numChunks; t++ )
+    {
+        const char *p = max ( data + t * ( size / numChunks ), bounds[t - 1] );
+        const char *eol = (const char *) memchr ( p, '\n', data + size - p );
+        bounds[t] = eol ? eol + 1 : data + size;
+    }
+
+    // The first chunk is appended directly to the object vector on this thread;
+    // the others are parsed into vectors of their own, then appended in order.
+
+    size_t numObjects = objects.size();
+    vector<SSObjectVec> chunkObjects ( numChunks );
+    vector<thread> threads;
+
+    for ( size_t t = 1; t < numChunks; t++ )
+        threads.push_back ( thread ( importObjectsFromCSV, bounds[t], bounds[t + 1], ref ( chunkObjects[t] ), nullptr ) );
+
+    importObjectsFromCSV ( bounds[0], bounds[1], objects, pArena );
+
+    for ( thread &t : threads )
+        t.join();
+
+    for ( size_t t = 1; t < numChunks; t++ )
+        objects.insert ( objects.end(), make_move_iterator ( chunkObjects[t].begin() ), make_move_iterator ( chunkObjects[t].end() ) );
+
+    // Return number of objects added to object vector; file will be unmapped automatically.
 
-    fclose ( file );
-    return numObjects;
+    return (int) ( objects.size() - numObjects );
 }
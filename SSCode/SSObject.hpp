@@ -18,6 +18,7 @@
 
 #include "SSVector.hpp"
 #include "SSIdentifier.hpp"
+#include "SSStringTable.hpp"
 
 using namespace std;
 
@@ -46,19 +47,22 @@ enum SSObjectType
     kTypeAsterism = 31,              // Common but informally recognized star pattern (Big Dipper, Summer Triangle, etc.)
 };
 
-#pragma pack ( push, 1 )
-
 // This is the base class for all astronomical objects (planets, stars, deep sky objects, constellations, etc.)
 
 class SSObject
 {
 protected:
     
-    SSObjectType    _type;          // object type code
-    vector<string>  _names;         // vector of name string(s)
+    // Ephemeris fields, written by every call to computeEphemeris(), are grouped together
+    // at the start of the object, so they usually share one cache line.
+
     SSVector        _direction;     // apparent direction to object as unit vector in fundamental reference frame; infinite if unknown
     double          _distance;      // distance to object in AU; infinite if unknown
     float           _magnitude;     // visual magnitude; infinite if unknown
+    SSObjectType    _type;          // object type code
+    vector<SSInternedString> _names;    // vector of name string(s), interned
+
+    static void appendCSVField ( string &csv, double value, int precision, bool plus = false );
     
 public:
 
@@ -70,29 +74,35 @@ public:
     // accessors
     
     SSObjectType getType ( void ) { return _type; }
-    vector<string> getNames ( void ) { return _names; }
+    const vector<SSInternedString> &getNames ( void ) { return _names; }
     SSVector getDirection ( void ) { return _direction; }
     double getDistance ( void ) { return _distance; }
     float getMagnitude ( void ) { return _magnitude; }
     
     // modifiers. Type cannot be changed after object construction!
+    // Names and type strings are interned (see SSStringTable). Other vector arguments
+    // are moved into the object; pass with move() to avoid a copy.
     
-    void setNames ( vector<string> names ) { _names = names; }
+    void setNames ( const vector<string> &names );
     void setDirection ( SSVector dir ) { _direction = dir; }
     void setDistance ( double dist ) { _distance = dist; }
     void setMagnitude ( float mag ) { _magnitude = mag; }
     
     // Converts integer object types to two-character type codes and vice-versa.
     
-    static string typeToCode ( SSObjectType type );
-    static SSObjectType codeToType ( string );
+    static const string &typeToCode ( SSObjectType type );
+    static SSObjectType codeToType ( SSStringView code );
 
-    virtual string getName ( int i );                           // returns copy of i-th name string
+    virtual const string &getName ( int i );                    // returns reference to i-th name string, or empty string if i is out of range
+    bool hasName ( SSInternedString name );                     // returns true if the object has the specified name
     virtual SSIdentifier getIdentifier ( SSCatalog cat );       // returns identifier in the specified catalog, or null identifier if object has none in that catalog.
+    virtual int getIdentifierCount ( void );                    // returns number of identifiers the object has in all catalogs
+    virtual SSIdentifier getIdentifierAtIndex ( int i );        // returns i-th identifier, or null identifier if i is out of range
     virtual bool addIdentifier ( SSIdentifier ident );          // adds the specified identifier to the object, only if the ident is valid and not already present.
     virtual void computeEphemeris ( class SSDynamics &dyn );    // computes direction, distance, magnitude for the given dynamical state
 
-    virtual string toCSV ( void );
+    virtual void appendCSV ( string &csv );                     // appends CSV representation of the object to a string, without allocating memory if it has room
+    string toCSV ( void );                                      // returns CSV representation of the object as a new string
 };
 
 typedef shared_ptr<SSObject> SSObjectPtr;
@@ -100,13 +110,15 @@ typedef shared_ptr<SSObject> CMBblah;
 typedef vector<SSObjectPtr> SSObjectVec;
 typedef map<SSIdentifier,int> SSObjectMap;
 
-SSObjectPtr SSNewObject ( SSObjectType type );
+SSObjectPtr SSNewObject ( SSObjectType type, class SSArena *pArena = nullptr );
+SSObjectPtr SSObjectFromCSV ( const string &csv, class SSArena *pArena = nullptr );
 SSObjectMap SSMakeObjectMap ( SSObjectVec &objects, SSCatalog cat );
-SSObjectPtr SSIdentifierToObject ( SSIdentifier ident, SSObjectMap &map, SSObjectVec &objects );
+SSObjectPtr SSIdentifierToObject ( SSIdentifier ident, const SSObjectMap &map, SSObjectVec &objects );
+SSObjectPtr SSNameToObject ( const string &name, SSObjectVec &objects );
 
-int SSImportObjectsFromCSV ( const string &filename, SSObjectVec &objects );
-int SSExportObjectsToCSV ( const string &filename, SSObjectVec &objects );
+bool SSReleaseObjects ( SSObjectVec &objects, class SSArena &arena );
 
-#pragma pack ( pop )
+int SSImportObjectsFromCSV ( const string &filename, SSObjectVec &objects, class SSArena *pArena = nullptr, int numThreads = 0 );
+int SSExportObjectsToCSV ( const string &filename, SSObjectVec &objects );
 
 #endif /* SSObject_hpp */
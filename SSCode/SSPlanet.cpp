@@ -20,6 +20,15 @@ SSPlanet::SSPlanet ( SSObjectType type, SSPlanetID id ) : SSPlanet ( type )
     _id = SSIdentifier ( kCatJPLanet, id );
 }
 
+// Returns this object's identifier if it is in the specified catalog (cat);
+// otherwise returns the null identifier.
+
+SSIdentifier SSPlanet::getIdentifier ( SSCatalog cat )
+{
+    SSIdentifier ident = _id;
+    return ident.catalog() == cat ? ident : SSIdentifier();
+}
+
 void SSPlanet::computeEphemeris ( SSDynamics &dyn )
 {
     double lt = 0.0;
@@ -40,41 +49,46 @@ SSPlanetPtr SSGetPlanetPtr ( SSObjectPtr ptr )
     return dynamic_cast<SSPlanet *> ( ptr.get() );
 }
 
-// Returns CSV string from planet data, including identifier and names.
+// Appends CSV string from planet data, including identifier and names.
 
-string SSPlanet::toCSV ( void )
+void SSPlanet::appendCSV ( string &csv )
 {
-    string csv = SSObject::typeToCode ( _type ) + ",";
+    csv += SSObject::typeToCode ( _type );
+    csv += ',';
     
     if ( _type == kTypeMoon )
-        csv += isinf ( _orbit.q ) ? "," : format ( "%.0f,", _orbit.q * SSDynamics::kKmPerAU );
+        appendCSVField ( csv, _orbit.q * SSDynamics::kKmPerAU, 0 );
     else
-        csv += isinf ( _orbit.q ) ? "," : format ( "%.8f,", _orbit.q );
-
-    csv += isinf ( _orbit.e ) ? "," : format ( "%.8f,", _orbit.e );
-    csv += isinf ( _orbit.i ) ? "," : format ( "%.8f,", _orbit.i * SSAngle::kDegPerRad );
-    csv += isinf ( _orbit.w ) ? "," : format ( "%.8f,", _orbit.w * SSAngle::kDegPerRad );
-    csv += isinf ( _orbit.n ) ? "," : format ( "%.8f,", _orbit.n * SSAngle::kDegPerRad );
-    csv += isinf ( _orbit.m ) ? "," : format ( "%.8f,", _orbit.m * SSAngle::kDegPerRad );
-    csv += isinf ( _orbit.mm ) ? "," : format ( "%.8f,", _orbit.mm * SSAngle::kDegPerRad );
-    csv += isinf ( _orbit.t ) ? "," : format ( "%.4f,", _orbit.t );
+        appendCSVField ( csv, _orbit.q, 8 );
+
+    appendCSVField ( csv, _orbit.e, 8 );
+    appendCSVField ( csv, _orbit.i * SSAngle::kDegPerRad, 8 );
+    appendCSVField ( csv, _orbit.w * SSAngle::kDegPerRad, 8 );
+    appendCSVField ( csv, _orbit.n * SSAngle::kDegPerRad, 8 );
+    appendCSVField ( csv, _orbit.m * SSAngle::kDegPerRad, 8 );
+    appendCSVField ( csv, _orbit.mm * SSAngle::kDegPerRad, 8 );
+    appendCSVField ( csv, _orbit.t, 4 );
     
-    csv += isinf ( _Hmag ) ? "," : format ( "%+.2f,", _Hmag );
-    csv += isinf ( _Gmag ) ? "," : format ( "%+.2f,", _Gmag );
-    csv += isinf ( _radius ) ? "," : format ( "%.1f,", _radius );
+    appendCSVField ( csv, _Hmag, 2, true );
+    appendCSVField ( csv, _Gmag, 2, true );
+    appendCSVField ( csv, _radius, 1 );
 
-    csv += _id ? _id.toString() + "," : ",";
+    if ( _id )
+        _id.appendString ( csv );
+    csv += ',';
         
-    for ( int i = 0; i < _names.size(); i++ )
-        csv += _names[i] + ",";
-
-    return csv;
+    for ( const SSInternedString &name : _names )
+    {
+        csv += name.str();
+        csv += ',';
+    }
 }
 
 // Allocates a new SSPlanet and initializes it from a CSV-formatted string.
+// If an arena is provided (pArena), the object is allocated from it.
 // Returns nullptr on error (invalid CSV string, heap allocation failure, etc.)
 
-SSObjectPtr SSPlanet::fromCSV ( string csv )
+SSObjectPtr SSPlanet::fromCSV ( string csv, SSArena *pArena )
 {
     vector<string> fields = split ( csv, "," );
     
@@ -108,9 +122,10 @@ SSObjectPtr SSPlanet::fromCSV ( string csv )
 
     vector<string> names;
     for ( int i = 13; i < fields.size(); i++ )
-        names.push_back ( trim ( fields[i] ) );
+        if ( ! trim ( fields[i] ).empty() )
+            names.push_back ( trim ( fields[i] ) );
     
-	SSObjectPtr pObject = SSNewObject ( type );
+	SSObjectPtr pObject = SSNewObject ( type, pArena );
     SSPlanetPtr pPlanet = SSGetPlanetPtr ( pObject );
     if ( pPlanet == nullptr )
         return nullptr;
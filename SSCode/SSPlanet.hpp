@@ -85,7 +85,9 @@ public:
     void setGMagnitude ( float gmag ) { _Gmag = gmag; }
     void setRadius ( float radius ) { _radius = radius; }
 
-    SSIdentifier getIdentifier ( SSIdentifier ident ) { return _id; }
+    SSIdentifier getIdentifier ( SSCatalog cat );
+    int getIdentifierCount ( void ) { return _id ? 1 : 0; }
+    SSIdentifier getIdentifierAtIndex ( int i ) { return i == 0 ? _id : SSIdentifier(); }
     SSOrbit getOrbit ( void ) { return _orbit; }
     float getHMagnitude ( void ) { return _Hmag; }
     float getGMagnitude ( void ) { return _Gmag; }
@@ -95,8 +97,8 @@ public:
     
     // imports/exports from/to CSV-format text string
     
-    static SSObjectPtr fromCSV ( string csv );
-    string toCSV ( void );
+    static SSObjectPtr fromCSV ( string csv, class SSArena *pArena = nullptr );
+    void appendCSV ( string &csv );
 };
 
 // convenient aliases for pointers to various subclasses of SSPlanet
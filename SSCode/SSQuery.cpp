@@ -0,0 +1,265 @@
+// SSQuery.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 5/1/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+
+#include "SSQuery.hpp"
+#include "SSStar.hpp"
+
+// Bit mask of the object types which are SSStar subclasses (stars and deep sky objects),
+// the only objects in sky tiles.
+
+static constexpr uint64_t kStarTypes = ( ( 1ULL << ( kTypeGalaxy + 1 ) ) - 1 ) & ~( ( 1ULL << kTypeStar ) - 1 );
+
+// Returns bit for an object type (type) in a type mask.
+
+static inline uint64_t typeBit ( SSObjectType type )
+{
+    return 1ULL << ( type & 63 );
+}
+
+// Constructs a query which matches every object.
+
+SSQuery::SSQuery ( void ) : _region ( SSVector ( 0.0, 0.0, 1.0 ), SSAngle::kPi )
+{
+    _types = 0;
+    _minMag = -HUGE_VAL;
+    _maxMag = HUGE_VAL;
+    _minDist = -HUGE_VAL;
+    _maxDist = HUGE_VAL;
+    _hasRegion = false;
+    _pSkyTiles = nullptr;
+    _pSkyIndex = nullptr;
+}
+
+// Adds an object type (type) to the types this query matches.
+// Until a type is added, the query matches objects of any type.
+
+SSQuery &SSQuery::addType ( SSObjectType type )
+{
+    _types |= typeBit ( type );
+    return *this;
+}
+
+// Adds all object types from first to last, inclusive, to the types this query matches;
+// for example, kTypeStar to kTypeDoubleVariableStar matches every kind of star.
+
+SSQuery &SSQuery::addTypes ( SSObjectType first, SSObjectType last )
+{
+    for ( int type = first; type <= last; type++ )
+        _types |= typeBit ( (SSObjectType) type );
+
+    return *this;
+}
+
+// Matches only objects with magnitudes from minMag to maxMag, inclusive. Pass -HUGE_VAL or HUGE_VAL
+// for either limit to leave that end of the range open. Objects with unknown magnitudes never match.
+// A star whose ephemeris has not been computed is matched by its visual magnitude, as in SSSkyTiles.
+
+SSQuery &SSQuery::setMagnitudeRange ( float minMag, float maxMag )
+{
+    _minMag = minMag;
+    _maxMag = maxMag;
+    return *this;
+}
+
+// Matches only objects with distances from minDist to maxDist AU, inclusive, as computed by
+// the last call to computeEphemeris(). Pass -HUGE_VAL or HUGE_VAL for either limit to leave
+// that end of the range open. Objects with unknown distances never match.
+
+SSQuery &SSQuery::setDistanceRange ( double minDist, double maxDist )
+{
+    _minDist = minDist;
+    _maxDist = maxDist;
+    return *this;
+}
+
+// Matches only objects inside a region of the sky. A star whose ephemeris has not been computed
+// is matched by its fundamental J2000 position, as in SSSkyIndex.
+
+SSQuery &SSQuery::setRegion ( const SSSkyRegion &region )
+{
+    _region = region;
+    _hasRegion = true;
+    return *this;
+}
+
+// Matches only objects within an angular radius (in radians) of a center unit vector.
+
+SSQuery &SSQuery::setCone ( SSVector center, double radius )
+{
+    return setRegion ( SSSkyRegion ( center, radius ) );
+}
+
+// Adds a catalog (cat) to those in which an object must have an identifier to match.
+// If several catalogs are added, an identifier in any one of them matches.
+
+SSQuery &SSQuery::addCatalog ( SSCatalog cat )
+{
+    _catalogs.push_back ( cat );
+    return *this;
+}
+
+// Uses sky tiles built from the catalog to find stars and deep sky objects brighter than
+// the query's faintest magnitude, if the query matches only those types. Tiles file variable
+// stars by their brightest magnitude, so candidates are then matched by current magnitude.
+
+SSQuery &SSQuery::useSkyTiles ( SSSkyTiles &tiles )
+{
+    _pSkyTiles = &tiles;
+    return *this;
+}
+
+// Uses a sky index built from the catalog to find objects in the query's region.
+
+SSQuery &SSQuery::useSkyIndex ( SSSkyIndex &index )
+{
+    _pSkyIndex = &index;
+    return *this;
+}
+
+bool SSQuery::matchesType ( SSObject *pObject )
+{
+    return _types == 0 || ( _types & typeBit ( pObject->getType() ) );
+}
+
+bool SSQuery::matchesMagnitude ( SSObject *pObject )
+{
+    if ( isinf ( _minMag ) && isinf ( _maxMag ) )
+        return true;
+
+    float mag = pObject->getMagnitude();
+    if ( isinf ( mag ) )
+    {
+        SSStar *pStar = dynamic_cast<SSStar *> ( pObject );
+        if ( pStar != nullptr )
+            mag = pStar->getVMagnitude();
+    }
+
+    return ! isinf ( mag ) && mag >= _minMag && mag <= _maxMag;
+}
+
+bool SSQuery::matchesDistance ( SSObject *pObject )
+{
+    if ( isinf ( _minDist ) && isinf ( _maxDist ) )
+        return true;
+
+    double dist = pObject->getDistance();
+    return ! isinf ( dist ) && dist >= _minDist && dist <= _maxDist;
+}
+
+bool SSQuery::matchesRegion ( SSObject *pObject )
+{
+    if ( ! _hasRegion )
+        return true;
+
+    SSVector dir = pObject->getDirection();
+    if ( isinf ( dir.x ) )
+    {
+        SSStar *pStar = dynamic_cast<SSStar *> ( pObject );
+        if ( pStar != nullptr )
+            dir = pStar->getFundamentalPosition();
+    }
+
+    return ! isinf ( dir.x ) && _region.contains ( dir.normalize() );
+}
+
+bool SSQuery::matchesCatalog ( SSObject *pObject )
+{
+    if ( _catalogs.empty() )
+        return true;
+
+    for ( SSCatalog cat : _catalogs )
+        if ( pObject->getIdentifier ( cat ) )
+            return true;
+
+    return false;
+}
+
+// Returns true if an object (pObject) matches all of this query's criteria, testing the cheapest first.
+// Null objects never match.
+
+bool SSQuery::matches ( SSObject *pObject )
+{
+    return pObject != nullptr && matchesType ( pObject ) && matchesMagnitude ( pObject )
+        && matchesDistance ( pObject ) && matchesRegion ( pObject ) && matchesCatalog ( pObject );
+}
+
+// Finds indices of objects which may match this query using the most selective index available:
+// sky tiles if the query has a faint magnitude limit and matches only stars and deep sky objects,
+// otherwise a sky index if the query has a region. Candidates are returned in ascending order
+// without duplicates. Identifier indexes are not used, since they refer to only one of several
+// objects which share an identifier (for instance, the same star in two catalogs).
+// Returns false if no index applies, and the whole catalog must be scanned.
+
+bool SSQuery::getCandidates ( vector<int> &candidates )
+{
+    if ( _pSkyTiles != nullptr && ! isinf ( _maxMag ) && _types != 0 && ( _types & ~kStarTypes ) == 0 )
+    {
+        vector<SSSkyTileSpan> spans;
+        SSSkyRegion view = _hasRegion ? _region : SSSkyRegion ( SSVector ( 0.0, 0.0, 1.0 ), SSAngle::kPi );
+        _pSkyTiles->query ( view, _maxMag, spans );
+
+        for ( SSSkyTileSpan &span : spans )
+            for ( int i = 0; i < span.count; i++ )
+                candidates.push_back ( span.entries[i].index );
+    }
+    else if ( _pSkyIndex != nullptr && _hasRegion )
+    {
+        _pSkyIndex->regionSearch ( _region, candidates );
+    }
+    else
+    {
+        return false;
+    }
+
+    sort ( candidates.begin(), candidates.end() );
+    candidates.erase ( unique ( candidates.begin(), candidates.end() ), candidates.end() );
+    return true;
+}
+
+// Finds all objects in a catalog vector (objects) which match this query, and appends their
+// indices in the vector to the results vector, in ascending order. Returns the number of objects found.
+
+int SSQuery::run ( SSObjectVec &objects, vector<int> &results )
+{
+    size_t n = results.size();
+    vector<int> candidates;
+
+    if ( getCandidates ( candidates ) )
+    {
+        for ( int i : candidates )
+            if ( i >= 0 && i < objects.size() && matches ( objects[i].get() ) )
+                results.push_back ( i );
+    }
+    else
+    {
+        for ( int i = 0; i < objects.size(); i++ )
+            if ( matches ( objects[i].get() ) )
+                results.push_back ( i );
+    }
+
+    return (int) ( results.size() - n );
+}
+
+// Removes indices of objects in a catalog vector (objects) which do not match this query
+// from a vector of indices (indices), for instance the results of another query.
+// The order of the remaining indices is unchanged. Returns the number of indices remaining.
+
+int SSQuery::filter ( SSObjectVec &objects, vector<int> &indices )
+{
+    size_t j = 0;
+
+    for ( size_t k = 0; k < indices.size(); k++ )
+    {
+        int i = indices[k];
+        if ( i >= 0 && i < objects.size() && matches ( objects[i].get() ) )
+            indices[j++] = i;
+    }
+
+    indices.resize ( j );
+    return (int) j;
+}
@@ -0,0 +1,71 @@
+// SSQuery.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 5/1/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Selects objects from a catalog vector by type, magnitude range, distance range,
+// sky region, and catalog membership, without the caller downcasting each object.
+// Criteria are added one at a time, and all must match. A query uses any sky tiles or sky index
+// it has been given to find candidate objects, instead of scanning the whole catalog; it then
+// tests each candidate against the cheapest criteria first (type, magnitude, distance), leaving
+// direction tests and virtual identifier lookups for last. Results are indices of matching objects
+// in the catalog vector, in ascending order, so a result can be filtered further by another query
+// without copying any objects.
+
+#ifndef SSQuery_hpp
+#define SSQuery_hpp
+
+#include <cstdint>
+#include <vector>
+
+#include "SSObject.hpp"
+#include "SSSkyIndex.hpp"
+#include "SSSkyTiles.hpp"
+
+class SSQuery
+{
+protected:
+
+    uint64_t _types;                    // bit mask of object types to match; 0 matches any type
+    float _minMag, _maxMag;             // range of magnitudes to match; infinite limits match any magnitude
+    double _minDist, _maxDist;          // range of distances to match in AU; infinite limits match any distance
+    bool _hasRegion;                    // true if objects must lie inside _region
+    SSSkyRegion _region;                // region of sky to match
+    vector<SSCatalog> _catalogs;        // objects must have an identifier in at least one of these catalogs; empty matches any
+
+    SSSkyTiles *_pSkyTiles;             // sky tiles of catalog, if any
+    SSSkyIndex *_pSkyIndex;             // sky index of catalog, if any
+
+    bool matchesType ( SSObject *pObject );
+    bool matchesMagnitude ( SSObject *pObject );
+    bool matchesDistance ( SSObject *pObject );
+    bool matchesRegion ( SSObject *pObject );
+    bool matchesCatalog ( SSObject *pObject );
+    bool getCandidates ( vector<int> &candidates );
+
+public:
+
+    SSQuery ( void );
+
+    // criteria; each returns a reference to this query, so criteria can be chained.
+
+    SSQuery &addType ( SSObjectType type );
+    SSQuery &addTypes ( SSObjectType first, SSObjectType last );
+    SSQuery &setMagnitudeRange ( float minMag, float maxMag );
+    SSQuery &setDistanceRange ( double minDist, double maxDist );
+    SSQuery &setRegion ( const SSSkyRegion &region );
+    SSQuery &setCone ( SSVector center, double radius );
+    SSQuery &addCatalog ( SSCatalog cat );
+
+    // indexes of the catalog to be searched, which must be up to date with it.
+
+    SSQuery &useSkyTiles ( SSSkyTiles &tiles );
+    SSQuery &useSkyIndex ( SSSkyIndex &index );
+
+    bool matches ( SSObject *pObject );
+    int run ( SSObjectVec &objects, vector<int> &results );
+    int filter ( SSObjectVec &objects, vector<int> &indices );
+};
+
+#endif /* SSQuery_hpp */
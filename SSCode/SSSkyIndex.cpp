@@ -0,0 +1,648 @@
+// SSSkyIndex.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/16/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+#include <vector>
+
+#include "SSSkyIndex.hpp"
+#include "SSStar.hpp"
+#include "SSStarStore.hpp"
+
+// Vertices of the octahedron whose faces are the 8 root trixels,
+// and the vertices of each root trixel, in counter-clockwise order
+// as seen from outside the sphere. Root trixels S0-S3 have IDs 8-11;
+// root trixels N0-N3 have IDs 12-15.
+
+static SSVector _octVerts[6] =
+{
+    SSVector (  0.0,  0.0,  1.0 ),
+    SSVector (  1.0,  0.0,  0.0 ),
+    SSVector (  0.0,  1.0,  0.0 ),
+    SSVector ( -1.0,  0.0,  0.0 ),
+    SSVector (  0.0, -1.0,  0.0 ),
+    SSVector (  0.0,  0.0, -1.0 )
+};
+
+static int _rootVerts[8][3] =
+{
+    { 1, 5, 2 },    // S0
+    { 2, 5, 3 },    // S1
+    { 3, 5, 4 },    // S2
+    { 4, 5, 1 },    // S3
+    { 1, 0, 4 },    // N0
+    { 4, 0, 3 },    // N1
+    { 3, 0, 2 },    // N2
+    { 2, 0, 1 }     // N3
+};
+
+// Returns the midpoint of the great-circle arc between two unit vectors, as a unit vector.
+
+static SSVector midpoint ( SSVector v0, SSVector v1 )
+{
+    return ( v0 + v1 ).normalize();
+}
+
+// Returns the vertices of one of the 8 root trixels (0-7), whose IDs are 8-15.
+
+void SSSkyIndex::getRootTrixel ( int root, SSVector &v0, SSVector &v1, SSVector &v2 )
+{
+    v0 = _octVerts[ _rootVerts[root][0] ];
+    v1 = _octVerts[ _rootVerts[root][1] ];
+    v2 = _octVerts[ _rootVerts[root][2] ];
+}
+
+// Replaces the vertices of a trixel (v0,v1,v2) with those of one of its 4 children (0-3).
+// Children 0-2 are at the corners v0-v2; child 3 is in the middle.
+
+void SSSkyIndex::getChildTrixel ( int child, SSVector &v0, SSVector &v1, SSVector &v2 )
+{
+    SSVector w0 = midpoint ( v1, v2 );
+    SSVector w1 = midpoint ( v0, v2 );
+    SSVector w2 = midpoint ( v0, v1 );
+
+    if ( child == 0 )
+    {
+        v1 = w2;
+        v2 = w1;
+    }
+    else if ( child == 1 )
+    {
+        v0 = v1;
+        v1 = w0;
+        v2 = w2;
+    }
+    else if ( child == 2 )
+    {
+        v0 = v2;
+        v1 = w1;
+        v2 = w0;
+    }
+    else
+    {
+        v0 = w0;
+        v1 = w1;
+        v2 = w2;
+    }
+}
+
+// Constructs a circular cone-shaped region with the given center and angular radius in radians.
+
+SSSkyRegion::SSSkyRegion ( SSVector center, double radius )
+{
+    _center = center.normalize();
+    _radius = radius > SSAngle::kPi ? SSAngle::kPi : radius;
+    _cosRadius = cos ( _radius );
+}
+
+// Constructs a convex polygonal region from its vertices. The vertices are connected
+// by great-circle arcs, and may be given in either clockwise or counter-clockwise order.
+// The polygon must be convex and smaller than a hemisphere. If fewer than 3 vertices
+// are given, the region is empty.
+
+SSSkyRegion::SSSkyRegion ( vector<SSVector> &vertices )
+{
+    _center = SSVector ( HUGE_VAL, HUGE_VAL, HUGE_VAL );
+    _radius = -1.0;
+    _cosRadius = HUGE_VAL;
+
+    int n = (int) vertices.size();
+    if ( n < 3 )
+        return;
+
+    SSVector centroid ( 0.0, 0.0, 0.0 );
+    for ( int i = 0; i < n; i++ )
+        centroid += vertices[i].normalize();
+
+    for ( int i = 0; i < n; i++ )
+    {
+        SSVector v0 = vertices[i].normalize();
+        SSVector v1 = vertices[ ( i + 1 ) % n ].normalize();
+        _planes.push_back ( v0.crossProduct ( v1 ).normalize() );
+    }
+
+    // If vertices were given in clockwise order, all normals point away from the polygon.
+
+    if ( _planes[0].dotProduct ( centroid ) < 0.0 )
+        for ( int i = 0; i < n; i++ )
+            _planes[i] *= -1.0;
+}
+
+// Returns true if the region contains the given unit vector.
+
+bool SSSkyRegion::contains ( SSVector dir )
+{
+    if ( isCone() )
+        return _radius >= 0.0 && _center.dotProduct ( dir ) >= _cosRadius;
+
+    for ( int i = 0; i < _planes.size(); i++ )
+        if ( _planes[i].dotProduct ( dir ) < 0.0 )
+            return false;
+
+    return true;
+}
+
+// Determines whether the spherical triangle with vertices (v0,v1,v2) lies completely
+// outside, completely inside, or partially inside this region. The test is conservative:
+// kOutside and kInside are only returned when certain; otherwise kPartial is returned.
+
+SSSkyRegion::Overlap SSSkyRegion::overlap ( SSVector v0, SSVector v1, SSVector v2 )
+{
+    if ( isCone() && _radius < 0.0 )
+        return kOutside;
+
+    // Find the triangle's bounding circle.
+
+    SSVector c = ( v0 + v1 + v2 ).normalize();
+    double cosr = c.dotProduct ( v0 );
+    cosr = fmin ( cosr, c.dotProduct ( v1 ) );
+    cosr = fmin ( cosr, c.dotProduct ( v2 ) );
+    double r = acos ( max ( -1.0, min ( cosr, 1.0 ) ) );
+
+    if ( isCone() )
+    {
+        double d = acos ( max ( -1.0, min ( _center.dotProduct ( c ), 1.0 ) ) );
+        if ( d > _radius + r )
+            return kOutside;
+
+        if ( d + r <= _radius )
+            return kInside;
+
+        // A cone no wider than a hemisphere is convex, so it contains the triangle
+        // if it contains all three vertices.
+
+        if ( _radius <= SSAngle::kHalfPi && contains ( v0 ) && contains ( v1 ) && contains ( v2 ) )
+            return kInside;
+
+        return kPartial;
+    }
+
+    double sinr = sin ( r );
+    for ( int i = 0; i < _planes.size(); i++ )
+        if ( _planes[i].dotProduct ( c ) < -sinr )
+            return kOutside;
+
+    if ( contains ( v0 ) && contains ( v1 ) && contains ( v2 ) )
+        return kInside;
+
+    return kPartial;
+}
+
+// Constructs an empty sky index. The subdivision level will be chosen
+// automatically from the number of objects when the index is built.
+
+SSSkyIndex::SSSkyIndex ( void )
+{
+    _level = -1;
+}
+
+// Constructs an empty sky index with a specific subdivision level,
+// from 0 to kMaxLevel.
+
+SSSkyIndex::SSSkyIndex ( int level )
+{
+    _level = level < 0 ? 0 : level > kMaxLevel ? kMaxLevel : level;
+}
+
+// Removes all objects from the index, and releases their memory.
+
+void SSSkyIndex::clear ( void )
+{
+    vector<SSSkyIndexEntry>().swap ( _entries );
+    vector<int>().swap ( _slots );
+    vector<int>().swap ( _pending );
+}
+
+// Returns the subdivision level which gives a few objects per deepest-level trixel
+// for an index containing the given number of objects.
+
+int SSSkyIndex::levelForCount ( size_t count )
+{
+    int level = 0;
+    double trixels = 8.0;
+
+    while ( level < kMaxLevel && trixels * 4.0 < count )
+    {
+        trixels *= 4.0;
+        level++;
+    }
+
+    return level;
+}
+
+// Returns the ID of the trixel containing a unit vector at the given subdivision level.
+// At level 0, IDs are 8 to 15; each deeper level appends two bits for the child trixel (0-3).
+
+unsigned int SSSkyIndex::trixelID ( SSVector dir, int level )
+{
+    // Find the root trixel which contains the vector. Choosing the trixel whose
+    // least-satisfied edge is most satisfied guarantees a result for any input.
+
+    int root = 0;
+    double best = -HUGE_VAL;
+
+    for ( int i = 0; i < 8; i++ )
+    {
+        SSVector v0 = _octVerts[ _rootVerts[i][0] ];
+        SSVector v1 = _octVerts[ _rootVerts[i][1] ];
+        SSVector v2 = _octVerts[ _rootVerts[i][2] ];
+
+        double d = v0.crossProduct ( v1 ).dotProduct ( dir );
+        d = fmin ( d, v1.crossProduct ( v2 ).dotProduct ( dir ) );
+        d = fmin ( d, v2.crossProduct ( v0 ).dotProduct ( dir ) );
+        if ( d > best )
+        {
+            best = d;
+            root = i;
+        }
+    }
+
+    unsigned int id = 8 + root;
+    SSVector v0, v1, v2;
+    getRootTrixel ( root, v0, v1, v2 );
+
+    // Descend into whichever child trixel contains the vector. The vector is inside
+    // a corner child if it's on the corner's side of the edge joining the midpoints;
+    // otherwise it's inside the central child.
+
+    for ( int l = 0; l < level; l++ )
+    {
+        SSVector w0 = midpoint ( v1, v2 );
+        SSVector w1 = midpoint ( v0, v2 );
+        SSVector w2 = midpoint ( v0, v1 );
+        int child = 3;
+
+        if ( w2.crossProduct ( w1 ).dotProduct ( dir ) >= 0.0 )
+            child = 0;
+        else if ( w0.crossProduct ( w2 ).dotProduct ( dir ) >= 0.0 )
+            child = 1;
+        else if ( w1.crossProduct ( w0 ).dotProduct ( dir ) >= 0.0 )
+            child = 2;
+
+        id = id * 4 + child;
+        getChildTrixel ( child, v0, v1, v2 );
+    }
+
+    return id;
+}
+
+// Adds an entry for the object with the given index and direction to the end of the
+// entry vector, without sorting. Objects with infinite (unknown) directions are ignored.
+
+void SSSkyIndex::insert ( int index, SSVector dir )
+{
+    if ( isinf ( dir.x ) || isinf ( dir.y ) || isinf ( dir.z ) )
+        return;
+
+    SSSkyIndexEntry entry;
+    entry.dir = dir.normalize();
+    entry.trixel = trixelID ( entry.dir, _level );
+    entry.index = index;
+    _entries.push_back ( entry );
+}
+
+// Orders index entries by trixel ID, then object index.
+
+static bool compareEntries ( const SSSkyIndexEntry &e1, const SSSkyIndexEntry &e2 )
+{
+    return e1.trixel == e2.trixel ? e1.index < e2.index : e1.trixel < e2.trixel;
+}
+
+void SSSkyIndex::sortEntries ( void )
+{
+    sort ( _entries.begin(), _entries.end(), compareEntries );
+}
+
+// Rebuilds the table which maps object indices to positions in the entry vector.
+
+void SSSkyIndex::makeSlots ( void )
+{
+    int maxIndex = -1;
+    for ( size_t i = 0; i < _entries.size(); i++ )
+        maxIndex = _entries[i].index > maxIndex ? _entries[i].index : maxIndex;
+
+    _slots.assign ( maxIndex + 1, -1 );
+    for ( size_t i = 0; i < _entries.size(); i++ )
+        _slots[ _entries[i].index ] = (int) i;
+}
+
+// Builds the index from a vector of directions. Each direction's index in the vector
+// becomes its object index. Infinite directions are not indexed.
+
+void SSSkyIndex::build ( vector<SSVector> &dirs )
+{
+    clear();
+    if ( _level < 0 )
+        _level = levelForCount ( dirs.size() );
+
+    _entries.reserve ( dirs.size() );
+    for ( int i = 0; i < dirs.size(); i++ )
+        insert ( i, dirs[i] );
+
+    sortEntries();
+    makeSlots();
+}
+
+// Returns the direction used to index an object: its apparent direction from the last
+// call to computeEphemeris(), or for stars whose ephemeris has not been computed,
+// its fundamental J2000 position.
+
+static SSVector objectDirection ( SSObject *pObj )
+{
+    SSVector dir = pObj->getDirection();
+    if ( isinf ( dir.x ) )
+    {
+        SSStar *pStar = dynamic_cast<SSStar *> ( pObj );
+        if ( pStar != nullptr )
+            dir = pStar->getFundamentalPosition();
+    }
+
+    return dir;
+}
+
+// Builds the index from a vector of objects. Each object's index in the vector
+// becomes its object index. Objects with unknown directions are not indexed.
+
+void SSSkyIndex::build ( SSObjectVec &objects )
+{
+    vector<SSVector> dirs ( objects.size() );
+
+    for ( int i = 0; i < objects.size(); i++ )
+        dirs[i] = objectDirection ( objects[i].get() );
+
+    build ( dirs );
+}
+
+// Builds the index from a star store, using the stars' apparent directions if
+// computed, or their fundamental J2000 positions otherwise.
+
+void SSSkyIndex::build ( SSStarStore &store )
+{
+    vector<SSVector> dirs ( store.size() );
+
+    for ( size_t i = 0; i < store.size(); i++ )
+    {
+        dirs[i] = store.getDirection ( i );
+        if ( isinf ( dirs[i].x ) )
+            dirs[i] = store.getFundamentalPosition ( i );
+    }
+
+    build ( dirs );
+}
+
+// Changes the direction of an indexed object, for example after its proper motion has
+// been applied. If the object has moved into a different trixel, or is not yet indexed,
+// it is queued, and this function returns true; call commit() to re-sort queued objects
+// into the index before searching it again. An infinite direction removes the object
+// from the index when committed.
+
+bool SSSkyIndex::update ( int index, SSVector dir )
+{
+    if ( index < 0 )
+        return false;
+
+    // An index which has never been built has no subdivision level yet;
+    // use one suited to a large star catalog.
+
+    if ( _level < 0 )
+        _level = levelForCount ( kDefaultCount );
+
+    bool known = ! ( isinf ( dir.x ) || isinf ( dir.y ) || isinf ( dir.z ) );
+    if ( known )
+        dir = dir.normalize();
+
+    int slot = index < _slots.size() ? _slots[index] : -1;
+    if ( slot < 0 )
+    {
+        if ( ! known )
+            return false;
+
+        if ( index >= _slots.size() )
+            _slots.resize ( index + 1, -1 );
+
+        _slots[index] = (int) _entries.size();
+        insert ( index, dir );
+        _pending.push_back ( index );
+        return true;
+    }
+
+    SSSkyIndexEntry &entry = _entries[slot];
+    entry.dir = dir;
+
+    unsigned int trixel = known ? trixelID ( dir, _level ) : entry.trixel;
+    if ( known && trixel == entry.trixel )
+        return false;
+
+    entry.trixel = trixel;
+    _pending.push_back ( index );
+    return true;
+}
+
+// Updates the directions of all objects in a vector from which this index was built,
+// then commits the changes. Only objects which have moved into different trixels are
+// re-sorted. Returns the number of objects whose trixels changed.
+
+int SSSkyIndex::update ( SSObjectVec &objects )
+{
+    for ( int i = 0; i < objects.size(); i++ )
+        update ( i, objectDirection ( objects[i].get() ) );
+
+    return commit();
+}
+
+// As above, but for a star store from which this index was built.
+
+int SSSkyIndex::update ( SSStarStore &store )
+{
+    for ( size_t i = 0; i < store.size(); i++ )
+    {
+        SSVector dir = store.getDirection ( i );
+        if ( isinf ( dir.x ) )
+            dir = store.getFundamentalPosition ( i );
+
+        update ( (int) i, dir );
+    }
+
+    return commit();
+}
+
+// Moves objects queued by update() into their new positions in the index.
+// Unmoved entries stay in order, so this costs one merge pass over the index
+// plus sorting only the moved objects. Returns the number of objects moved.
+
+int SSSkyIndex::commit ( void )
+{
+    if ( _pending.size() == 0 )
+        return 0;
+
+    vector<bool> moved ( _slots.size(), false );
+    for ( int i = 0; i < _pending.size(); i++ )
+        moved[ _pending[i] ] = true;
+
+    vector<SSSkyIndexEntry> kept, movers;
+    kept.reserve ( _entries.size() );
+    for ( size_t i = 0; i < _entries.size(); i++ )
+    {
+        if ( ! moved[ _entries[i].index ] )
+            kept.push_back ( _entries[i] );
+        else if ( ! isinf ( _entries[i].dir.x ) )
+            movers.push_back ( _entries[i] );
+    }
+
+    sort ( movers.begin(), movers.end(), compareEntries );
+
+    _entries.resize ( kept.size() + movers.size() );
+    merge ( kept.begin(), kept.end(), movers.begin(), movers.end(), _entries.begin(), compareEntries );
+    makeSlots();
+
+    int n = (int) _pending.size();
+    vector<int>().swap ( _pending );
+    return n;
+}
+
+// Finds the range of entries [start, end) which lie inside the trixel with the given ID
+// at the given level, by binary search.
+
+void SSSkyIndex::getTrixelEntries ( unsigned int id, int level, size_t &start, size_t &end )
+{
+    int shift = 2 * ( _level - level );
+    unsigned long long lo = (unsigned long long) id << shift;
+    unsigned long long hi = (unsigned long long) ( id + 1 ) << shift;
+
+    vector<SSSkyIndexEntry>::iterator first = lower_bound ( _entries.begin(), _entries.end(), lo,
+                                              [] ( const SSSkyIndexEntry &e, unsigned long long t ) { return e.trixel < t; } );
+    vector<SSSkyIndexEntry>::iterator last = lower_bound ( first, _entries.end(), hi,
+                                             [] ( const SSSkyIndexEntry &e, unsigned long long t ) { return e.trixel < t; } );
+
+    start = first - _entries.begin();
+    end = last - _entries.begin();
+}
+
+// Recursively searches the trixel with the given ID, level, and vertices for objects
+// inside a region, and appends their indices to the results vector. Empty trixels and
+// trixels outside the region are skipped; trixels completely inside the region are
+// copied without testing individual objects.
+
+void SSSkyIndex::searchTrixel ( unsigned int id, int level, SSVector v0, SSVector v1, SSVector v2, SSSkyRegion &region, vector<int> &results )
+{
+    SSSkyRegion::Overlap overlap = region.overlap ( v0, v1, v2 );
+    if ( overlap == SSSkyRegion::kOutside )
+        return;
+
+    size_t start = 0, end = 0;
+    getTrixelEntries ( id, level, start, end );
+    if ( start == end )
+        return;
+
+    if ( overlap == SSSkyRegion::kInside )
+    {
+        for ( size_t i = start; i < end; i++ )
+            results.push_back ( _entries[i].index );
+    }
+    else if ( level == _level || end - start <= 8 )
+    {
+        for ( size_t i = start; i < end; i++ )
+            if ( region.contains ( _entries[i].dir ) )
+                results.push_back ( _entries[i].index );
+    }
+    else
+    {
+        for ( int child = 0; child < 4; child++ )
+        {
+            SSVector c0 = v0, c1 = v1, c2 = v2;
+            getChildTrixel ( child, c0, c1, c2 );
+            searchTrixel ( id * 4 + child, level + 1, c0, c1, c2, region, results );
+        }
+    }
+}
+
+// Finds all indexed objects inside a region, and appends their indices to the results vector,
+// in order of trixel ID. Pending updates should be committed before searching.
+// Returns the number of objects found.
+
+int SSSkyIndex::regionSearch ( SSSkyRegion &region, vector<int> &results )
+{
+    size_t n = results.size();
+
+    if ( _level < 0 )
+        return 0;
+
+    for ( int i = 0; i < 8; i++ )
+    {
+        SSVector v0, v1, v2;
+        getRootTrixel ( i, v0, v1, v2 );
+        searchTrixel ( 8 + i, 0, v0, v1, v2, region, results );
+    }
+
+    return (int) ( results.size() - n );
+}
+
+// Finds all indexed objects within an angular radius (in radians) of a center unit vector,
+// and appends their indices to the results vector. Returns the number of objects found.
+
+int SSSkyIndex::coneSearch ( SSVector center, double radius, vector<int> &results )
+{
+    SSSkyRegion region ( center, radius );
+    return regionSearch ( region, results );
+}
+
+// Finds all indexed objects inside a convex polygon, for example a field of view,
+// and appends their indices to the results vector. Returns the number of objects found.
+
+int SSSkyIndex::polygonSearch ( vector<SSVector> &vertices, vector<int> &results )
+{
+    SSSkyRegion region ( vertices );
+    return regionSearch ( region, results );
+}
+
+// Finds the k indexed objects nearest to a unit vector, and appends their indices to the
+// results vector in order of increasing distance. The search radius starts at about the
+// size of a deepest-level trixel, and doubles until at least k objects are found; since
+// every object nearer than the k-th one lies inside that radius, the result is exact.
+// Returns the number of objects found, which is less than k only if the index contains
+// fewer than k objects.
+
+int SSSkyIndex::nearest ( SSVector dir, int k, vector<int> &results )
+{
+    if ( k < 1 || _entries.size() == 0 )
+        return 0;
+
+    size_t want = k < _entries.size() ? k : _entries.size();
+    double radius = SSAngle::kHalfPi / ( 1 << _level );
+    vector<int> found;
+
+    dir = dir.normalize();
+    while ( true )
+    {
+        found.clear();
+        coneSearch ( dir, radius, found );
+        if ( found.size() >= want || radius >= SSAngle::kPi )
+            break;
+
+        radius = radius * 2.0 > SSAngle::kPi ? SSAngle::kPi : radius * 2.0;
+    }
+
+    vector<pair<double,int>> sorted ( found.size() );
+    for ( size_t i = 0; i < found.size(); i++ )
+        sorted[i] = pair<double,int> ( -dir.dotProduct ( _entries[ _slots[ found[i] ] ].dir ), found[i] );
+
+    if ( want > sorted.size() )
+        want = sorted.size();
+
+    partial_sort ( sorted.begin(), sorted.begin() + want, sorted.end() );
+    for ( size_t i = 0; i < want; i++ )
+        results.push_back ( sorted[i].second );
+
+    return (int) want;
+}
+
+// Returns the index of the indexed object nearest to a unit vector,
+// or -1 if the index is empty.
+
+int SSSkyIndex::nearest ( SSVector dir )
+{
+    vector<int> results;
+    return nearest ( dir, 1, results ) > 0 ? results[0] : -1;
+}
@@ -0,0 +1,112 @@
+// SSSkyIndex.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/16/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Spatial index of objects on the celestial sphere, using the Hierarchical Triangular Mesh (HTM).
+// The sky is divided into 8 spherical triangles (the faces of an octahedron), and each triangle
+// ("trixel") is recursively divided into 4 smaller ones. Objects are stored sorted by the ID of
+// the trixel which contains them at the deepest level, so every trixel at every level corresponds
+// to one contiguous range of the index. Cone, polygon, and nearest-neighbor searches then cost
+// O ( log n + k ) rather than a scan of the whole catalog. For a description of the HTM, see
+// https://arxiv.org/abs/cs/0701164
+
+#ifndef SSSkyIndex_hpp
+#define SSSkyIndex_hpp
+
+#include <vector>
+
+#include "SSObject.hpp"
+
+class SSStarStore;
+
+// One indexed object: its direction on the sky, the ID of the deepest-level
+// trixel containing that direction, and the object's index in its catalog.
+
+struct SSSkyIndexEntry
+{
+    SSVector        dir;        // unit vector toward object in fundamental frame
+    unsigned int    trixel;     // ID of trixel containing this object at index's deepest level
+    int             index;      // index of object in catalog vector or star store
+};
+
+// A region of the celestial sphere that can be searched with an SSSkyIndex:
+// either a circular cone, or a convex spherical polygon, represented as the
+// intersection of hemispheres bounded by great circles.
+
+class SSSkyRegion
+{
+protected:
+
+    vector<SSVector> _planes;       // unit normals of bounding great circles of polygon; the region is where dot product with all normals >= 0.
+    SSVector _center;               // cone axis unit vector; infinite for polygons
+    double _radius;                 // cone angular radius in radians
+    double _cosRadius;              // cosine of cone angular radius
+
+public:
+
+    enum Overlap
+    {
+        kOutside = 0,               // trixel lies completely outside region
+        kPartial = 1,               // trixel may lie partially inside region
+        kInside = 2,                // trixel lies completely inside region
+    };
+
+    SSSkyRegion ( SSVector center, double radius );
+    SSSkyRegion ( vector<SSVector> &vertices );
+
+    bool isCone ( void ) { return _planes.size() == 0; }
+    bool contains ( SSVector dir );
+    Overlap overlap ( SSVector v0, SSVector v1, SSVector v2 );
+};
+
+class SSSkyIndex
+{
+protected:
+
+    int _level;                             // depth of trixel subdivision; 0 = the 8 root trixels only
+    vector<SSSkyIndexEntry> _entries;       // index entries, sorted by trixel ID then object index
+    vector<int> _slots;                     // position of each object's entry in _entries, or -1 if object is not indexed
+    vector<int> _pending;                   // objects whose trixel has changed since last call to commit()
+
+    void insert ( int index, SSVector dir );
+    void sortEntries ( void );
+    void makeSlots ( void );
+    void searchTrixel ( unsigned int id, int level, SSVector v0, SSVector v1, SSVector v2, SSSkyRegion &region, vector<int> &results );
+    void getTrixelEntries ( unsigned int id, int level, size_t &start, size_t &end );
+
+public:
+
+    static constexpr int kMaxLevel = 14;    // deepest supported level; trixel IDs at this level use 32 bits
+    static constexpr int kDefaultCount = 100000;    // object count used to choose a level when objects are added without build()
+
+    SSSkyIndex ( void );
+    SSSkyIndex ( int level );
+
+    int getLevel ( void ) { return _level; }
+    size_t size ( void ) { return _entries.size(); }
+    void clear ( void );
+
+    static int levelForCount ( size_t count );
+    static unsigned int trixelID ( SSVector dir, int level );
+    static void getRootTrixel ( int root, SSVector &v0, SSVector &v1, SSVector &v2 );
+    static void getChildTrixel ( int child, SSVector &v0, SSVector &v1, SSVector &v2 );
+
+    void build ( vector<SSVector> &dirs );
+    void build ( SSObjectVec &objects );
+    void build ( SSStarStore &store );
+
+    bool update ( int index, SSVector dir );
+    int update ( SSObjectVec &objects );
+    int update ( SSStarStore &store );
+    int commit ( void );
+
+    int coneSearch ( SSVector center, double radius, vector<int> &results );
+    int polygonSearch ( vector<SSVector> &vertices, vector<int> &results );
+    int regionSearch ( SSSkyRegion &region, vector<int> &results );
+    int nearest ( SSVector dir, int k, vector<int> &results );
+    int nearest ( SSVector dir );
+};
+
+#endif /* SSSkyIndex_hpp */
@@ -0,0 +1,361 @@
+// SSSkyTiles.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/18/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "SSSkyTiles.hpp"
+#include "SSStar.hpp"
+
+// Tile file header: magic number, format version, and a tag written in native byte order,
+// so a file written on a machine with different endianness is detected and rejected.
+// The header is followed by a directory with one record per tile, then the tiles' entries.
+
+static const char kTileFileMagic[4] = { 'S', 'S', 'T', 'L' };
+static const int kTileFileVersion = 1;
+static const int kTileFileEndian = 0x01020304;
+
+struct SSSkyTileRecord
+{
+    int         count;          // number of entries in tile
+    float       brightest;      // magnitude of brightest entry; infinite if empty
+    long long   offset;         // file offset of tile's first entry, in bytes
+};
+
+// Seeks to a 64-bit offset in a file, and returns the current 64-bit offset in a file,
+// so tile files larger than 2 GB work where long is 32 bits (as on Windows).
+
+static int fseek64 ( FILE *file, int64_t offset, int origin )
+{
+#ifdef _WIN32
+    return _fseeki64 ( file, offset, origin );
+#else
+    return fseeko ( file, (off_t) offset, origin );
+#endif
+}
+
+static int64_t ftell64 ( FILE *file )
+{
+#ifdef _WIN32
+    return _ftelli64 ( file );
+#else
+    return (int64_t) ftello ( file );
+#endif
+}
+
+// Constructs an empty set of sky tiles at level 3 (512 tiles, each about 9 degrees across).
+
+SSSkyTiles::SSSkyTiles ( void ) : SSSkyTiles ( 3 )
+{
+
+}
+
+// Constructs an empty set of sky tiles at the specified HTM level, from 0 to kMaxLevel.
+
+SSSkyTiles::SSSkyTiles ( int level )
+{
+    _level = level < 0 ? 0 : level > kMaxLevel ? kMaxLevel : level;
+    _file = nullptr;
+}
+
+// Destructor closes the tile file, if one is open.
+
+SSSkyTiles::~SSSkyTiles ( void )
+{
+    close();
+}
+
+// Releases all tiles and closes the tile file, if one is open.
+
+void SSSkyTiles::clear ( void )
+{
+    close();
+    vector<SSSkyTile>().swap ( _tiles );
+}
+
+// Closes the tile file, if open. Tiles which were not paged in become empty.
+
+void SSSkyTiles::close ( void )
+{
+    if ( _file != nullptr )
+        fclose ( _file );
+
+    _file = nullptr;
+}
+
+// Returns the index of the tile containing a unit vector.
+
+int SSSkyTiles::tileIndex ( SSVector dir )
+{
+    return SSSkyIndex::trixelID ( dir, _level ) - ( 8u << ( 2 * _level ) );
+}
+
+// Orders tile entries by magnitude, then object index, so tiles are deterministic.
+
+static bool compareTileEntries ( const SSSkyTileEntry &e1, const SSSkyTileEntry &e2 )
+{
+    return e1.mag == e2.mag ? e1.index < e2.index : e1.mag < e2.mag;
+}
+
+// Builds sky tiles from a vector of objects. Only stars and deep sky objects are added.
+// Each object's direction is its apparent direction if its ephemeris has been computed,
+// otherwise its fundamental J2000 position; likewise its magnitude is its apparent magnitude
+// if computed, otherwise its V magnitude, or a variable star's minimum magnitude if brighter.
+// Returns the number of objects added to tiles.
+
+int SSSkyTiles::build ( SSObjectVec &objects )
+{
+    int n = 0;
+
+    clear();
+    _tiles.resize ( 8 << ( 2 * _level ) );
+    for ( int i = 0; i < _tiles.size(); i++ )
+    {
+        _tiles[i].id = ( 8u << ( 2 * _level ) ) + i;
+        _tiles[i].loaded = true;
+        _tiles[i].count = 0;
+        _tiles[i].brightest = HUGE_VAL;
+        _tiles[i].offset = 0;
+    }
+
+    for ( int i = 0; i < objects.size(); i++ )
+    {
+        SSStar *pStar = dynamic_cast<SSStar *> ( objects[i].get() );
+        if ( pStar == nullptr )
+            continue;
+
+        SSVector dir = pStar->getDirection();
+        if ( isinf ( dir.x ) )
+            dir = pStar->getFundamentalPosition();
+        if ( isinf ( dir.x ) )
+            continue;
+
+        float mag = pStar->getMagnitude();
+        if ( isinf ( mag ) )
+            mag = pStar->getVMagnitude();
+
+        // File variable stars by their magnitude when brightest, so they are found whenever they may be
+        // brighter than a limiting magnitude, whatever phase they are at when the tiles are queried.
+
+        SSVariableStar *pVar = dynamic_cast<SSVariableStar *> ( pStar );
+        if ( pVar != nullptr && pVar->getMinimumMagnitude() < mag )
+            mag = pVar->getMinimumMagnitude();
+
+        dir = dir.normalize();
+        SSSkyTileEntry entry = { mag, i, (float) dir.x, (float) dir.y, (float) dir.z };
+        _tiles[ tileIndex ( dir ) ].entries.push_back ( entry );
+        n++;
+    }
+
+    for ( int i = 0; i < _tiles.size(); i++ )
+    {
+        SSSkyTile &tile = _tiles[i];
+        sort ( tile.entries.begin(), tile.entries.end(), compareTileEntries );
+        tile.count = (int) tile.entries.size();
+        if ( tile.count > 0 )
+            tile.brightest = tile.entries[0].mag;
+    }
+
+    return n;
+}
+
+// Recursively finds the tiles inside or overlapping a view region, descending from the trixel
+// with the given ID, level, and vertices, down to the tile level. For each such tile with objects
+// brighter than the limiting magnitude, appends the span of those objects to the spans vector.
+// Tiles whose brightest object is fainter than the limit are skipped without being paged in.
+
+void SSSkyTiles::searchTile ( unsigned int id, int level, SSVector v0, SSVector v1, SSVector v2, SSSkyRegion &view, float limMag, vector<SSSkyTileSpan> &spans )
+{
+    if ( view.overlap ( v0, v1, v2 ) == SSSkyRegion::kOutside )
+        return;
+
+    if ( level < _level )
+    {
+        for ( int child = 0; child < 4; child++ )
+        {
+            SSVector c0 = v0, c1 = v1, c2 = v2;
+            SSSkyIndex::getChildTrixel ( child, c0, c1, c2 );
+            searchTile ( id * 4 + child, level + 1, c0, c1, c2, view, limMag, spans );
+        }
+
+        return;
+    }
+
+    int i = id - ( 8u << ( 2 * _level ) );
+    SSSkyTile &tile = _tiles[i];
+    if ( tile.count == 0 || tile.brightest > limMag || ! loadTile ( i ) )
+        return;
+
+    SSSkyTileEntry limit = { limMag, INT_MAX, 0.0, 0.0, 0.0 };
+    vector<SSSkyTileEntry>::iterator end = upper_bound ( tile.entries.begin(), tile.entries.end(), limit, compareTileEntries );
+
+    SSSkyTileSpan span = { i, tile.entries.data(), (int) ( end - tile.entries.begin() ) };
+    if ( span.count > 0 )
+        spans.push_back ( span );
+}
+
+// Finds the tiles visible in a view region, and for each, appends the span of objects
+// as bright or brighter than the limiting magnitude to the spans vector. Tiles are paged
+// in from the tile file as needed. Span entry pointers remain valid until the tile is
+// unloaded. Returns the total number of objects in all spans found.
+
+int SSSkyTiles::query ( SSSkyRegion &view, float limMag, vector<SSSkyTileSpan> &spans )
+{
+    size_t first = spans.size();
+    int n = 0;
+
+    if ( _tiles.size() == 0 )
+        return 0;
+
+    for ( int i = 0; i < 8; i++ )
+    {
+        SSVector v0, v1, v2;
+        SSSkyIndex::getRootTrixel ( i, v0, v1, v2 );
+        searchTile ( 8 + i, 0, v0, v1, v2, view, limMag, spans );
+    }
+
+    for ( size_t i = first; i < spans.size(); i++ )
+        n += spans[i].count;
+
+    return n;
+}
+
+// As above, for a circular view with the given center unit vector and angular radius in radians.
+
+int SSSkyTiles::query ( SSVector center, double radius, float limMag, vector<SSSkyTileSpan> &spans )
+{
+    SSSkyRegion view ( center, radius );
+    return query ( view, limMag, spans );
+}
+
+// Writes all tiles to a binary tile file, which can later be opened for paging.
+// Tiles which are not in memory are paged in first. Returns true if successful.
+
+bool SSSkyTiles::write ( const string &filename )
+{
+    for ( int i = 0; i < _tiles.size(); i++ )
+        if ( ! loadTile ( i ) )
+            return false;
+
+    FILE *file = fopen ( filename.c_str(), "wb" );
+    if ( file == nullptr )
+        return false;
+
+    int header[4] = { kTileFileVersion, kTileFileEndian, _level, (int) _tiles.size() };
+    bool ok = fwrite ( kTileFileMagic, sizeof ( kTileFileMagic ), 1, file ) == 1;
+    ok = ok && fwrite ( header, sizeof ( header ), 1, file ) == 1;
+
+    long long offset = sizeof ( kTileFileMagic ) + sizeof ( header ) + _tiles.size() * sizeof ( SSSkyTileRecord );
+    for ( int i = 0; ok && i < _tiles.size(); i++ )
+    {
+        SSSkyTileRecord record = { _tiles[i].count, _tiles[i].brightest, offset };
+        ok = fwrite ( &record, sizeof ( record ), 1, file ) == 1;
+        offset += _tiles[i].count * sizeof ( SSSkyTileEntry );
+    }
+
+    for ( int i = 0; ok && i < _tiles.size(); i++ )
+        if ( _tiles[i].count > 0 )
+            ok = fwrite ( _tiles[i].entries.data(), sizeof ( SSSkyTileEntry ), _tiles[i].count, file ) == _tiles[i].count;
+
+    ok = fclose ( file ) == 0 && ok;
+    return ok;
+}
+
+// Opens a binary tile file for paging. Only the tile directory is read; tiles' objects
+// are paged in by query() or loadTile() when needed. The file stays open until close()
+// or clear() is called, or another file is opened. Files whose tile directory has a negative
+// count, or entries outside the file, are rejected. Returns true if successful.
+
+bool SSSkyTiles::open ( const string &filename )
+{
+    clear();
+
+    FILE *file = fopen ( filename.c_str(), "rb" );
+    if ( file == nullptr )
+        return false;
+
+    char magic[4] = { 0 };
+    int header[4] = { 0 };
+    bool ok = fread ( magic, sizeof ( magic ), 1, file ) == 1 && memcmp ( magic, kTileFileMagic, sizeof ( magic ) ) == 0;
+    ok = ok && fread ( header, sizeof ( header ), 1, file ) == 1;
+    ok = ok && header[0] == kTileFileVersion && header[1] == kTileFileEndian;
+    ok = ok && header[2] >= 0 && header[2] <= kMaxLevel && header[3] == ( 8 << ( 2 * header[2] ) );
+
+    if ( ok )
+    {
+        _level = header[2];
+        _tiles.resize ( header[3] );
+    }
+
+    // Find the file size, then return to the tile directory.
+    // Every tile's entries must lie after the directory and inside the file.
+
+    int64_t directory = ftell64 ( file );
+    int64_t start = directory + (int64_t) _tiles.size() * sizeof ( SSSkyTileRecord );
+    int64_t size = fseek64 ( file, 0, SEEK_END ) == 0 ? ftell64 ( file ) : -1;
+    ok = ok && size >= start && fseek64 ( file, directory, SEEK_SET ) == 0;
+
+    for ( int i = 0; ok && i < _tiles.size(); i++ )
+    {
+        SSSkyTileRecord record;
+        ok = fread ( &record, sizeof ( record ), 1, file ) == 1;
+        ok = ok && record.count >= 0 && record.offset >= start && record.offset <= size;
+        ok = ok && (uint64_t) record.count <= (uint64_t) ( size - record.offset ) / sizeof ( SSSkyTileEntry );
+        _tiles[i].id = ( 8u << ( 2 * _level ) ) + i;
+        _tiles[i].loaded = false;
+        _tiles[i].count = record.count;
+        _tiles[i].brightest = record.brightest;
+        _tiles[i].offset = record.offset;
+    }
+
+    if ( ! ok )
+    {
+        fclose ( file );
+        vector<SSSkyTile>().swap ( _tiles );
+        return false;
+    }
+
+    _file = file;
+    return true;
+}
+
+// Pages in the i-th tile's objects from the tile file, if not already in memory.
+// Returns true if the tile's objects are in memory.
+
+bool SSSkyTiles::loadTile ( int i )
+{
+    SSSkyTile &tile = _tiles[i];
+    if ( tile.loaded )
+        return true;
+
+    if ( _file == nullptr || fseek64 ( _file, tile.offset, SEEK_SET ) != 0 )
+        return false;
+
+    tile.entries.resize ( tile.count );
+    if ( tile.count > 0 && fread ( tile.entries.data(), sizeof ( SSSkyTileEntry ), tile.count, _file ) != tile.count )
+    {
+        vector<SSSkyTileEntry>().swap ( tile.entries );
+        return false;
+    }
+
+    tile.loaded = true;
+    return true;
+}
+
+// Releases the memory used by the i-th tile's objects, if they can be paged in again
+// from the tile file. Invalidates any spans which point into this tile.
+
+void SSSkyTiles::unloadTile ( int i )
+{
+    if ( _file == nullptr )
+        return;
+
+    vector<SSSkyTileEntry>().swap ( _tiles[i].entries );
+    _tiles[i].loaded = false;
+}
@@ -0,0 +1,95 @@
+// SSSkyTiles.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/18/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Level-of-detail sky tiles for rendering stars and deep sky objects.
+// The sky is divided into HTM trixels at a fixed level (see SSSkyIndex),
+// and each tile holds the objects inside it sorted from brightest to faintest.
+// Drawing everything brighter than a limiting magnitude then means drawing
+// a prefix of each visible tile, instead of filtering the entire catalog.
+// Tiles can be written to a binary file and paged back in from disk on demand.
+
+#ifndef SSSkyTiles_hpp
+#define SSSkyTiles_hpp
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "SSSkyIndex.hpp"
+
+// One object in a sky tile: magnitude, index of object in its catalog vector,
+// and direction as a single-precision unit vector, which is plenty for drawing.
+
+struct SSSkyTileEntry
+{
+    float   mag;            // visual magnitude, or magnitude when brightest for variable stars; infinite if unknown
+    int     index;          // index of object in catalog vector
+    float   x, y, z;        // unit vector toward object in fundamental frame
+};
+
+// A sky tile's objects, sorted from brightest to faintest.
+// If the tile was read from a file directory but its objects
+// have not been paged in yet, loaded is false.
+
+struct SSSkyTile
+{
+    unsigned int id;                    // HTM trixel ID of this tile
+    bool loaded;                        // true if entries are in memory
+    int count;                          // number of objects in tile, even if not loaded
+    float brightest;                    // magnitude of brightest object in tile; infinite if empty
+    int64_t offset;                     // offset of tile's entries in tile file, in bytes
+    vector<SSSkyTileEntry> entries;     // tile's objects, sorted by increasing magnitude
+};
+
+// The part of a visible tile which is brighter than a limiting magnitude.
+
+struct SSSkyTileSpan
+{
+    int tile;                           // index of tile in SSSkyTiles
+    const SSSkyTileEntry *entries;      // pointer to first (brightest) entry in tile
+    int count;                          // number of entries brighter than limiting magnitude
+};
+
+class SSSkyTiles
+{
+protected:
+
+    int _level;                 // HTM level of tiles; there are 8 * 4 ^ _level tiles
+    vector<SSSkyTile> _tiles;   // tiles, in order of trixel ID
+    FILE *_file;                // tile file from which tiles are paged in; null if none
+
+    void searchTile ( unsigned int id, int level, SSVector v0, SSVector v1, SSVector v2, SSSkyRegion &view, float limMag, vector<SSSkyTileSpan> &spans );
+
+public:
+
+    static constexpr int kMaxLevel = 8;     // deepest supported tile level (524288 tiles)
+
+    SSSkyTiles ( void );
+    SSSkyTiles ( int level );
+    ~SSSkyTiles ( void );
+
+    SSSkyTiles ( const SSSkyTiles & ) = delete;              // not copyable, since tiles own their tile file
+    SSSkyTiles &operator = ( const SSSkyTiles & ) = delete;
+
+    int getLevel ( void ) { return _level; }
+    int getTileCount ( void ) { return (int) _tiles.size(); }
+    SSSkyTile &getTile ( int i ) { return _tiles[i]; }
+    int tileIndex ( SSVector dir );
+    void clear ( void );
+
+    int build ( SSObjectVec &objects );
+
+    int query ( SSSkyRegion &view, float limMag, vector<SSSkyTileSpan> &spans );
+    int query ( SSVector center, double radius, float limMag, vector<SSSkyTileSpan> &spans );
+
+    bool write ( const string &filename );
+    bool open ( const string &filename );
+    void close ( void );
+    bool loadTile ( int i );
+    void unloadTile ( int i );
+};
+
+#endif /* SSSkyTiles_hpp */
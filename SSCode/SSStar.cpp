@@ -16,7 +16,7 @@
 
 SSStar::SSStar ( SSObjectType type ) : SSObject ( type )
 {
-    _names = vector<string> ( 0 );
+    _names = vector<SSInternedString> ( 0 );
     _idents = vector<SSIdentifier> ( 0 );
 
     _parallax = 0.0;
@@ -25,7 +25,7 @@ SSStar::SSStar ( SSObjectType type ) : SSObject ( type )
     _Vmag = HUGE_VAL;
     _Bmag = HUGE_VAL;
     
-    _spectrum = "";
+    _spectrum = SSInternedString();
 }
 
 // Constructs single star with type code set to indicate "single star".
@@ -41,7 +41,8 @@ SSStar::SSStar ( void ) : SSStar ( kTypeStar )
 
 SSVariableStar::SSVariableStar ( void ) : SSStar ( kTypeVariableStar )
 {
-    _varType = "";
+    _varType = SSInternedString();
+    _lightCurve = kLightCurveNone;
     _varMaxMag = HUGE_VAL;
     _varMinMag = HUGE_VAL;
     _varPeriod = HUGE_VAL;
@@ -58,6 +59,8 @@ SSDoubleStar::SSDoubleStar ( void ) : SSStar ( kTypeDoubleStar )
     _sep = HUGE_VAL;
     _PA = HUGE_VAL;
     _PAyr = HUGE_VAL;
+    _orbitSep = HUGE_VAL;
+    _orbitPA = HUGE_VAL;
 }
 
 // Constructs double variable star with all fields except type code
@@ -184,9 +187,9 @@ SSSpherical SSStar::getFundamentalMotion ( void )
     return motion;
 }
 
-// Returns CSV string from base data (excluding names and identifiers).
+// Appends CSV string from base data (excluding names and identifiers).
 
-string SSStar::toCSV1 ( void )
+void SSStar::appendCSV1 ( string &csv )
 {
     SSSpherical coords = getFundamentalCoords();
     SSSpherical motion = getFundamentalMotion();
@@ -195,128 +198,357 @@ string SSStar::toCSV1 ( void )
     SSDegMinSec dec = coords.lat;
     double distance = coords.rad;
     
-    string csv = SSObject::typeToCode ( _type ) + ",";
+    csv += SSObject::typeToCode ( _type );
+    csv += ',';
     
-    csv += ra.toString() + ",";
-    csv += dec.toString() + ",";
+    ra.appendString ( csv );
+    csv += ',';
+    dec.appendString ( csv );
+    csv += ',';
     
-    csv += isnan ( motion.lon ) ? "," : format ( "%+.5f,", ( motion.lon / 15.0 ).toArcsec() );
-    csv += isnan ( motion.lat ) ? "," : format ( "%+.4f,", motion.lat.toArcsec() );
+    if ( ! isnan ( motion.lon ) )
+        appendfixed ( csv, ( motion.lon / 15.0 ).toArcsec(), 5, 0, true );
+    csv += ',';
+
+    if ( ! isnan ( motion.lat ) )
+        appendfixed ( csv, motion.lat.toArcsec(), 4, 0, true );
+    csv += ',';
     
-    csv += isinf ( _Vmag ) ? "," : format ( "%+.2f,", _Vmag );
-    csv += isinf ( _Bmag ) ? "," : format ( "%+.2f,", _Bmag );
+    appendCSVField ( csv, _Vmag, 2, true );
+    appendCSVField ( csv, _Bmag, 2, true );
     
-    csv += isinf ( distance ) ? "," : format ( "%.3E,", distance * SSDynamics::kParsecPerLY );
-    csv += isinf ( _radvel ) ? "," : format ( "%+.1f,", _radvel * SSDynamics::kLightKmPerSec );
+    if ( ! isinf ( distance ) )
+        appendexp ( csv, distance * SSDynamics::kParsecPerLY, 3 );
+    csv += ',';
+
+    appendCSVField ( csv, _radvel * SSDynamics::kLightKmPerSec, 1, true );
     
     // If spectrum contains a comma, put it in quotes.
     
-    csv += _spectrum.find ( "," ) == string::npos ? _spectrum + "," : "\"" + _spectrum + "\",";
+    const string &spectrum = _spectrum.str();
+    if ( spectrum.find ( ',' ) == string::npos )
+    {
+        csv += spectrum;
+    }
+    else
+    {
+        csv += '"';
+        csv += spectrum;
+        csv += '"';
+    }
+
+    csv += ',';
+}
+
+// Appends CSV string from identifiers and names (excluding base data).
+
+void SSStar::appendCSV2 ( string &csv )
+{
+    SSAppendIdentifiers ( csv, _idents, ',' );
     
-    return csv;
+    for ( const SSInternedString &name : _names )
+    {
+        csv += name.str();
+        csv += ',';
+    }
+}
+
+// Appends CSV string including base star data plus names and identifiers.
+
+void SSStar::appendCSV ( string &csv )
+{
+    appendCSV1 ( csv );
+    appendCSV2 ( csv );
+}
+
+// Appends CSV string from double-star data (but not SStar base class).
+
+void SSDoubleStar::appendCSVD ( string &csv )
+{
+    csv += _comps;
+    csv += ',';
+
+    appendCSVField ( csv, _magDelta, 2, true );
+    appendCSVField ( csv, _sep * SSAngle::kArcsecPerRad, 1 );
+    appendCSVField ( csv, _PA * SSAngle::kDegPerRad, 1 );
+    appendCSVField ( csv, _PAyr, 2 );
+}
+
+// Appends CSV string including base star data, double-star data,
+// plus names and identifiers. Overrides SSStar::appendCSV().
+
+void SSDoubleStar::appendCSV ( string &csv )
+{
+    appendCSV1 ( csv );
+    appendCSVD ( csv );
+    appendCSV2 ( csv );
 }
 
-// Returns CSV string from identifiers and names (excluding base data).
+// Returns the light curve template for a GCVS variability type code string (varType),
+// ignoring any uncertainty flags or secondary types after the main type.
+// Returns kLightCurveNone for irregular, eruptive, and unrecognized types.
 
-string SSStar::toCSV2 ( void )
+SSLightCurve SSVariableStar::typeToLightCurve ( const string &varType )
 {
-    string csv = "";
+    string type = varType.substr ( 0, varType.find_first_of ( ":/+| " ) );
     
-    for ( int i = 0; i < _idents.size(); i++ )
-        csv += _idents[i].toString() + ",";
+    if ( type == "M" )
+        return kLightCurveMira;
     
-    for ( int i = 0; i < _names.size(); i++ )
-        csv += _names[i] + ",";
-
-    return csv;
+    if ( type.find ( "DCEP" ) == 0 || type.find ( "CEP" ) == 0 || type.find ( "CW" ) == 0 )
+        return kLightCurveCepheid;
+    
+    if ( type.find ( "RR" ) == 0 )
+        return kLightCurveRRLyrae;
+    
+    if ( type == "EA" || type == "E" )
+        return kLightCurveAlgol;
+    
+    if ( type == "EB" )
+        return kLightCurveBetaLyrae;
+    
+    if ( type == "EW" )
+        return kLightCurveWUMa;
+    
+    if ( type == "ELL" )
+        return kLightCurveEllipsoidal;
+    
+    if ( type.find ( "SR" ) == 0 || type.find ( "RV" ) == 0 || type == "ACYG" || type.find ( "BCEP" ) == 0
+      || type == "DSCT" || type == "SXPHE" || type.find ( "ACV" ) == 0 || type == "BY" || type == "PVTEL" )
+        return kLightCurveSinusoid;
+    
+    return kLightCurveNone;
 }
 
-// Returns CSV string including base star data plus names and identifiers.
+// Returns the magnitude of a variable star with the given light curve template (curve)
+// at a particular phase (from 0.0 at epoch to 1.0 one period later). The star's magnitude
+// varies between minMag (when brightest) and maxMag (when faintest). Outside the range
+// 0 to 1, phase wraps around. If the curve is kLightCurveNone, returns minMag.
 
-string SSStar::toCSV ( void )
+float SSVariableStar::lightCurveMagnitude ( SSLightCurve curve, double phase, float minMag, float maxMag )
 {
-    return toCSV1() + toCSV2();
+    phase -= floor ( phase );
+    
+    // Pulsating variables: brightness (from 0 when faintest to 1 when brightest)
+    // declines from maximum at phase 0 over a fraction of the period, then rises.
+    
+    double rise = 0.0;
+    
+    if ( curve == kLightCurveMira )
+        rise = 0.4;
+    else if ( curve == kLightCurveCepheid )
+        rise = 0.2;
+    else if ( curve == kLightCurveRRLyrae )
+        rise = 0.15;
+    else if ( curve == kLightCurveSinusoid )
+        rise = 0.5;
+    
+    if ( rise > 0.0 )
+    {
+        double b = 0.0;
+        
+        if ( phase < 1.0 - rise )
+            b = 0.5 * ( 1.0 + cos ( M_PI * phase / ( 1.0 - rise ) ) );
+        else
+            b = 0.5 * ( 1.0 - cos ( M_PI * ( phase - 1.0 + rise ) / rise ) );
+        
+        return maxMag - b * ( maxMag - minMag );
+    }
+    
+    // Eclipsing variables: depth of eclipse (from 0 at full light to 1 at primary minimum)
+    // peaks at phase 0 (primary eclipse), and at phase 0.5 (shallower secondary eclipse).
+    
+    double secondary = 0.0, width = 0.0;
+    
+    if ( curve == kLightCurveAlgol )
+    {
+        secondary = 0.1;
+        width = 0.1;
+    }
+    else if ( curve == kLightCurveBetaLyrae )
+        secondary = 0.6;
+    else if ( curve == kLightCurveWUMa )
+        secondary = 0.9;
+    else if ( curve == kLightCurveEllipsoidal )
+        secondary = 1.0;
+    else
+        return minMag;
+
+    bool second = phase > 0.25 && phase < 0.75;
+    double depth = second ? secondary : 1.0;
+    double x = second ? phase - 0.5 : phase > 0.5 ? phase - 1.0 : phase;
+    
+    double d = 0.0;
+    if ( width > 0.0 )
+        d = fabs ( x ) < width / 2.0 ? 0.5 * ( 1.0 + cos ( 2.0 * M_PI * x / width ) ) : 0.0;
+    else
+        d = 0.5 * ( 1.0 + cos ( 4.0 * M_PI * x ) );
+    
+    return minMag + depth * d * ( maxMag - minMag );
 }
 
-// Returns CSV string from double-star data (but not SStar base class).
+// Computes this variable star's visual magnitude at a particular Julian Date (jd)
+// from its period, epoch, and magnitude range, using the light curve template for its
+// variability type. If any of these are unknown, returns the star's static visual magnitude.
 
-string SSDoubleStar::toCSVD ( void )
+float SSVariableStar::computeMagnitude ( double jd )
 {
-    string csv = "";
+    SSLightCurve curve = getLightCurve();
+    
+    if ( curve == kLightCurveNone || isinf ( _varPeriod ) || _varPeriod <= 0.0 || isinf ( _varEpoch ) || isinf ( _varMinMag ) || isinf ( _varMaxMag ) )
+        return _Vmag;
     
-    csv += _comps + ",";
-    csv += isinf ( _magDelta ) ? "," : format ( "%+.2f,", _magDelta );
-    csv += isinf ( _sep ) ? "," : format ( "%.1f,", _sep * SSAngle::kArcsecPerRad );
-    csv += isinf ( _PA ) ? "," : format ( "%.1f,", _PA * SSAngle::kDegPerRad );
-    csv += isinf ( _PAyr ) ? "," : format ( "%.2f,", _PAyr );
+    return lightCurveMagnitude ( curve, ( jd - _varEpoch ) / _varPeriod, _varMinMag, _varMaxMag );
+}
+
+// Replaces the star's static visual magnitude in its apparent magnitude with its magnitude
+// at a Julian Ephemeris Date (jde) from its light curve. Call after SSStar::computeEphemeris().
 
-    return csv;
+void SSVariableStar::computeLightCurveMagnitude ( double jde )
+{
+    float vmag = computeMagnitude ( jde );
+    if ( isinf ( _Vmag ) )
+        _magnitude = vmag;
+    else
+        _magnitude += vmag - _Vmag;
 }
 
-// Returns CSV string including base star data, double-star data,
-// plus names and identifiers. Overrides SSStar::toCSV().
+// Computes apparent direction and magnitude like SSStar::computeEphemeris(),
+// but replaces the star's static visual magnitude with its magnitude at the
+// current time from its light curve. Overrides SSStar::computeEphemeris().
 
-string SSDoubleStar::toCSV ( void )
+void SSVariableStar::computeEphemeris ( SSDynamics &dyn )
 {
-    return toCSV1() + toCSVD() + toCSV2();
+    SSStar::computeEphemeris ( dyn );
+    computeLightCurveMagnitude ( dyn.jde );
 }
 
-// Returns CSV string from variable-star data (but not SStar base class).
+// Returns an orbit for a visual binary star from the elements used in orbit catalogs:
+// semimajor axis (a) in radians, eccentricity (e), inclination (i), argument of periastron (w),
+// position angle of ascending node in the fundamental J2000 frame (n) in radians,
+// Julian Date of periastron passage (tp), and period (p) in days.
 
-string SSVariableStar::toCSVV ( void )
+SSOrbit SSDoubleStar::binaryOrbit ( double a, double e, double i, double w, double n, double tp, double p )
 {
-    string csv = "";
-    
-    csv += _varType + ",";
-    csv += isinf ( _varMinMag ) ? "," : format ( "%+.2f,", _varMinMag );
-    csv += isinf ( _varMaxMag ) ? "," : format ( "%+.2f,", _varMaxMag );
-    csv += isinf ( _varPeriod ) ? "," : format ( "%.2f,", _varPeriod );
-    csv += isinf ( _varEpoch )  ? "," : format ( "%.2f,", _varEpoch );
+    return SSOrbit ( tp, a * ( 1.0 - e ), e, i, w, n, 0.0, 2.0 * M_PI / p );
+}
+
+// Computes angular separation (sep) and position angle (pa) of the fainter component
+// from the brighter, in radians, at a Julian Ephemeris Date (jde) from a visual binary orbit.
+// The orbit's x axis points north and y axis points east, so position angle is measured
+// from north through east.
 
-    return csv;
+void SSDoubleStar::orbitSeparationAndPA ( SSOrbit &orbit, double jde, double &sep, double &pa )
+{
+    double nu = 0.0, r = 0.0;
+    orbit.solveKeplerEquation ( jde, nu, r );
+
+    double u = orbit.w + nu;
+    double cu = cos ( u ), su = sin ( u );
+    double cn = cos ( orbit.n ), sn = sin ( orbit.n );
+    double ci = cos ( orbit.i );
+
+    double x = r * ( cu * cn - su * sn * ci );
+    double y = r * ( cu * sn + su * cn * ci );
+
+    sep = sqrt ( x * x + y * y );
+    pa = atan2pi ( y, x );
 }
 
-// Returns CSV string including base star data, variable-star data, plus names and identifiers.
-// Overrides SSStar::toCSV().
+// If this double star has an orbit, computes its separation and position angle from the orbit
+// at a Julian Ephemeris Date (jde), for getOrbitSeparation() and getOrbitPositionAngle().
+// The measured separation, position angle, and year from the catalog are left unchanged.
 
-string SSVariableStar::toCSV ( void )
+void SSDoubleStar::computeOrbitPosition ( double jde )
 {
-    return toCSV1() + toCSVV() + toCSV2();
+    if ( ! hasOrbit() )
+        return;
+
+    double sep = 0.0, pa = 0.0;
+    orbitSeparationAndPA ( _orbit, jde, sep, pa );
+
+    _orbitSep = sep;
+    _orbitPA = pa;
 }
 
-// Returns CSV string including base star data, double-star data, variable-star data,
-// plus names and identifiers.  Overrides SSStar::toCSV().
+// Computes apparent direction and magnitude like SSStar::computeEphemeris(),
+// and separation and position angle from the star's orbit, if it has one.
+// Overrides SSStar::computeEphemeris().
 
-string SSDoubleVariableStar::toCSV ( void )
+void SSDoubleStar::computeEphemeris ( SSDynamics &dyn )
 {
-    return toCSV1() + toCSVD() + toCSVV() + toCSV2();
+    SSStar::computeEphemeris ( dyn );
+    computeOrbitPosition ( dyn.jde );
 }
 
-// Returns CSV string from deep sky object data (but not SStar base class).
+// Computes apparent direction, magnitude from light curve, and separation and position angle
+// from orbit. Overrides both SSDoubleStar::computeEphemeris() and SSVariableStar::computeEphemeris().
 
-string SSDeepSky::toCSVDS ( void )
+void SSDoubleVariableStar::computeEphemeris ( SSDynamics &dyn )
 {
-    string csv = "";
+    SSStar::computeEphemeris ( dyn );
+    computeOrbitPosition ( dyn.jde );
+    computeLightCurveMagnitude ( dyn.jde );
+}
+
+// Appends CSV string from variable-star data (but not SStar base class).
 
-    csv += isinf ( _majAxis ) ? "," : format ( "%.2f,", _majAxis * SSAngle::kArcminPerRad );
-    csv += isinf ( _minAxis ) ? "," : format ( "%.2f,", _minAxis * SSAngle::kArcminPerRad );
-    csv += isinf ( _PA ) ? "," : format ( "%.1f,", _PA * SSAngle::kDegPerRad );
+void SSVariableStar::appendCSVV ( string &csv )
+{
+    csv += _varType.str();
+    csv += ',';
+
+    appendCSVField ( csv, _varMinMag, 2, true );
+    appendCSVField ( csv, _varMaxMag, 2, true );
+    appendCSVField ( csv, _varPeriod, 2 );
+    appendCSVField ( csv, _varEpoch, 2 );
+}
 
-    return csv;
+// Appends CSV string including base star data, variable-star data, plus names and identifiers.
+// Overrides SSStar::appendCSV().
+
+void SSVariableStar::appendCSV ( string &csv )
+{
+    appendCSV1 ( csv );
+    appendCSVV ( csv );
+    appendCSV2 ( csv );
+}
+
+// Appends CSV string including base star data, double-star data, variable-star data,
+// plus names and identifiers.  Overrides SSStar::appendCSV().
+
+void SSDoubleVariableStar::appendCSV ( string &csv )
+{
+    appendCSV1 ( csv );
+    appendCSVD ( csv );
+    appendCSVV ( csv );
+    appendCSV2 ( csv );
+}
+
+// Appends CSV string from deep sky object data (but not SStar base class).
+
+void SSDeepSky::appendCSVDS ( string &csv )
+{
+    appendCSVField ( csv, _majAxis * SSAngle::kArcminPerRad, 2 );
+    appendCSVField ( csv, _minAxis * SSAngle::kArcminPerRad, 2 );
+    appendCSVField ( csv, _PA * SSAngle::kDegPerRad, 1 );
 }
 
-// Returns CSV string including base star data, double-star data,
-// plus names and identifiers. Overrides SSStar::toCSV().
+// Appends CSV string including base star data, deep sky object data,
+// plus names and identifiers. Overrides SSStar::appendCSV().
 
-string SSDeepSky::toCSV ( void )
+void SSDeepSky::appendCSV ( string &csv )
 {
-    return toCSV1() + toCSVDS() + toCSV2();
+    appendCSV1 ( csv );
+    appendCSVDS ( csv );
+    appendCSV2 ( csv );
 }
 
 // Allocates a new SSStar and initializes it from a CSV-formatted string.
+// If an arena is provided (pArena), the object is allocated from it.
 // Returns nullptr on error (invalid CSV string, heap allocation failure, etc.)
 
-SSObjectPtr SSStar::fromCSV ( string csv )
+SSObjectPtr SSStar::fromCSV ( string csv, SSArena *pArena )
 {
     // split string into comma-delimited fields,
     // remove leading & trailing whitespace from each field.
@@ -378,7 +610,7 @@ SSObjectPtr SSStar::fromCSV ( string csv )
             names.push_back ( fields[i] );
     }
     
-    SSObjectPtr pObject = SSNewObject ( type );
+    SSObjectPtr pObject = SSNewObject ( type, pArena );
     SSStarPtr pStar = SSGetStarPtr ( pObject );
     SSDoubleStarPtr pDoubleStar = SSGetDoubleStarPtr ( pObject );
     SSVariableStarPtr pVariableStar = SSGetVariableStarPtr ( pObject );
@@ -394,7 +626,7 @@ SSObjectPtr SSStar::fromCSV ( string csv )
     pStar->setVMagnitude ( vmag );
     pStar->setBMagnitude ( bmag );
     pStar->setSpectralType ( spec );
-    pStar->setIdentifiers( idents );
+    pStar->setIdentifiers ( move ( idents ) );
     pStar->setNames ( names );
     
     if ( pDoubleStar )
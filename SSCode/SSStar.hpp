@@ -13,8 +13,7 @@
 #define SSStar_hpp
 
 #include "SSObject.hpp"
-
-#pragma pack ( push, 1 )
+#include "SSOrbit.hpp"
 
 // This subclass of SSObject stores basic data for stars.
 // Its subclasses store double and variable star data,
@@ -24,8 +23,9 @@ class SSStar : public SSObject
 {
 protected:
     
-    vector<SSIdentifier> _idents;
-    
+    // Fields read by computeEphemeris() come first, grouped together in 64 bytes right after the
+    // SSObject fields. They are not aligned to a cache line boundary, so they may span two lines.
+
     SSVector _position;     // heliocentric position in fundamental frame at epoch J2000; in light years if _parallax > 0 or as unit vector if _parallax is zero
     SSVector _velocity;     // heliocentric space velocity in fundamental frame at epoch J2000, in light years per year (fraction of light speed) if _parallax > 0 or as unit vector if _parallax is zero
     
@@ -35,28 +35,33 @@ protected:
     float   _Vmag;          // visual magnitude at J2000
     float   _Bmag;          // blue magnitude at J2000
 
-    string  _spectrum;      // Spectral type string
+    vector<SSIdentifier> _idents;
+    SSInternedString _spectrum;     // Spectral type string, interned
     
     SSStar ( SSObjectType type ); // constructs a star with a specific type code
-    string toCSV1 ( void );       // returns CSV string from base data (excluding names and identifiers).
-    string toCSV2 ( void );       // returns CSV string from names and identifiers (excluding base data).
+    void appendCSV1 ( string &csv );    // appends CSV string from base data (excluding names and identifiers).
+    void appendCSV2 ( string &csv );    // appends CSV string from names and identifiers (excluding base data).
 
 public:
     
     SSStar ( void );
 
-    void setIdentifiers ( vector<SSIdentifier> idents ) { _idents = idents; }
+    void setIdentifiers ( vector<SSIdentifier> idents ) { _idents = move ( idents ); }
     void setFundamentalPosition ( SSVector pos ) { _position = pos; }
     void setFundamentalVelocity ( SSVector vel ) { _velocity = vel; }
     void setFundamentalCoords ( SSSpherical coords );
     void setFundamentalMotion ( SSSpherical coords, SSSpherical motion );
     void setVMagnitude ( float vmag ) { _Vmag = vmag; }
     void setBMagnitude ( float bmag ) { _Bmag = bmag; }
-    void setSpectralType ( string spectrum ) { _spectrum = spectrum; }
+    void setSpectralType ( const string &spectrum ) { _spectrum = SSStringTable::intern ( spectrum ); }
+    void setParallax ( float plx ) { _parallax = plx; }
+    void setRadVel ( float rv ) { _radvel = rv; }
     
     bool addIdentifier ( SSIdentifier ident );
     SSIdentifier getIdentifier ( SSCatalog cat );
-    vector<SSIdentifier> getIdentifiers ( void ) { return _idents; }
+    int getIdentifierCount ( void ) { return (int) _idents.size(); }
+    SSIdentifier getIdentifierAtIndex ( int i ) { return i >= 0 && i < _idents.size() ? _idents[i] : SSIdentifier(); }
+    const vector<SSIdentifier> &getIdentifiers ( void ) { return _idents; }
     void sortIdentifiers ( void );
     
     SSVector getFundamentalPosition ( void ) { return _position; }
@@ -65,7 +70,7 @@ public:
     SSSpherical getFundamentalMotion ( void );
     float getVMagnitude ( void ) { return _Vmag; }
     float getBMagnitude ( void ) { return _Bmag; }
-    string getSpectralType ( void ) { return _spectrum; }
+    const string &getSpectralType ( void ) { return _spectrum.str(); }
     float getParallax ( void ) { return _parallax; }
     float getRadVel ( void ) { return _radvel; }
     
@@ -73,12 +78,15 @@ public:
     
     // imports/exports from/to CSV-format text string
     
-    static SSObjectPtr fromCSV ( string csv );
-    virtual string toCSV ( void );
+    static SSObjectPtr fromCSV ( string csv, class SSArena *pArena = nullptr );
+    virtual void appendCSV ( string &csv );
 };
 
 // This subclass of SSStar stores data for double stars
 // in addition to the basic stellar data in the base class.
+// The separation and position angle are the catalog's measured values; if the star has
+// an orbit, computeEphemeris() computes the current values from it without changing those.
+// Orbits are not written to CSV or binary catalogs, so they must be set again after importing.
 
 class SSDoubleStar : virtual public SSStar
 {
@@ -89,60 +97,100 @@ protected:
     float _sep;                 // angular separation between components in radians; infinite if unknown
     float _PA;                  // position angle from brighter to fainter component in fundamental mean J2000 equatorial frame; infinite if unknown
     float _PAyr;                // Julian year of position angle measurement; infinite if unknown
+    SSOrbit _orbit;             // orbit of fainter component around brighter; periapse distance in radians, reference plane is the sky; zero if unknown; not saved in CSV or binary catalogs
+    float _orbitSep;            // angular separation computed from orbit by last call to computeEphemeris(), in radians; infinite if not computed
+    float _orbitPA;             // position angle computed from orbit by last call to computeEphemeris(), in radians; infinite if not computed
     
-    string toCSVD ( void );     // returns CSV string from double-star data (but not SStar base class).
+    void appendCSVD ( string &csv );    // appends CSV string from double-star data (but not SStar base class).
+    void computeOrbitPosition ( double jde );
 
 public:
     
     SSDoubleStar ( void );
     
-    void setComponents ( string comps ) { _comps = comps; }
+    void setComponents ( string comps ) { _comps = move ( comps ); }
     void setMagnitudeDelta ( float delta ) { _magDelta = delta; }
     void setSeparation ( float sep ) { _sep = sep; }
     void setPositionAngle ( float pa ) { _PA = pa; }
     void setPositionAngleYear ( float year ) { _PAyr = year; }
     
-    string getComponents ( void ) { return _comps; }
+    const string &getComponents ( void ) { return _comps; }
     float getMagnitudeDelta ( void ) { return _magDelta; }
     float getSeparation ( void ) { return _sep; }
     float getPositionAngle ( void ) { return _PA; }
     float getPositionAngleYear ( void ) { return _PAyr; }
 
-    virtual string toCSV ( void );
+    void setOrbit ( SSOrbit orbit ) { _orbit = orbit; }
+    SSOrbit getOrbit ( void ) { return _orbit; }
+    bool hasOrbit ( void ) { return _orbit.q > 0.0 && _orbit.mm > 0.0; }
+    float getOrbitSeparation ( void ) { return _orbitSep; }
+    float getOrbitPositionAngle ( void ) { return _orbitPA; }
+
+    static SSOrbit binaryOrbit ( double a, double e, double i, double w, double n, double tp, double p );
+    static void orbitSeparationAndPA ( SSOrbit &orbit, double jde, double &sep, double &pa );
+
+    virtual void computeEphemeris ( class SSDynamics &dyn );
+    virtual void appendCSV ( string &csv );
 };
 
 // This subclass of SSStar stores data for variable stars
 // in addition to the basic stellar data in the base class.
 
+// Light curve templates used to compute a variable star's magnitude at any time,
+// from its period, epoch, and range of magnitudes. Pulsating stars are brightest
+// at their epoch; eclipsing stars are faintest at their epoch (primary minimum).
+
+enum SSLightCurve
+{
+    kLightCurveNone = 0,        // irregular or unknown variability; magnitude is constant
+    kLightCurveSinusoid = 1,    // symmetric sinusoid (semiregular, RV Tauri, etc.)
+    kLightCurveMira = 2,        // long-period Mira variable: slower decline than rise
+    kLightCurveCepheid = 3,     // Cepheid: rapid rise, slow decline
+    kLightCurveRRLyrae = 4,     // RR Lyrae: very rapid rise, slow decline
+    kLightCurveAlgol = 5,       // detached eclipsing binary: constant outside brief eclipses
+    kLightCurveBetaLyrae = 6,   // semi-detached eclipsing binary: continuous, unequal minima
+    kLightCurveWUMa = 7,        // contact eclipsing binary: continuous, nearly equal minima
+    kLightCurveEllipsoidal = 8  // ellipsoidal variable: continuous, equal minima
+};
+
 class SSVariableStar : virtual public SSStar
 {
 protected:
     
-    string _varType;             // Variability type code string; empty if unknown
+    SSInternedString _varType;   // Variability type code string, interned; empty if unknown
+    SSLightCurve _lightCurve;    // Light curve template for variability type, computed when type is set
     float _varMaxMag;            // Maximum visual magnitude (i.e. when faintest); infinite if unknown
     float _varMinMag;            // Minimum visual magnitude (i.e. when brightest); infinity if unknown
     double _varPeriod;           // Variability period, in days; infinite if unknown
     double _varEpoch;            // Variability epoch, as Julian Date; infinite if unknown
     
-    string toCSVV ( void );      // returns CSV string from variable-star data (but not SStar base class).
+    void appendCSVV ( string &csv );    // appends CSV string from variable-star data (but not SStar base class).
+    void computeLightCurveMagnitude ( double jde );
 
 public:
     
     SSVariableStar ( void );
 
-    void setVariableType ( string varType ) { _varType = varType; }
+    void setVariableType ( const string &varType ) { _varType = SSStringTable::intern ( varType ); _lightCurve = typeToLightCurve ( varType ); }
     void setMaximumMagnitude ( float maxMag ) { _varMaxMag = maxMag; }
     void setMinimumMagnitude ( float minMag ) { _varMinMag = minMag; }
-    void setPeriod ( float period ) { _varPeriod = period; }
+    void setPeriod ( double period ) { _varPeriod = period; }
     void setEpoch ( double epoch ) { _varEpoch = epoch; }
     
-    string getVariableType ( void ) { return _varType; }
+    const string &getVariableType ( void ) { return _varType.str(); }
     float getMaximumMagnitude ( void ) { return _varMaxMag; }
     float getMinimumMagnitude ( void ) { return _varMinMag; }
     double getPeriod ( void ) { return _varPeriod; }
     double getEpoch ( void ) { return _varEpoch; }
     
-    virtual string toCSV ( void );
+    static SSLightCurve typeToLightCurve ( const string &varType );
+    static float lightCurveMagnitude ( SSLightCurve curve, double phase, float minMag, float maxMag );
+
+    SSLightCurve getLightCurve ( void ) { return _lightCurve; }
+    float computeMagnitude ( double jd );
+
+    virtual void computeEphemeris ( class SSDynamics &dyn );
+    virtual void appendCSV ( string &csv );
 };
 
 // This subclass of SSStar inherits from both SSDoubleStar and SSVariableStar,
@@ -154,7 +202,8 @@ public:
     
     SSDoubleVariableStar ( void );
 
-    virtual string toCSV ( void );
+    virtual void computeEphemeris ( class SSDynamics &dyn );
+    virtual void appendCSV ( string &csv );
 };
 
 // This subclass of SSStar stores data for star clusters, nebulae, and galaxies.
@@ -167,7 +216,7 @@ protected:
     float _minAxis;     // apparent size minor axis, in radians; infinite if unknown
     float _PA;          // position angle of major axis from north in fundamental mean J2000 equatorial frame; infinite if unknown
 
-    string toCSVDS ( void );   // returns CSV string from deep sky object data (but not SStar base class).
+    void appendCSVDS ( string &csv );   // appends CSV string from deep sky object data (but not SStar base class).
 
 public:
     
@@ -176,18 +225,16 @@ public:
     void setMajorAxis ( float maj ) { _majAxis = maj; }
     void setMinorAxis ( float min ) { _minAxis = min; }
     void setPositionAngle ( float pa ) { _PA = pa; }
-    void setGalaxyType ( string type ) { _spectrum = type; }
+    void setGalaxyType ( const string &type ) { _spectrum = SSStringTable::intern ( type ); }
     
     float getMajorAxis ( void ) { return _majAxis; }
     float getMinorAxis ( void ) { return _minAxis; }
     float getPostionAngle ( void ) { return _PA; }
-    string getGalaxyType ( void ) { return _spectrum; }
+    const string &getGalaxyType ( void ) { return _spectrum.str(); }
 
-    virtual string toCSV ( void );
+    virtual void appendCSV ( string &csv );
 };
 
-#pragma pack ( pop )
-
 // convenient aliases for pointers to various subclasses of SSStar
 
 typedef SSStar *SSStarPtr;
@@ -0,0 +1,502 @@
+// SSStarStore.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/14/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SSDynamics.hpp"
+#include "SSStarStore.hpp"
+
+// Constructs an empty star handle which does not refer to any star store.
+
+SSStarHandle::SSStarHandle ( void )
+{
+    _pStore = nullptr;
+    _index = 0;
+}
+
+// Constructs a handle which refers to the star at the specified index in a star store.
+
+SSStarHandle::SSStarHandle ( const SSStarStore *pStore, size_t index )
+{
+    _pStore = pStore;
+    _index = index;
+}
+
+// Returns true if this handle refers to an existing star in a star store.
+
+bool SSStarHandle::isValid ( void ) const
+{
+    return _pStore != nullptr && _index < _pStore->size();
+}
+
+SSObjectType SSStarHandle::getType ( void ) const
+{
+    return _pStore->getType ( _index );
+}
+
+SSVector SSStarHandle::getFundamentalPosition ( void ) const
+{
+    return _pStore->getFundamentalPosition ( _index );
+}
+
+SSVector SSStarHandle::getFundamentalVelocity ( void ) const
+{
+    return _pStore->getFundamentalVelocity ( _index );
+}
+
+// Returns the star's heliocentric spherical coordinates in the fundamental frame
+// at epoch J2000, exactly as SSStar::getFundamentalCoords() does.
+
+SSSpherical SSStarHandle::getFundamentalCoords ( void ) const
+{
+    float parallax = _pStore->getParallax ( _index );
+    SSSpherical coords = _pStore->getFundamentalPosition ( _index ).toSpherical();
+    coords.rad = ( isinf ( parallax ) || parallax == 0.0 ) ? HUGE_VAL : SSDynamics::kLYPerParsec / parallax;
+    return coords;
+}
+
+// Returns the star's heliocentric proper motion and radial velocity in the fundamental frame
+// at epoch J2000, exactly as SSStar::getFundamentalMotion() does.
+
+SSSpherical SSStarHandle::getFundamentalMotion ( void ) const
+{
+    SSVector pos = _pStore->getFundamentalPosition ( _index );
+    SSSpherical motion = pos.toSphericalVelocity ( _pStore->getFundamentalVelocity ( _index ) );
+    motion.rad = _pStore->getRadVel ( _index );
+    return motion;
+}
+
+float SSStarHandle::getParallax ( void ) const
+{
+    return _pStore->getParallax ( _index );
+}
+
+float SSStarHandle::getRadVel ( void ) const
+{
+    return _pStore->getRadVel ( _index );
+}
+
+float SSStarHandle::getVMagnitude ( void ) const
+{
+    return _pStore->getVMagnitude ( _index );
+}
+
+float SSStarHandle::getBMagnitude ( void ) const
+{
+    return _pStore->getBMagnitude ( _index );
+}
+
+const string &SSStarHandle::getSpectralType ( void ) const
+{
+    return _pStore->getSpectralType ( _index );
+}
+
+SSVector SSStarHandle::getDirection ( void ) const
+{
+    return _pStore->getDirection ( _index );
+}
+
+float SSStarHandle::getMagnitude ( void ) const
+{
+    return _pStore->getMagnitude ( _index );
+}
+
+int SSStarHandle::getIdentifierCount ( void ) const
+{
+    return _pStore->getIdentifierCount ( _index );
+}
+
+SSIdentifier SSStarHandle::getIdentifier ( SSCatalog cat ) const
+{
+    return _pStore->getIdentifier ( _index, cat );
+}
+
+SSIdentifier SSStarHandle::getIdentifierAtIndex ( int i ) const
+{
+    return _pStore->getIdentifierAtIndex ( _index, i );
+}
+
+int SSStarHandle::getNameCount ( void ) const
+{
+    return _pStore->getNameCount ( _index );
+}
+
+const string &SSStarHandle::getName ( int i ) const
+{
+    return _pStore->getName ( _index, i );
+}
+
+// Creates a new SSObject from the star this handle refers to.
+// Returns null pointer if the handle is not valid.
+
+SSObjectPtr SSStarHandle::toObject ( void ) const
+{
+    if ( isValid() )
+        return _pStore->toObject ( _index );
+    else
+        return SSObjectPtr ( nullptr );
+}
+
+// Constructs an empty star store. String table entry zero is always
+// the empty string, so stars with no spectral type need no storage.
+
+SSStarStore::SSStarStore ( void )
+{
+    clear();
+}
+
+// Removes all stars and strings from the store, and releases their memory.
+
+void SSStarStore::clear ( void )
+{
+    vector<unsigned char>().swap ( _types );
+    vector<double>().swap ( _posX );
+    vector<double>().swap ( _posY );
+    vector<double>().swap ( _posZ );
+    vector<double>().swap ( _velX );
+    vector<double>().swap ( _velY );
+    vector<double>().swap ( _velZ );
+    vector<float>().swap ( _parallax );
+    vector<float>().swap ( _radvel );
+    vector<float>().swap ( _Vmag );
+    vector<float>().swap ( _Bmag );
+    vector<unsigned int>().swap ( _spectrum );
+    vector<double>().swap ( _dirX );
+    vector<double>().swap ( _dirY );
+    vector<double>().swap ( _dirZ );
+    vector<float>().swap ( _magnitude );
+    vector<unsigned int>().swap ( _identStart );
+    vector<SSIdentifier>().swap ( _idents );
+    vector<unsigned int>().swap ( _nameStart );
+    vector<unsigned int>().swap ( _names );
+    vector<unsigned int>().swap ( _varIndex );
+    vector<unsigned char>().swap ( _varCurve );
+    vector<unsigned int>().swap ( _varType );
+    vector<float>().swap ( _varMinMag );
+    vector<float>().swap ( _varMaxMag );
+    vector<double>().swap ( _varPeriod );
+    vector<double>().swap ( _varEpoch );
+    vector<unsigned int>().swap ( _binIndex );
+    vector<SSOrbit>().swap ( _binOrbit );
+    vector<float>().swap ( _binSep );
+    vector<float>().swap ( _binPA );
+    vector<string>().swap ( _strings );
+    _stringMap.clear();
+
+    _identStart.push_back ( 0 );
+    _nameStart.push_back ( 0 );
+    addString ( "" );
+}
+
+// Preallocates storage for the specified number of stars, identifiers, and names.
+// Call this before appending a large catalog to avoid repeated reallocation.
+
+void SSStarStore::reserve ( size_t numStars, size_t numIdents, size_t numNames )
+{
+    _types.reserve ( numStars );
+    _posX.reserve ( numStars );
+    _posY.reserve ( numStars );
+    _posZ.reserve ( numStars );
+    _velX.reserve ( numStars );
+    _velY.reserve ( numStars );
+    _velZ.reserve ( numStars );
+    _parallax.reserve ( numStars );
+    _radvel.reserve ( numStars );
+    _Vmag.reserve ( numStars );
+    _Bmag.reserve ( numStars );
+    _spectrum.reserve ( numStars );
+    _dirX.reserve ( numStars );
+    _dirY.reserve ( numStars );
+    _dirZ.reserve ( numStars );
+    _magnitude.reserve ( numStars );
+    _identStart.reserve ( numStars + 1 );
+    _idents.reserve ( numIdents );
+    _nameStart.reserve ( numStars + 1 );
+    _names.reserve ( numNames );
+}
+
+// Adds a string to the string table, if not already present,
+// and returns its index in the string table.
+
+unsigned int SSStarStore::addString ( const string &str )
+{
+    map<string,unsigned int>::iterator it = _stringMap.find ( str );
+    if ( it != _stringMap.end() )
+        return it->second;
+
+    unsigned int index = (unsigned int) _strings.size();
+    _strings.push_back ( str );
+    _stringMap.insert ( { str, index } );
+    return index;
+}
+
+// Copies basic data from a star object into the end of this store.
+// Returns the index of the newly-added star in the store.
+
+size_t SSStarStore::append ( SSStar *pStar )
+{
+    size_t index = _types.size();
+    SSVector pos = pStar->getFundamentalPosition();
+    SSVector vel = pStar->getFundamentalVelocity();
+
+    _types.push_back ( pStar->getType() );
+    _posX.push_back ( pos.x );
+    _posY.push_back ( pos.y );
+    _posZ.push_back ( pos.z );
+    _velX.push_back ( vel.x );
+    _velY.push_back ( vel.y );
+    _velZ.push_back ( vel.z );
+    _parallax.push_back ( pStar->getParallax() );
+    _radvel.push_back ( pStar->getRadVel() );
+    _Vmag.push_back ( pStar->getVMagnitude() );
+    _Bmag.push_back ( pStar->getBMagnitude() );
+    _spectrum.push_back ( addString ( pStar->getSpectralType() ) );
+
+    _dirX.push_back ( HUGE_VAL );
+    _dirY.push_back ( HUGE_VAL );
+    _dirZ.push_back ( HUGE_VAL );
+    _magnitude.push_back ( HUGE_VAL );
+
+    const vector<SSIdentifier> &idents = pStar->getIdentifiers();
+    _idents.insert ( _idents.end(), idents.begin(), idents.end() );
+    _identStart.push_back ( (unsigned int) _idents.size() );
+
+    const vector<SSInternedString> &names = pStar->getNames();
+    for ( int i = 0; i < names.size(); i++ )
+        _names.push_back ( addString ( names[i] ) );
+    _nameStart.push_back ( (unsigned int) _names.size() );
+
+    SSVariableStar *pVar = dynamic_cast<SSVariableStar *> ( pStar );
+    if ( pVar != nullptr )
+    {
+        _varIndex.push_back ( (unsigned int) index );
+        _varCurve.push_back ( pVar->getLightCurve() );
+        _varType.push_back ( addString ( pVar->getVariableType() ) );
+        _varMinMag.push_back ( pVar->getMinimumMagnitude() );
+        _varMaxMag.push_back ( pVar->getMaximumMagnitude() );
+        _varPeriod.push_back ( pVar->getPeriod() );
+        _varEpoch.push_back ( pVar->getEpoch() );
+    }
+
+    SSDoubleStar *pDbl = dynamic_cast<SSDoubleStar *> ( pStar );
+    if ( pDbl != nullptr && pDbl->hasOrbit() )
+    {
+        _binIndex.push_back ( (unsigned int) index );
+        _binOrbit.push_back ( pDbl->getOrbit() );
+        _binSep.push_back ( HUGE_VAL );
+        _binPA.push_back ( HUGE_VAL );
+    }
+
+    return index;
+}
+
+// Copies basic data from all stars (and star-derived objects, like deep sky objects)
+// in a vector of objects into the end of this store. Non-star objects are skipped.
+// Returns the number of stars added.
+
+size_t SSStarStore::append ( SSObjectVec &objects )
+{
+    size_t n = 0;
+
+    for ( int i = 0; i < objects.size(); i++ )
+    {
+        SSStar *pStar = dynamic_cast<SSStar *> ( objects[i].get() );
+        if ( pStar == nullptr )
+            continue;
+
+        append ( pStar );
+        n++;
+    }
+
+    return n;
+}
+
+// Returns the identifier of the i-th star in a specific catalog.
+// If not present, returns null identifier (i.e. zero).
+
+SSIdentifier SSStarStore::getIdentifier ( size_t i, SSCatalog cat ) const
+{
+    for ( unsigned int k = _identStart[i]; k < _identStart[i + 1]; k++ )
+    {
+        SSIdentifier ident = _idents[k];
+        if ( ident.catalog() == cat )
+            return ident;
+    }
+
+    return SSIdentifier();
+}
+
+// Returns the index of the i-th star in the variable star side table,
+// or -1 if the i-th star is not a variable star.
+
+int SSStarStore::getVariableSlot ( size_t i ) const
+{
+    vector<unsigned int>::const_iterator it = lower_bound ( _varIndex.begin(), _varIndex.end(), i );
+    if ( it == _varIndex.end() || *it != i )
+        return -1;
+
+    return (int) ( it - _varIndex.begin() );
+}
+
+// Returns the index of the i-th star in the binary star side table,
+// or -1 if the i-th star is not a binary star with an orbit.
+
+int SSStarStore::getBinarySlot ( size_t i ) const
+{
+    vector<unsigned int>::const_iterator it = lower_bound ( _binIndex.begin(), _binIndex.end(), i );
+    if ( it == _binIndex.end() || *it != i )
+        return -1;
+
+    return (int) ( it - _binIndex.begin() );
+}
+
+// Computes apparent directions and magnitudes of all stars in the store
+// for the given dynamical state, and separations and position angles of all binary stars,
+// using the same methods as SSStar::computeEphemeris(), SSVariableStar::computeEphemeris(),
+// and SSDoubleStar::computeEphemeris(). The work is done in a single pass over
+// contiguous columns, so it is much more cache-friendly than calling computeEphemeris()
+// on individual SSStar objects.
+
+void SSStarStore::computeEphemeris ( SSDynamics &dyn )
+{
+    double t = dyn.jde - SSTime::kJ2000;
+    size_t n = _types.size();
+
+    for ( size_t i = 0; i < n; i++ )
+    {
+        if ( _parallax[i] > 0.0 )
+        {
+            double x = _posX[i] + _velX[i] * t;
+            double y = _posY[i] + _velY[i] * t;
+            double z = _posZ[i] + _velZ[i] * t;
+            double d = sqrt ( x * x + y * y + z * z );
+
+            _dirX[i] = x / d;
+            _dirY[i] = y / d;
+            _dirZ[i] = z / d;
+            _magnitude[i] = _Vmag[i] + 5.0 * log10 ( d * _parallax[i] );
+        }
+        else
+        {
+            _dirX[i] = _posX[i];
+            _dirY[i] = _posY[i];
+            _dirZ[i] = _posZ[i];
+            _magnitude[i] = _Vmag[i];
+        }
+    }
+
+    computeVariableMagnitudes ( dyn.jde );
+    computeBinaryOrbits ( dyn.jde );
+}
+
+// Replaces the visual magnitudes of all variable stars in the store with their magnitudes
+// at a particular Julian Date (jd), computed from their light curves, in one pass over the
+// variable star side table. Apparent magnitudes must already have been computed for the
+// same time by computeEphemeris(), which calls this function.
+
+void SSStarStore::computeVariableMagnitudes ( double jd )
+{
+    size_t n = _varIndex.size();
+
+    for ( size_t k = 0; k < n; k++ )
+    {
+        SSLightCurve curve = static_cast<SSLightCurve> ( _varCurve[k] );
+        if ( curve == kLightCurveNone || isinf ( _varPeriod[k] ) || _varPeriod[k] <= 0.0 || isinf ( _varEpoch[k] ) || isinf ( _varMinMag[k] ) || isinf ( _varMaxMag[k] ) )
+            continue;
+
+        unsigned int i = _varIndex[k];
+        float vmag = SSVariableStar::lightCurveMagnitude ( curve, ( jd - _varEpoch[k] ) / _varPeriod[k], _varMinMag[k], _varMaxMag[k] );
+
+        if ( isinf ( _Vmag[i] ) )
+            _magnitude[i] = vmag;
+        else
+            _magnitude[i] += vmag - _Vmag[i];
+    }
+}
+
+// Computes separations and position angles of all binary stars in the store at a
+// Julian Ephemeris Date (jde) from their orbits, in one pass over the binary star side table.
+// Results are available from getBinarySeparation() and getBinaryPositionAngle().
+
+void SSStarStore::computeBinaryOrbits ( double jde )
+{
+    size_t n = _binIndex.size();
+
+    for ( size_t k = 0; k < n; k++ )
+    {
+        double sep = 0.0, pa = 0.0;
+        SSDoubleStar::orbitSeparationAndPA ( _binOrbit[k], jde, sep, pa );
+        _binSep[k] = sep;
+        _binPA[k] = pa;
+    }
+}
+
+// Creates a new SSObject from the i-th star in the store. The object's class
+// is determined by the star's type, but only basic SSStar data, variable star data,
+// and binary star orbits are restored; other double star and deep sky data are left unknown.
+
+SSObjectPtr SSStarStore::toObject ( size_t i ) const
+{
+    SSObjectPtr pObj = SSNewObject ( getType ( i ) );
+    SSStarPtr pStar = SSGetStarPtr ( pObj );
+    if ( pStar == nullptr )
+        return pObj;
+
+    pStar->setFundamentalPosition ( getFundamentalPosition ( i ) );
+    pStar->setFundamentalVelocity ( getFundamentalVelocity ( i ) );
+    pStar->setParallax ( _parallax[i] );
+    pStar->setRadVel ( _radvel[i] );
+    pStar->setVMagnitude ( _Vmag[i] );
+    pStar->setBMagnitude ( _Bmag[i] );
+    pStar->setSpectralType ( getSpectralType ( i ) );
+    pStar->setIdentifiers ( vector<SSIdentifier> ( _idents.begin() + _identStart[i], _idents.begin() + _identStart[i + 1] ) );
+
+    vector<string> names ( getNameCount ( i ) );
+    for ( int k = 0; k < names.size(); k++ )
+        names[k] = getName ( i, k );
+    pStar->setNames ( names );
+
+    int k = getVariableSlot ( i );
+    SSVariableStarPtr pVar = SSGetVariableStarPtr ( pObj );
+    if ( pVar != nullptr && k >= 0 )
+    {
+        pVar->setVariableType ( _strings[ _varType[k] ] );
+        pVar->setMinimumMagnitude ( _varMinMag[k] );
+        pVar->setMaximumMagnitude ( _varMaxMag[k] );
+        pVar->setPeriod ( _varPeriod[k] );
+        pVar->setEpoch ( _varEpoch[k] );
+    }
+
+    k = getBinarySlot ( i );
+    SSDoubleStarPtr pDbl = SSGetDoubleStarPtr ( pObj );
+    if ( pDbl != nullptr && k >= 0 )
+        pDbl->setOrbit ( _binOrbit[k] );
+
+    if ( ! isinf ( _magnitude[i] ) )
+    {
+        pStar->setDirection ( getDirection ( i ) );
+        pStar->setMagnitude ( _magnitude[i] );
+    }
+
+    return pObj;
+}
+
+// Creates new SSObjects from all stars in the store and appends them
+// to the end of a vector of objects. Returns the number of objects added.
+
+size_t SSStarStore::toObjects ( SSObjectVec &objects ) const
+{
+    size_t n = size();
+
+    objects.reserve ( objects.size() + n );
+    for ( size_t i = 0; i < n; i++ )
+        objects.push_back ( toObject ( i ) );
+
+    return n;
+}
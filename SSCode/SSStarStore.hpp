@@ -0,0 +1,173 @@
+// SSStarStore.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/14/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// Stores very large star catalogs (Tycho, Gaia, etc.) in columnar form: positions,
+// velocities, parallaxes, and magnitudes live in contiguous arrays; identifiers
+// and names live in side tables. Individual stars are referenced by lightweight
+// handles, which can be converted to SSObjects when an SSObject API is needed.
+
+#ifndef SSStarStore_hpp
+#define SSStarStore_hpp
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SSStar.hpp"
+
+class SSStarStore;
+
+// Lightweight reference to a single star inside an SSStarStore.
+// Handles are only valid as long as the store they refer to exists.
+
+class SSStarHandle
+{
+protected:
+
+    const SSStarStore *_pStore;     // pointer to star store containing this star
+    size_t _index;                  // index of this star within store
+
+public:
+
+    SSStarHandle ( void );
+    SSStarHandle ( const SSStarStore *pStore, size_t index );
+
+    bool isValid ( void ) const;
+    size_t getIndex ( void ) const { return _index; }
+
+    SSObjectType getType ( void ) const;
+    SSVector getFundamentalPosition ( void ) const;
+    SSVector getFundamentalVelocity ( void ) const;
+    SSSpherical getFundamentalCoords ( void ) const;
+    SSSpherical getFundamentalMotion ( void ) const;
+    float getParallax ( void ) const;
+    float getRadVel ( void ) const;
+    float getVMagnitude ( void ) const;
+    float getBMagnitude ( void ) const;
+    const string &getSpectralType ( void ) const;
+
+    SSVector getDirection ( void ) const;
+    float getMagnitude ( void ) const;
+
+    int getIdentifierCount ( void ) const;
+    SSIdentifier getIdentifier ( SSCatalog cat ) const;
+    SSIdentifier getIdentifierAtIndex ( int i ) const;
+
+    int getNameCount ( void ) const;
+    const string &getName ( int i ) const;
+
+    SSObjectPtr toObject ( void ) const;
+
+    operator bool() const { return isValid(); }
+};
+
+// Structure-of-arrays store of basic star data. The data in the SSStar base class
+// (type, position, motion, parallax, magnitudes, spectrum, identifiers, names) is stored
+// for every star; variable star data and binary star orbits are stored in side tables with
+// one entry per variable star or binary star with an orbit, so their light curves and orbits
+// can be evaluated in a single pass. Other data specific to double stars and deep sky objects
+// is not stored.
+
+class SSStarStore
+{
+protected:
+
+    vector<unsigned char> _types;       // object type codes; see SSObjectType
+
+    vector<double> _posX, _posY, _posZ; // heliocentric position at J2000 in fundamental frame; light years, or unit vector if parallax is zero
+    vector<double> _velX, _velY, _velZ; // heliocentric space velocity in fundamental frame, in light years per year; or as unit vector if parallax is zero
+
+    vector<float> _parallax;            // heliocentric parallax in arcseconds; zero if unknown
+    vector<float> _radvel;              // radial velocity as fraction of light speed; infinite if unknown
+    vector<float> _Vmag;                // visual magnitude at J2000; infinite if unknown
+    vector<float> _Bmag;                // blue magnitude at J2000; infinite if unknown
+    vector<unsigned int> _spectrum;     // string table index of spectral type string
+
+    vector<double> _dirX, _dirY, _dirZ; // apparent direction unit vector from last call to computeEphemeris(); infinite if not computed
+    vector<float> _magnitude;           // apparent visual magnitude from last call to computeEphemeris(); infinite if not computed
+
+    vector<unsigned int> _identStart;   // index of each star's first identifier in _idents; one extra entry marks end of last star
+    vector<SSIdentifier> _idents;       // identifiers of all stars, in star order
+
+    vector<unsigned int> _nameStart;    // index of each star's first name in _names; one extra entry marks end of last star
+    vector<unsigned int> _names;        // string table indices of names of all stars, in star order
+
+    vector<unsigned int> _varIndex;     // store index of each variable star, in ascending order
+    vector<unsigned char> _varCurve;    // light curve template of each variable star; see SSLightCurve
+    vector<unsigned int> _varType;      // string table index of each variable star's type
+    vector<float> _varMinMag;           // magnitude of each variable star when brightest; infinite if unknown
+    vector<float> _varMaxMag;           // magnitude of each variable star when faintest; infinite if unknown
+    vector<double> _varPeriod;          // period of each variable star in days; infinite if unknown
+    vector<double> _varEpoch;           // epoch of each variable star as Julian Date; infinite if unknown
+
+    vector<unsigned int> _binIndex;     // store index of each binary star with an orbit, in ascending order
+    vector<SSOrbit> _binOrbit;          // orbit of each binary star; see SSDoubleStar
+    vector<float> _binSep;              // separation of each binary star in radians from last call to computeEphemeris(); infinite if not computed
+    vector<float> _binPA;               // position angle of each binary star in radians from last call to computeEphemeris(); infinite if not computed
+
+    vector<string> _strings;            // string table shared by spectral types and names
+    map<string,unsigned int> _stringMap;    // mapping of strings to string table indices; used only while appending
+
+    unsigned int addString ( const string &str );
+
+public:
+
+    SSStarStore ( void );
+
+    size_t size ( void ) const { return _types.size(); }
+    void reserve ( size_t numStars, size_t numIdents, size_t numNames );
+    void clear ( void );
+
+    size_t append ( SSStar *pStar );
+    size_t append ( SSObjectVec &objects );
+
+    SSStarHandle operator [] ( size_t i ) const { return SSStarHandle ( this, i ); }
+
+    SSObjectType getType ( size_t i ) const { return static_cast<SSObjectType> ( _types[i] ); }
+    SSVector getFundamentalPosition ( size_t i ) const { return SSVector ( _posX[i], _posY[i], _posZ[i] ); }
+    SSVector getFundamentalVelocity ( size_t i ) const { return SSVector ( _velX[i], _velY[i], _velZ[i] ); }
+    float getParallax ( size_t i ) const { return _parallax[i]; }
+    float getRadVel ( size_t i ) const { return _radvel[i]; }
+    float getVMagnitude ( size_t i ) const { return _Vmag[i]; }
+    float getBMagnitude ( size_t i ) const { return _Bmag[i]; }
+    const string &getSpectralType ( size_t i ) const { return _strings[ _spectrum[i] ]; }
+
+    SSVector getDirection ( size_t i ) const { return SSVector ( _dirX[i], _dirY[i], _dirZ[i] ); }
+    float getMagnitude ( size_t i ) const { return _magnitude[i]; }
+
+    int getIdentifierCount ( size_t i ) const { return _identStart[i + 1] - _identStart[i]; }
+    SSIdentifier getIdentifierAtIndex ( size_t i, int k ) const { return _idents[ _identStart[i] + k ]; }
+    SSIdentifier getIdentifier ( size_t i, SSCatalog cat ) const;
+
+    int getNameCount ( size_t i ) const { return _nameStart[i + 1] - _nameStart[i]; }
+    const string &getName ( size_t i, int k ) const { return _strings[ _names[ _nameStart[i] + k ] ]; }
+
+    // Direct read-only access to columns, for tight loops over the whole catalog.
+
+    const double *getPositionX ( void ) const { return _posX.data(); }
+    const double *getPositionY ( void ) const { return _posY.data(); }
+    const double *getPositionZ ( void ) const { return _posZ.data(); }
+    const float *getVMagnitudes ( void ) const { return _Vmag.data(); }
+    const float *getMagnitudes ( void ) const { return _magnitude.data(); }
+
+    size_t getVariableCount ( void ) const { return _varIndex.size(); }
+    int getVariableSlot ( size_t i ) const;
+
+    size_t getBinaryCount ( void ) const { return _binIndex.size(); }
+    size_t getBinaryIndex ( size_t k ) const { return _binIndex[k]; }
+    const SSOrbit &getBinaryOrbit ( size_t k ) const { return _binOrbit[k]; }
+    float getBinarySeparation ( size_t k ) const { return _binSep[k]; }
+    float getBinaryPositionAngle ( size_t k ) const { return _binPA[k]; }
+    int getBinarySlot ( size_t i ) const;
+
+    void computeEphemeris ( class SSDynamics &dyn );
+    void computeVariableMagnitudes ( double jd );
+    void computeBinaryOrbits ( double jde );
+    SSObjectPtr toObject ( size_t i ) const;
+    size_t toObjects ( SSObjectVec &objects ) const;
+};
+
+#endif /* SSStarStore_hpp */
@@ -0,0 +1,138 @@
+// SSStringTable.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/27/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include <mutex>
+#include <unordered_set>
+#include <functional>
+
+#include "SSStringTable.hpp"
+
+// The table itself. Elements of an unordered_set never move once inserted, even when
+// the set grows, so pointers to them stay valid forever. Function-local statics are
+// used so the table exists before the first string is interned, even during static
+// initialization of other files. The empty string is kept outside the table, so
+// default-constructed strings never need to lock it.
+
+static unordered_set<string> &stringTable ( void )
+{
+    static unordered_set<string> table;
+    return table;
+}
+
+static mutex &stringTableMutex ( void )
+{
+    static mutex m;
+    return m;
+}
+
+// Each thread also keeps its own cache of pointers to the table entries it has interned.
+// The cache is keyed by the strings the entries point to, so a string can be looked up
+// in it without being copied. Only strings a thread has not seen before lock the table;
+// since a catalog uses each distinct string many times, most calls never take the lock.
+
+struct StringPtrHash
+{
+    size_t operator () ( const string *pStr ) const { return hash<string>() ( *pStr ); }
+};
+
+struct StringPtrEqual
+{
+    bool operator () ( const string *pStr1, const string *pStr2 ) const { return *pStr1 == *pStr2; }
+};
+
+typedef unordered_set<const string *, StringPtrHash, StringPtrEqual> StringCache;
+
+static StringCache &threadStringCache ( void )
+{
+    static thread_local StringCache cache;
+    return cache;
+}
+
+static const string *emptyString ( void )
+{
+    static const string empty;
+    return &empty;
+}
+
+SSInternedString::SSInternedString ( void )
+{
+    _pString = emptyString();
+}
+
+SSInternedString::SSInternedString ( const string &str )
+{
+    _pString = SSStringTable::intern ( str )._pString;
+}
+
+// Returns the interned copy of a string, adding the string to the table
+// if it is not already there. The table is locked only if this thread
+// has not interned the string before.
+
+SSInternedString SSStringTable::intern ( const string &str )
+{
+    SSInternedString interned;
+    if ( str.empty() )
+        return interned;
+
+    StringCache &cache = threadStringCache();
+    StringCache::iterator it = cache.find ( &str );
+    if ( it != cache.end() )
+    {
+        interned._pString = *it;
+        return interned;
+    }
+
+    {
+        lock_guard<mutex> lock ( stringTableMutex() );
+        interned._pString = &*stringTable().insert ( str ).first;
+    }
+
+    cache.insert ( interned._pString );
+    return interned;
+}
+
+// Looks up a string in the table without adding it. If found, returns true and
+// the interned copy in (interned); otherwise returns false. An object can only have
+// a string that is already in the table, so a failed lookup means no object has it.
+
+bool SSStringTable::find ( const string &str, SSInternedString &interned )
+{
+    if ( str.empty() )
+    {
+        interned = SSInternedString();
+        return true;
+    }
+
+    lock_guard<mutex> lock ( stringTableMutex() );
+    unordered_set<string>::iterator it = stringTable().find ( str );
+    if ( it == stringTable().end() )
+        return false;
+
+    interned._pString = &*it;
+    return true;
+}
+
+// Returns the number of distinct strings in the table.
+
+size_t SSStringTable::size ( void )
+{
+    lock_guard<mutex> lock ( stringTableMutex() );
+    return stringTable().size();
+}
+
+// Returns an estimate of the memory used by the table in bytes:
+// string headers and characters, hash table nodes, and buckets.
+
+size_t SSStringTable::getBytes ( void )
+{
+    lock_guard<mutex> lock ( stringTableMutex() );
+
+    size_t bytes = stringTable().bucket_count() * sizeof ( void * );
+    for ( const string &str : stringTable() )
+        bytes += sizeof ( string ) + sizeof ( void * ) + str.length() + 1;
+
+    return bytes;
+}
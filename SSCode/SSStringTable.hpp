@@ -0,0 +1,58 @@
+// SSStringTable.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/27/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// A process-wide table of interned strings. Each distinct string is stored only once,
+// however many objects in however many catalogs use it. Objects keep an SSInternedString,
+// which is a single pointer into the table, instead of their own copy of the string.
+// Spectral types, galaxy types and variable star types repeat thousands of times in a
+// typical catalog, so interning saves most of the memory they would otherwise use.
+// Two interned strings are equal only if they are the same table entry, so equality
+// tests are pointer compares. Interned strings are never freed, and the table is
+// thread-safe, so importers running on several threads may share it. Each thread caches
+// the entries it has interned, so the table is only locked the first time a thread sees
+// a particular string, not once per field imported.
+
+#ifndef SSStringTable_hpp
+#define SSStringTable_hpp
+
+#include <string>
+
+using namespace std;
+
+class SSInternedString
+{
+protected:
+
+    const string *_pString;     // pointer to string in table; never null
+
+public:
+
+    SSInternedString ( void );                      // constructs empty string
+    explicit SSInternedString ( const string &str );  // interns the string in the table
+
+    const string &str ( void ) const { return *_pString; }
+    operator const string & ( void ) const { return *_pString; }
+    const char *c_str ( void ) const { return _pString->c_str(); }
+    bool empty ( void ) const { return _pString->empty(); }
+
+    bool operator == ( SSInternedString other ) const { return _pString == other._pString; }
+    bool operator != ( SSInternedString other ) const { return _pString != other._pString; }
+
+    friend class SSStringTable;
+};
+
+class SSStringTable
+{
+public:
+
+    static SSInternedString intern ( const string &str );
+    static bool find ( const string &str, SSInternedString &interned );
+
+    static size_t size ( void );
+    static size_t getBytes ( void );
+};
+
+#endif /* SSStringTable_hpp */
@@ -0,0 +1,158 @@
+// SSStringView.cpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/28/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+
+#include "SSStringView.hpp"
+#include "SSUtilities.hpp"
+
+// Returns a view of up to (count) characters starting at (pos). Unlike string::substr(),
+// never throws: if (pos) is past the end of this view, returns an empty view, and if
+// there are fewer than (count) characters after (pos), returns all of them.
+
+SSStringView SSStringView::substr ( size_t pos, size_t count ) const
+{
+    if ( pos >= _size )
+        return SSStringView ( _data + _size, 0 );
+
+    if ( count > _size - pos )
+        count = _size - pos;
+
+    return SSStringView ( _data + pos, count );
+}
+
+// Returns a view with leading and trailing whitespace removed, like trim().
+
+SSStringView SSStringView::trim ( void ) const
+{
+    size_t start = 0, end = _size;
+
+    while ( start < end && strchr ( " \t\r\n", _data[start] ) && _data[start] )
+        start++;
+
+    while ( end > start && strchr ( " \t\r\n", _data[end - 1] ) && _data[end - 1] )
+        end--;
+
+    return SSStringView ( _data + start, end - start );
+}
+
+// Returns the position of the first occurrence of a character (c) at or after (pos),
+// or npos if not found.
+
+size_t SSStringView::find ( char c, size_t pos ) const
+{
+    if ( pos >= _size )
+        return npos;
+
+    const char *p = (const char *) memchr ( _data + pos, c, _size - pos );
+    return p ? p - _data : npos;
+}
+
+// Returns the position of the first occurrence of a string (str) at or after (pos),
+// or npos if not found.
+
+size_t SSStringView::find ( SSStringView str, size_t pos ) const
+{
+    if ( str._size == 0 )
+        return pos <= _size ? pos : npos;
+
+    for ( ; pos + str._size <= _size; pos++ )
+    {
+        pos = find ( str._data[0], pos );
+        if ( pos == npos || pos + str._size > _size )
+            return npos;
+
+        if ( memcmp ( _data + pos, str._data, str._size ) == 0 )
+            return pos;
+    }
+
+    return npos;
+}
+
+// Splits this view into tokens separated by a delimiter (delim), like split():
+// two adjacent delimiters produce an empty token. The tokens vector is cleared first,
+// so a vector reused from line to line stops allocating once it is big enough.
+// Returns the number of tokens.
+
+int SSStringView::split ( SSStringView delim, vector<SSStringView> &tokens ) const
+{
+    tokens.clear();
+
+    size_t start = 0;
+    size_t end = find ( delim );
+    while ( end != npos )
+    {
+        tokens.push_back ( substr ( start, end - start ) );
+        start = end + delim._size;
+        end = find ( delim, start );
+    }
+
+    tokens.push_back ( substr ( start ) );
+    return (int) tokens.size();
+}
+
+// Splits this view into tokens separated by any of the characters in (delim), like tokenize():
+// adjacent delimiters are skipped, so tokens are never empty. The tokens vector is cleared first.
+// Returns the number of tokens.
+
+int SSStringView::tokenize ( SSStringView delim, vector<SSStringView> &tokens ) const
+{
+    tokens.clear();
+
+    size_t pos = 0;
+    while ( pos < _size )
+    {
+        while ( pos < _size && delim.find ( _data[pos] ) != npos )
+            pos++;
+
+        size_t start = pos;
+        while ( pos < _size && delim.find ( _data[pos] ) == npos )
+            pos++;
+
+        if ( pos > start )
+            tokens.push_back ( SSStringView ( _data + start, pos - start ) );
+    }
+
+    return (int) tokens.size();
+}
+
+// Converts view to 32-bit signed integer, like strtoint().
+// Returns zero if the view cannot be converted.
+
+int SSStringView::toInt ( void ) const
+{
+    return strtoint ( _data, _size );
+}
+
+// Converts view to 64-bit signed integer, like strtoint64().
+// Returns zero if the view cannot be converted.
+
+int64_t SSStringView::toInt64 ( void ) const
+{
+    return strtoint64 ( _data, _size );
+}
+
+// Converts view to 32-bit single precision floating point value, like strtofloat().
+// Returns zero if the view cannot be converted.
+
+float SSStringView::toFloat ( void ) const
+{
+    return strtofloat ( _data, _size );
+}
+
+// Converts view to 64-bit double precision floating point value, like strtofloat64().
+// Returns zero if the view cannot be converted.
+
+double SSStringView::toFloat64 ( void ) const
+{
+    return strtofloat64 ( _data, _size );
+}
+
+// Converts view representing an angle in deg min sec (or hours min sec)
+// to decimal degrees (or hours), like strtodeg().
+
+double SSStringView::toSexagesimal ( void ) const
+{
+    return strtodeg ( _data, _size );
+}
@@ -0,0 +1,73 @@
+// SSStringView.hpp
+// SSCore
+//
+// Created by Tim DeBenedictis on 4/28/20.
+// Copyright © 2020 Southern Stars. All rights reserved.
+//
+// A non-owning, read-only view of a range of characters in another string, like C++17's
+// std::string_view, for parsing catalog records without allocating memory. Taking
+// substrings, trimming whitespace, splitting into fields, and converting fields to numbers
+// all work on views of the original record; nothing is copied until toString() is called.
+// A view is only valid while the string it refers to is unchanged. column() extracts a
+// trimmed field from a fixed-width catalog record, like trim ( line.substr ( start, width ) ).
+// Importers pass each field's offsets inline, next to the comment documenting that field,
+// rather than from a separate table of columns, because many fields are only read depending
+// on the record's length or on the contents of other fields.
+
+#ifndef SSStringView_hpp
+#define SSStringView_hpp
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class SSStringView
+{
+protected:
+
+    const char *_data;      // pointer to first character; not null-terminated
+    size_t _size;           // number of characters in view
+
+public:
+
+    static constexpr size_t npos = (size_t) -1;
+
+    SSStringView ( void ) : _data ( "" ), _size ( 0 ) { }
+    SSStringView ( const char *str ) : _data ( str ), _size ( strlen ( str ) ) { }
+    SSStringView ( const char *data, size_t size ) : _data ( data ), _size ( size ) { }
+    SSStringView ( const string &str ) : _data ( str.data() ), _size ( str.size() ) { }
+
+    const char *data ( void ) const { return _data; }
+    size_t size ( void ) const { return _size; }
+    size_t length ( void ) const { return _size; }
+    bool empty ( void ) const { return _size == 0; }
+    char operator [] ( size_t i ) const { return _data[i]; }
+    const char *begin ( void ) const { return _data; }
+    const char *end ( void ) const { return _data + _size; }
+
+    string toString ( void ) const { return string ( _data, _size ); }
+
+    bool operator == ( SSStringView other ) const { return _size == other._size && memcmp ( _data, other._data, _size ) == 0; }
+    bool operator != ( SSStringView other ) const { return ! ( *this == other ); }
+
+    SSStringView substr ( size_t pos, size_t count = npos ) const;
+    SSStringView trim ( void ) const;
+    SSStringView column ( size_t start, size_t width ) const { return substr ( start, width ).trim(); }
+
+    size_t find ( char c, size_t pos = 0 ) const;
+    size_t find ( SSStringView str, size_t pos = 0 ) const;
+
+    int split ( SSStringView delim, vector<SSStringView> &tokens ) const;
+    int tokenize ( SSStringView delim, vector<SSStringView> &tokens ) const;
+
+    int toInt ( void ) const;
+    int64_t toInt64 ( void ) const;
+    float toFloat ( void ) const;
+    double toFloat64 ( void ) const;
+    double toSexagesimal ( void ) const;
+};
+
+#endif /* SSStringView_hpp */
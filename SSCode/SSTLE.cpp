@@ -273,11 +273,16 @@ void unitv( double v[], double u[] )
         u[i] = v[i] / no;
 }
 
-// default constructor zero initializes
+// default constructor zero initializes numeric fields; name strings
+// are constructed empty, since memset() on a string member corrupts it.
 
 SSTLE::SSTLE ( void )
 {
-    memset ( this, 0, sizeof ( *this ) );
+    norad = 0;
+    jdepoch = xndt2o = xndd6o = bstar = 0.0;
+    xincl = xnodeo = eo = omegao = xmo = xno = 0.0;
+    deep = false;
+    argp.sgp = nullptr;
 }
 
 // copy constructor deletes arg pointer
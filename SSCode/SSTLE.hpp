@@ -46,6 +46,7 @@ struct SSTLE
 
     SSTLE ( void );
     SSTLE ( const SSTLE &other );
+    SSTLE &operator = ( const SSTLE &other ) = default;
     
     // Read from/write to input/output stream.
     
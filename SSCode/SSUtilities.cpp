@@ -5,6 +5,12 @@
 // Copyright © 2020 Southern Stars. All rights reserved.
 
 #include <cstdarg>
+#include <cstdio>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
 #include "SSUtilities.hpp"
 
 #ifdef _WIN32
@@ -13,6 +19,10 @@
 #include <unistd.h>
 #endif
 
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
 // Returns path to current working directory as a string
 
 #ifdef _WIN32
@@ -37,17 +47,26 @@ string getcwd(void)
 
 // Wrapper for fgets() that reads into a C++ string (line)
 // from a C FILE pointer (file) opened for reading in text mode.
+// Lines longer than the buffer are read in pieces and joined, so they are never split.
+// As with fgets(), the newline at the end of the line, if any, is kept.
+// The string's memory is reused, so reading many lines into one string rarely allocates.
 // Returns true if successful or false on failure (end-of-file, etc.)
+// To read files without copying, see SSLineReader.
 
 bool fgetline ( FILE *file, string &line )
 {
     char buffer[1024] = { 0 };
 
-    if ( fgets ( buffer, sizeof ( buffer ), file ) == NULL )
-        return false;
+    line.clear();
+    while ( fgets ( buffer, sizeof ( buffer ), file ) != NULL )
+    {
+        size_t len = strlen ( buffer );
+        line.append ( buffer, len );
+        if ( len == 0 || buffer[len - 1] == '\n' )
+            return true;
+    }
 
-    line = string ( buffer );
-    return true;
+    return ! line.empty();
 }
 
 // Returns a C++ string which has leading and trailing whitespace
@@ -118,55 +137,571 @@ vector<string> tokenize ( string str, string delim )
     return tokens;
 }
 
+// Returns true if a character is whitespace in the "C" locale, like isspace(),
+// but without consulting the current locale.
+
+static inline bool isspacechar ( char c )
+{
+    return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+// Converts the characters from (p) up to (end) to a 64-bit signed integer, like strtoll():
+// skips leading whitespace, accepts an optional sign, and stops at the first non-digit.
+// Saturates at INT64_MAX or INT64_MIN on overflow. Advances (p) past the characters converted.
+
+static int64_t parseint64 ( const char *&p, const char *end )
+{
+    const char *q = p;
+    while ( q < end && isspacechar ( *q ) )
+        q++;
+
+    bool negative = false;
+    if ( q < end && ( *q == '+' || *q == '-' ) )
+        negative = *q++ == '-';
+
+    const char *digits = q;
+    uint64_t value = 0, limit = negative ? (uint64_t) INT64_MAX + 1 : INT64_MAX;
+    bool overflow = false;
+    for ( ; q < end && *q >= '0' && *q <= '9'; q++ )
+    {
+        int d = *q - '0';
+        if ( value > ( limit - d ) / 10 )
+            overflow = true;
+        else
+            value = value * 10 + d;
+    }
+
+    if ( q == digits )
+        return 0;
+
+    p = q;
+    if ( overflow )
+        return negative ? INT64_MIN : INT64_MAX;
+
+    return negative ? (int64_t) ( 0 - value ) : (int64_t) value;
+}
+
+// Powers of ten which are exactly representable in double and single precision.
+
+static const double kExactPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+static const float kExactPowersOf10f[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+// Scans a decimal number from (p) up to (end) in the syntax accepted by strtod(): leading whitespace,
+// optional sign, digits with an optional decimal point, and an optional exponent. On success, returns
+// the number's sign, its significant digits as an integer (mantissa), and the power of ten to scale
+// them by (exponent), and advances (p) past the number. If there is no number, returns zero without
+// advancing (p). Returns false for numbers with more than 19 significant digits, and for the
+// hexadecimal, infinity and NaN syntax; these are left for cstrtod() to convert.
+
+static bool scandecimal ( const char *&p, const char *end, bool &negative, uint64_t &mantissa, int &exponent )
+{
+    const char *q = p;
+    while ( q < end && isspacechar ( *q ) )
+        q++;
+
+    negative = false;
+    if ( q < end && ( *q == '+' || *q == '-' ) )
+        negative = *q++ == '-';
+
+    mantissa = 0;
+    exponent = 0;
+    int numDigits = 0;
+    bool anyDigits = false;
+
+    for ( ; q < end && *q >= '0' && *q <= '9'; q++ )
+    {
+        anyDigits = true;
+        if ( mantissa == 0 && *q == '0' )
+            continue;
+        if ( numDigits++ == 19 )
+            return false;
+        mantissa = mantissa * 10 + ( *q - '0' );
+    }
+
+    if ( q < end && ( *q == 'x' || *q == 'X' ) && anyDigits )
+        return false;
+
+    if ( q < end && *q == '.' )
+    {
+        for ( q++; q < end && *q >= '0' && *q <= '9'; q++ )
+        {
+            anyDigits = true;
+            exponent--;
+            if ( mantissa == 0 && *q == '0' )
+                continue;
+            if ( numDigits++ == 19 )
+                return false;
+            mantissa = mantissa * 10 + ( *q - '0' );
+        }
+    }
+
+    if ( ! anyDigits )
+    {
+        if ( q < end && strchr ( "iInN", *q ) && *q )
+            return false;
+
+        negative = false;
+        exponent = 0;
+        return true;
+    }
+
+    // The exponent is only part of the number if at least one digit follows the 'e'.
+
+    if ( q < end && ( *q == 'e' || *q == 'E' ) )
+    {
+        const char *e = q + 1;
+        bool negexp = false;
+        if ( e < end && ( *e == '+' || *e == '-' ) )
+            negexp = *e++ == '-';
+
+        if ( e < end && *e >= '0' && *e <= '9' )
+        {
+            int exp = 0;
+            for ( ; e < end && *e >= '0' && *e <= '9'; e++ )
+                if ( exp < 100000 )
+                    exp = exp * 10 + ( *e - '0' );
+
+            exponent += negexp ? -exp : exp;
+            q = e;
+        }
+    }
+
+    // Trailing zeros don't change the value, but keep it in the exact range for longer.
+
+    while ( mantissa != 0 && mantissa % 10 == 0 )
+    {
+        mantissa /= 10;
+        exponent++;
+    }
+
+    p = q;
+    return true;
+}
+
+// Converts a null-terminated string to a double or float like strtod() or strtof() in the "C" locale,
+// whatever the current locale is. The "C" locale is created once, on first use, and never freed.
+
+#ifdef _WIN32
+
+static _locale_t getclocale ( void )
+{
+    static _locale_t loc = _create_locale ( LC_ALL, "C" );
+    return loc;
+}
+
+static double cstrtod ( const char *str, char **end )
+{
+    return _strtod_l ( str, end, getclocale() );
+}
+
+static float cstrtof ( const char *str, char **end )
+{
+    return _strtof_l ( str, end, getclocale() );
+}
+
+#else
+
+static locale_t getclocale ( void )
+{
+    static locale_t loc = newlocale ( LC_ALL_MASK, "C", (locale_t) 0 );
+    return loc;
+}
+
+static double cstrtod ( const char *str, char **end )
+{
+    return strtod_l ( str, end, getclocale() );
+}
+
+static float cstrtof ( const char *str, char **end )
+{
+    return strtof_l ( str, end, getclocale() );
+}
+
+#endif
+
+// Converts the characters from (p) up to (end) to a double, exactly as strtod() would in the "C" locale,
+// and advances (p) past the characters converted. If the mantissa and power of ten are
+// both exactly representable, one multiplication or division gives the correctly rounded
+// result (Clinger's fast path). Numbers outside that range are rare in catalogs;
+// they are copied to a buffer and converted by cstrtod().
+
+static double parsefloat64 ( const char *&p, const char *end )
+{
+    bool negative = false;
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    const char *q = p;
+
+    if ( scandecimal ( q, end, negative, mantissa, exponent ) )
+    {
+        if ( mantissa == 0 )
+        {
+            p = q;
+            return negative ? -0.0 : 0.0;
+        }
+
+        if ( mantissa <= ( 1ULL << 53 ) && exponent >= -22 && exponent <= 22 )
+        {
+            double value = (double) mantissa;
+            value = exponent < 0 ? value / kExactPowersOf10[ -exponent ] : value * kExactPowersOf10[ exponent ];
+            p = q;
+            return negative ? -value : value;
+        }
+    }
+
+    char buf[256], *bufend = nullptr;
+    size_t len = (size_t) ( end - p ) < sizeof ( buf ) ? end - p : sizeof ( buf ) - 1;
+    memcpy ( buf, p, len );
+    buf[len] = 0;
+
+    double value = cstrtod ( buf, &bufend );
+    p += bufend - buf;
+    return value;
+}
+
+// Converts the characters from (p) up to (end) to a float, exactly as strtof() would in the "C" locale,
+// and advances (p) past the characters converted. Uses the same fast path as parsefloat64()
+// in single precision; the result is not rounded to double first, which could differ from strtof().
+
+static float parsefloat ( const char *&p, const char *end )
+{
+    bool negative = false;
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    const char *q = p;
+
+    if ( scandecimal ( q, end, negative, mantissa, exponent ) )
+    {
+        if ( mantissa == 0 )
+        {
+            p = q;
+            return negative ? -0.0f : 0.0f;
+        }
+
+        if ( mantissa <= ( 1ULL << 24 ) && exponent >= -10 && exponent <= 10 )
+        {
+            float value = (float) mantissa;
+            value = exponent < 0 ? value / kExactPowersOf10f[ -exponent ] : value * kExactPowersOf10f[ exponent ];
+            p = q;
+            return negative ? -value : value;
+        }
+    }
+
+    char buf[256], *bufend = nullptr;
+    size_t len = (size_t) ( end - p ) < sizeof ( buf ) ? end - p : sizeof ( buf ) - 1;
+    memcpy ( buf, p, len );
+    buf[len] = 0;
+
+    float value = cstrtof ( buf, &bufend );
+    p += bufend - buf;
+    return value;
+}
+
 // Converts string to 32-bit signed integer.
 // Avoids throwing exceptions, unlike stoi().
 // Returns zero if string cannot be converted.
 
-int strtoint ( string str )
+int strtoint ( const string &str )
+{
+    return strtoint ( str.data(), str.length() );
+}
+
+// Converts (len) characters starting at (str) to 32-bit signed integer, like atoi(),
+// but without copying them or consulting the current locale. (str) need not be null-terminated.
+
+int strtoint ( const char *str, size_t len )
 {
-    return atoi ( str.c_str() );
+    return (int) parseint64 ( str, str + len );
 }
 
 // Converts string to 64-bit signed integer.
 // Avoids throwing exceptions, unlike stoll().
 // Returns zero if string cannot be converted.
 
-int64_t strtoint64 ( string str )
+int64_t strtoint64 ( const string &str )
 {
-    return atoll ( str.c_str() );
+    return strtoint64 ( str.data(), str.length() );
+}
+
+// Converts (len) characters starting at (str) to 64-bit signed integer, like atoll().
+
+int64_t strtoint64 ( const char *str, size_t len )
+{
+    return parseint64 ( str, str + len );
 }
 
 // Converts string to 32-bit single precision floating point value.
 // Avoids throwing exceptions, unlike stof().
 // Returns zero if string cannot be converted.
 
-float strtofloat ( string str )
+float strtofloat ( const string &str )
+{
+    return strtofloat ( str.data(), str.length() );
+}
+
+// Converts (len) characters starting at (str) to 32-bit single precision floating point value.
+// The result is identical to strtof() in the "C" locale.
+
+float strtofloat ( const char *str, size_t len )
 {
-    return strtof ( str.c_str(), nullptr );
+    return parsefloat ( str, str + len );
 }
 
 // Converts string to 64-bit double precision floating point value.
 // Avoids throwing exceptions, unlike stod().
 // Returns zero if string cannot be converted.
 
-double strtofloat64 ( string str )
+double strtofloat64 ( const string &str )
+{
+    return strtofloat64 ( str.data(), str.length() );
+}
+
+// Converts (len) characters starting at (str) to 64-bit double precision floating point value.
+// The result is identical to strtod() in the "C" locale.
+
+double strtofloat64 ( const char *str, size_t len )
 {
-    return strtod ( str.c_str(), nullptr );
+    return parsefloat64 ( str, str + len );
 }
 
 // Converts a string representing an angle in deg min sec to decimal degrees.
 // Works with angle strings in any format (DD MM SS.S, DD MM.M, DD.D, etc.)
 // Assumes leading whitespace has been removed from string!
 
-double strtodeg ( string str )
+double strtodeg ( const string &str )
 {
-    const char *cstr = str.c_str();
+    return strtodeg ( str.data(), str.length() );
+}
 
-    double deg = 0.0, min = 0.0, sec = 0.0;
-    sscanf ( cstr, "%lf %lf %lf", &deg, &min, &sec );
-    deg = fabs ( deg ) + min / 60.0 + sec / 3600.0;
-    
-    return cstr[0] == '-' ? -deg : deg;
+// Converts (len) characters starting at (str), representing an angle in deg min sec,
+// to decimal degrees. Reads up to three numbers separated by whitespace, stopping at
+// the first one that can't be converted, with the same result as sscanf ( "%lf %lf %lf" ).
+// The sign is taken from the first character, so leading whitespace must be removed.
+
+double strtodeg ( const char *str, size_t len )
+{
+    const char *p = str, *end = str + len;
+    double values[3] = { 0.0, 0.0, 0.0 };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        const char *q = p;
+        values[i] = parsefloat64 ( p, end );
+        if ( p == q )
+        {
+            values[i] = 0.0;
+            break;
+        }
+    }
+
+    double deg = fabs ( values[0] ) + values[1] / 60.0 + values[2] / 3600.0;
+    return len > 0 && str[0] == '-' ? -deg : deg;
+}
+
+// Powers of ten as integers, for splitting scaled integers into whole and fractional digits.
+
+static const uint64_t kPowersOf10[] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL };
+
+// Rounds a finite, non-negative (value) times 10 to the power (digits) to the nearest integer (result),
+// with ties to even, exactly as printf() rounds the exact decimal expansion of (value). The product is
+// computed exactly as the sum of two doubles, using fma(), so no intermediate rounding can move it
+// across a halfway point. Returns false if (digits) is outside 0 to 22, or the product may not fit in
+// 52 bits; the caller should then use snprintf().
+
+static bool roundscaled ( double value, int digits, uint64_t &result )
+{
+    if ( digits < 0 || digits > 22 )
+        return false;
+
+    double scale = kExactPowersOf10[ digits ];
+    double hi = value * scale;
+    if ( ! ( hi < 4503599627370496.0 ) )
+        return false;
+
+    double lo = fma ( value, scale, -hi );
+    double whole = floor ( hi );
+    double diff = ( ( hi - whole ) - 0.5 ) + lo;
+
+    result = (uint64_t) whole;
+    if ( diff > 0.0 || ( diff == 0.0 && ( result & 1 ) ) )
+        result++;
+
+    return true;
+}
+
+// Writes the decimal digits of an unsigned integer (value) to the end of a buffer (end),
+// working backwards, with at least (numDigits) digits. Returns pointer to first digit.
+
+static char *writedigits ( char *end, uint64_t value, int numDigits )
+{
+    char *p = end;
+    while ( value > 0 || numDigits > 0 )
+    {
+        *--p = '0' + value % 10;
+        value /= 10;
+        numDigits--;
+    }
+
+    return p;
+}
+
+// Appends a sign and the digits from (first) up to (last) to a string (str),
+// padding with zeros after the sign to at least (width) characters, as printf() does for the 0 flag.
+
+static void appendpadded ( string &str, char sign, const char *first, const char *last, int width )
+{
+    int len = (int) ( last - first ) + ( sign ? 1 : 0 );
+
+    if ( sign )
+        str += sign;
+
+    if ( width > len )
+        str.append ( width - len, '0' );
+
+    str.append ( first, last );
+}
+
+// Appends an integer to a string, exactly like printf ( "%0*lld" ) with the given minimum (width),
+// without allocating any memory if the string has room for it.
+
+void appendint ( string &str, int64_t value, int width )
+{
+    char buf[32], *end = buf + sizeof ( buf );
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+    appendpadded ( str, value < 0 ? '-' : 0, writedigits ( end, magnitude, 1 ), end, width );
+}
+
+// Appends a floating-point value to a string with (precision) digits after the decimal point,
+// exactly like printf ( "%0*.*f" ), or printf ( "%+0*.*f" ) if (plus) is true, with the given
+// minimum (width). Values which are too large, infinite, or NaN are formatted by snprintf()
+// into a buffer the same size as format() uses, so even huge values give the same output;
+// either way no memory is allocated if the string has room for the result.
+
+void appendfixed ( string &str, double value, int precision, int width, bool plus )
+{
+    char buf[1024], *end = buf + sizeof ( buf );
+    uint64_t scaled = 0;
+
+    if ( isfinite ( value ) && precision <= 18 && roundscaled ( fabs ( value ), precision, scaled ) )
+    {
+        char *p = writedigits ( end, scaled % kPowersOf10[ precision ], precision );
+        if ( precision > 0 )
+            *--p = '.';
+
+        p = writedigits ( p, scaled / kPowersOf10[ precision ], 1 );
+        appendpadded ( str, signbit ( value ) ? '-' : plus ? '+' : 0, p, end, width );
+    }
+    else
+    {
+        int len = snprintf ( buf, sizeof ( buf ), plus ? "%+0*.*f" : "%0*.*f", width, precision, value );
+        str.append ( buf, len < sizeof ( buf ) ? len : sizeof ( buf ) - 1 );
+    }
+}
+
+// Appends a floating-point value to a string in exponential notation with (precision) digits after
+// the decimal point, exactly like printf ( "%.*E" ), or printf ( "%+.*E" ) if (plus) is true.
+// Zero, and values whose scaled digits can't be computed exactly, are formatted by snprintf().
+
+void appendexp ( string &str, double value, int precision, bool plus )
+{
+    char buf[1024], *end = buf + sizeof ( buf );
+    double magnitude = fabs ( value );
+    uint64_t scaled = 0;
+    bool exact = false;
+
+    // Estimate the decimal exponent, then correct it until the rounded digits
+    // have exactly (precision + 1) significant figures.
+
+    int exponent = isfinite ( magnitude ) && magnitude > 0.0 ? (int) floor ( log10 ( magnitude ) ) : 0;
+    for ( int tries = 0; magnitude > 0.0 && precision <= 17 && tries < 3; tries++ )
+    {
+        exact = roundscaled ( magnitude, precision - exponent, scaled );
+        if ( ! exact )
+            break;
+
+        if ( scaled >= kPowersOf10[ precision + 1 ] )
+            exponent++;
+        else if ( scaled < kPowersOf10[ precision ] )
+            exponent--;
+        else
+            break;
+
+        exact = false;
+    }
+
+    if ( exact )
+    {
+        char *p = writedigits ( end, exponent < 0 ? -exponent : exponent, 2 );
+        *--p = exponent < 0 ? '-' : '+';
+        *--p = 'E';
+
+        p = writedigits ( p, scaled % kPowersOf10[ precision ], precision );
+        if ( precision > 0 )
+            *--p = '.';
+
+        p = writedigits ( p, scaled / kPowersOf10[ precision ], 1 );
+        appendpadded ( str, signbit ( value ) ? '-' : plus ? '+' : 0, p, end, 0 );
+    }
+    else
+    {
+        int len = snprintf ( buf, sizeof ( buf ), plus ? "%+.*E" : "%.*E", precision, value );
+        str.append ( buf, len < sizeof ( buf ) ? len : sizeof ( buf ) - 1 );
+    }
+}
+
+// Compares a null-terminated name in a table (name) to (len) characters starting at (str), like strcmp().
+// Returns a negative number if the name sorts first, a positive number if the characters do,
+// or zero if they are the same.
+
+static int comparename ( const char *name, const char *str, size_t len )
+{
+    size_t i = 0;
+    for ( ; i < len && name[i] != 0; i++ )
+        if ( name[i] != str[i] )
+            return (unsigned char) name[i] < (unsigned char) str[i] ? -1 : 1;
+
+    if ( i < len )
+        return -1;
+
+    return name[i] != 0 ? 1 : 0;
+}
+
+// Returns the position of the first entry in a table of (n) names sorted in ascending order (table)
+// whose name does not sort before the (len) characters starting at (str), or (n) if every name does.
+// Any names which begin with those characters follow it.
+
+size_t lowername ( const SSNameValue *table, size_t n, const char *str, size_t len )
+{
+    size_t first = 0;
+
+    while ( n > 0 )
+    {
+        size_t half = n / 2;
+        if ( comparename ( table[first + half].name, str, len ) < 0 )
+        {
+            first += half + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+
+    return first;
+}
+
+// Returns the value of the entry in a table of (n) names sorted in ascending order (table)
+// whose name is the (len) characters starting at (str), or (notfound) if there is none.
+
+int findname ( const SSNameValue *table, size_t n, const char *str, size_t len, int notfound )
+{
+    size_t k = lowername ( table, n, str, len );
+    return k < n && comparename ( table[k].name, str, len ) == 0 ? table[k].value : notfound;
 }
 
 // Converts angle in degrees to radians.
@@ -43,12 +43,49 @@ string format ( const char *fmt, ... );
 vector<string> split ( string str, string delim );
 vector<string> tokenize ( string str, string delim );
 
-int strtoint ( string str );
-int64_t strtoint64 ( string str );
-float strtofloat ( string str );
-double strtofloat64 ( string str );
+int strtoint ( const string &str );
+int64_t strtoint64 ( const string &str );
+float strtofloat ( const string &str );
+double strtofloat64 ( const string &str );
+double strtodeg ( const string &str );
+
+int strtoint ( const char *str, size_t len );
+int64_t strtoint64 ( const char *str, size_t len );
+float strtofloat ( const char *str, size_t len );
+double strtofloat64 ( const char *str, size_t len );
+double strtodeg ( const char *str, size_t len );
+
+void appendint ( string &str, int64_t value, int width = 0 );
+void appendfixed ( string &str, double value, int precision, int width = 0, bool plus = false );
+void appendexp ( string &str, double value, int precision, bool plus = false );
+
+// A string and the integer it stands for, in a constant table such as constellation abbreviations
+// or object type codes. Tables are sorted by string, so they can be searched with findname();
+// namessorted() checks the order at compile time, with static_assert().
+
+struct SSNameValue
+{
+    const char *name;
+    int value;
+};
+
+// Returns true if null-terminated string (s1) sorts before (s2), as strcmp ( s1, s2 ) < 0 does.
+
+constexpr bool strless ( const char *s1, const char *s2 )
+{
+    return *s1 != *s2 ? (unsigned char) *s1 < (unsigned char) *s2 : *s1 != 0 && strless ( s1 + 1, s2 + 1 );
+}
+
+// Returns true if the names in a table (table) from entry (i) onward are in strictly ascending order.
+
+template <size_t N> constexpr bool namessorted ( const SSNameValue ( &table )[N], size_t i = 1 )
+{
+    return i >= N || ( strless ( table[i - 1].name, table[i].name ) && namessorted ( table, i + 1 ) );
+}
+
+size_t lowername ( const SSNameValue *table, size_t n, const char *str, size_t len );
+int findname ( const SSNameValue *table, size_t n, const char *str, size_t len, int notfound = 0 );
 
-double strtodeg ( string str );
 double degtorad ( double deg );
 double radtodeg ( double rad );
 double sindeg ( double deg );
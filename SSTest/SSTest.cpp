@@ -4,8 +4,18 @@
 //  Created by Tim DeBenedictis on 2/24/20.
 //  Copyright © 2020 Southern Stars. All rights reserved.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <clocale>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <new>
+#include <thread>
+#include <unordered_set>
 
 #if defined __APPLE__
 #include <TargetConditionals.h>
@@ -17,26 +27,53 @@
 #include "SSPlanet.hpp"
 #include "SSStar.hpp"
 #include "SSConstellation.hpp"
+#include "SSArena.hpp"
+#include "SSBinaryCatalog.hpp"
+#include "SSCatalogMerge.hpp"
+#include "SSCatalogStream.hpp"
+#include "SSEphemerisBatch.hpp"
+#include "SSIdentifierIndex.hpp"
 #include "SSImportHIP.hpp"
 #include "SSImportSKY2000.hpp"
 #include "SSImportNGCIC.hpp"
 #include "SSImportMPC.hpp"
 #include "SSImportGJ.hpp"
 #include "SSJPLDEphemeris.hpp"
+#include "SSQuery.hpp"
+#include "SSLineReader.hpp"
+#include "SSNameIndex.hpp"
 #include "SSTLE.hpp"
+#include "SSStringView.hpp"
+#include "SSStarStore.hpp"
+
+// Counts heap allocations made by the test program, so allocation-heavy code paths can be compared.
+// Worker threads allocate too, so the count is atomic; relaxed order is enough for a counter.
+
+static atomic<size_t> _numAllocs ( 0 );
+
+void *operator new ( size_t size )
+{
+    _numAllocs.fetch_add ( 1, memory_order_relaxed );
+    void *p = malloc ( size );
+    if ( p == nullptr )
+        throw bad_alloc();
+    return p;
+}
+
+void operator delete ( void *p ) noexcept
+{
+    free ( p );
+}
 
 void exportCatalog ( SSObjectVec &objects, SSCatalog cat, int first, int last )
 {
-    SSObjectMap map = SSMakeObjectMap ( objects, cat );
+    SSIdentifierIndex index ( objects, cat );
 
     for ( int n = first; n <= last; n++ )
     {
-        int i = map[ SSIdentifier ( cat, n ) ];
-        if ( i > 0 )
-        {
-            SSObjectPtr pObj = objects[ i - 1 ];
+        SSObjectPtr pObj = SSIdentifierToObject ( SSIdentifier ( cat, n ), index, objects );
+        if ( pObj != nullptr )
             cout << pObj.get()->toCSV() << endl;
-        }
     }
 }
 
@@ -148,6 +185,36 @@ void TestConstellations ( string inputDir, string outputDir )
     }
 }
 
+// Converts every constellation index from 1 to 88 to its IAU abbreviation and back, and checks that
+// Bayer and Flamsteed identifiers in every constellation convert to strings and back unchanged.
+// Also checks that invalid indices and abbreviations are rejected.
+
+void TestConstellationAbbreviations ( void )
+{
+    int mismatches = 0;
+    for ( int i = 1; i <= 88; i++ )
+    {
+        string abbrev = SSConstellation::indexToAbbreviation ( i );
+        if ( abbrev != kConstellations[ i - 1 ] || SSConstellation::abbreviationToIndex ( abbrev ) != i )
+            mismatches++;
+
+        for ( string str : { "alpha " + abbrev, "omega " + abbrev, "b " + abbrev, "61 " + abbrev } )
+        {
+            SSIdentifier ident = SSIdentifier::fromString ( str );
+            if ( ( ident.catalog() != kCatBayer && ident.catalog() != kCatFlamsteed ) || ident.toString() != str )
+                mismatches++;
+        }
+    }
+
+    int rejected = 0;
+    rejected += SSConstellation::indexToAbbreviation ( 0 ).empty();
+    rejected += SSConstellation::indexToAbbreviation ( 89 ).empty();
+    rejected += SSConstellation::abbreviationToIndex ( "Xyz" ) == 0;
+    rejected += SSConstellation::abbreviationToIndex ( "" ) == 0;
+
+    cout << "Constellation abbreviations: 88 round trips, " << mismatches << " mismatches; " << rejected << " of 4 invalid inputs rejected" << endl;
+}
+
 void TestStars ( string inputDir, string outputDir )
 {
     SSObjectVec nearest, brightest;
@@ -188,6 +255,1930 @@ void TestDeepSky ( string inputDir, string outputDir )
     }
 }
 
+// Times lookups of a list of identifiers (idents) in an SSObjectMap and an SSIdentifierIndex
+// built from the same objects for one catalog (cat), and reports how many each found.
+
+void BenchmarkIdentifierIndex ( SSObjectVec &objects, SSCatalog cat, SSIdentifierVec &idents, string name )
+{
+    auto start = chrono::steady_clock::now();
+    SSObjectMap map = SSMakeObjectMap ( objects, cat );
+    auto built = chrono::steady_clock::now();
+
+    int found = 0;
+    for ( SSIdentifier ident : idents )
+        if ( SSIdentifierToObject ( ident, map, objects ) != nullptr )
+            found++;
+
+    auto done = chrono::steady_clock::now();
+    double mapBuild = chrono::duration<double,milli> ( built - start ).count();
+    double mapFind = chrono::duration<double,milli> ( done - built ).count();
+
+    start = chrono::steady_clock::now();
+    SSIdentifierIndex index ( objects, cat );
+    built = chrono::steady_clock::now();
+
+    int indexFound = 0;
+    for ( SSIdentifier ident : idents )
+        if ( SSIdentifierToObject ( ident, index, objects ) != nullptr )
+            indexFound++;
+
+    done = chrono::steady_clock::now();
+    double indexBuild = chrono::duration<double,milli> ( built - start ).count();
+    double indexFind = chrono::duration<double,milli> ( done - built ).count();
+
+    cout << name << " map: " << map.size() << " identifiers built in " << format ( "%.2f", mapBuild ) << " ms, ";
+    cout << idents.size() << " lookups in " << format ( "%.2f", mapFind ) << " ms, found " << found << endl;
+    cout << name << " index: " << index.size() << " identifiers built in " << format ( "%.2f", indexBuild ) << " ms, ";
+    cout << idents.size() << " lookups in " << format ( "%.2f", indexFind ) << " ms, found " << indexFound << endl;
+}
+
+void TestIdentifierIndex ( string inputDir )
+{
+    SSObjectVec stars, deepsky;
+
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", stars );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Messier.csv", deepsky );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", deepsky );
+
+    SSIdentifierVec hipIdents, ngcIdents;
+
+    for ( int n = 1; n <= 118218; n++ )
+        hipIdents.push_back ( SSIdentifier ( kCatHIP, n ) );
+
+    for ( int n = 1; n <= 7840; n++ )
+        ngcIdents.push_back ( SSIdentifier::fromString ( "NGC " + to_string ( n ) ) );
+
+    BenchmarkIdentifierIndex ( stars, kCatHIP, hipIdents, "HIP" );
+    BenchmarkIdentifierIndex ( deepsky, kCatNGC, ngcIdents, "NGC" );
+}
+
+// Builds identifier indexes for several star catalogs at once from three copies of the bright star
+// catalog, plus a star with two HR numbers, so every identifier appears more than once and the
+// objects are split between threads. Verifies that every identifier finds the first object which
+// has it, that identifiers no object has are not found, and that both of the extra star's HR numbers
+// are indexed.
+
+void TestIdentifierIndexes ( string inputDir )
+{
+    SSObjectVec stars;
+    for ( int copy = 0; copy < 3; copy++ )
+        SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", stars );
+
+    SSObjectPtr pObject = SSNewObject ( kTypeStar );
+    SSGetStarPtr ( pObject )->setIdentifiers ( { SSIdentifier ( kCatHR, 99998 ), SSIdentifier ( kCatHR, 99999 ) } );
+    stars.push_back ( pObject );
+
+    vector<SSCatalog> cats = { kCatHR, kCatHD, kCatSAO, kCatHIP, kCatBayer, kCatFlamsteed, kCatGCVS };
+    vector<SSIdentifierIndex> indexes;
+    int total = SSMakeIdentifierIndexes ( stars, cats, indexes, 4 );
+
+    int mismatches = indexes.size() == cats.size() ? 0 : 1;
+    size_t expectedTotal = 0;
+    for ( size_t c = 0; c < cats.size() && c < indexes.size(); c++ )
+    {
+        // Find the first object with each identifier the slow way.
+
+        map<int64_t,int> first;
+        for ( int i = 0; i < stars.size(); i++ )
+            for ( int k = 0; k < stars[i]->getIdentifierCount(); k++ )
+            {
+                SSIdentifier ident = stars[i]->getIdentifierAtIndex ( k );
+                if ( ident.catalog() == cats[c] )
+                    first.insert ( { ident, i } );
+            }
+
+        expectedTotal += first.size();
+        if ( indexes[c].size() != first.size() )
+            mismatches++;
+
+        for ( auto &pair : first )
+        {
+            if ( indexes[c].find ( pair.first ) != pair.second )
+                mismatches++;
+
+            if ( first.count ( pair.first + 1 ) == 0 && indexes[c].find ( pair.first + 1 ) != -1 )
+                mismatches++;
+        }
+    }
+
+    if ( indexes.size() > 0 && ( indexes[0].find ( SSIdentifier ( kCatHR, 99998 ) ) != stars.size() - 1
+                             || indexes[0].find ( SSIdentifier ( kCatHR, 99999 ) ) != stars.size() - 1 ) )
+        mismatches++;
+
+    cout << "Identifier indexes: " << total << " identifiers of " << stars.size() << " objects in " << cats.size() << " catalogs, ";
+    cout << ( total == expectedTotal ? 0 : 1 ) + mismatches << " mismatches" << endl;
+}
+
+// Loads the bright and nearby star files into a star store and into SSStar objects. Verifies that star
+// handles taken before the nearby stars were appended still refer to the same stars afterwards; that
+// stars converted back to objects keep their basic star data, and plain and variable stars their whole
+// CSV; and that the store computes the same apparent directions and magnitudes as the objects do.
+
+void TestStarStore ( string inputDir )
+{
+    SSObjectVec stars;
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", stars );
+    size_t numBright = stars.size();
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Nearest.csv", stars );
+
+    SSStarStore store;
+    for ( size_t i = 0; i < numBright; i++ )
+        store.append ( SSGetStarPtr ( stars[i] ) );
+
+    // Returns a string made from all of a star's names, identifiers, and J2000 position, given its handle.
+
+    auto describe = [] ( SSStarHandle &handle ) -> string
+    {
+        string str;
+        for ( int i = 0; i < handle.getNameCount(); i++ )
+            str += handle.getName ( i ) + ",";
+        for ( int i = 0; i < handle.getIdentifierCount(); i++ )
+            str += handle.getIdentifierAtIndex ( i ).toString() + ",";
+        SSSpherical coords = handle.getFundamentalCoords();
+        return str + format ( "%.9f,%.9f", coords.lon, coords.lat );
+    };
+
+    vector<SSStarHandle> handles = { store[0], store[ numBright / 2 ], store[ numBright - 1 ] };
+    vector<string> descriptions;
+    for ( SSStarHandle &handle : handles )
+        descriptions.push_back ( describe ( handle ) );
+
+    for ( size_t i = numBright; i < stars.size(); i++ )
+        store.append ( SSGetStarPtr ( stars[i] ) );
+
+    int failures = store.size() != stars.size();
+    for ( size_t k = 0; k < handles.size(); k++ )
+        failures += ! handles[k].isValid() || describe ( handles[k] ) != descriptions[k];
+
+    for ( size_t i = 0; i < store.size() && i < stars.size(); i++ )
+    {
+        SSStarPtr pStar = SSGetStarPtr ( stars[i] );
+        SSObjectPtr pObject = store.toObject ( i );
+        SSStarPtr pCopy = SSGetStarPtr ( pObject );
+        if ( pCopy == nullptr || pCopy->getType() != pStar->getType() || pCopy->getNames() != pStar->getNames() || pCopy->getIdentifiers() != pStar->getIdentifiers()
+            || pCopy->getFundamentalPosition() != pStar->getFundamentalPosition() || pCopy->getFundamentalVelocity() != pStar->getFundamentalVelocity()
+            || pCopy->getParallax() != pStar->getParallax() || pCopy->getRadVel() != pStar->getRadVel() || pCopy->getVMagnitude() != pStar->getVMagnitude()
+            || pCopy->getBMagnitude() != pStar->getBMagnitude() || pCopy->getSpectralType() != pStar->getSpectralType() )
+            failures++;
+        else if ( ( pStar->getType() == kTypeStar || pStar->getType() == kTypeVariableStar ) && pCopy->toCSV() != pStar->toCSV() )
+            failures++;
+    }
+
+    double maxAngle = 0.0, maxMag = 0.0;
+    for ( double jd : { SSTime::kJ2000, SSTime::kJ2000 - 36525.0, SSTime::kJ2000 + 9876.5 } )
+    {
+        SSDynamics dyn ( jd, 0.0, 0.0 );
+        store.computeEphemeris ( dyn );
+        for ( size_t i = 0; i < store.size() && i < stars.size(); i++ )
+        {
+            stars[i]->computeEphemeris ( dyn );
+            double angle = store.getDirection ( i ).angularSeparation ( stars[i]->getDirection() );
+            double mag = fabs ( store.getMagnitude ( i ) - stars[i]->getMagnitude() );
+            maxAngle = max ( maxAngle, angle );
+            maxMag = max ( maxMag, mag );
+        }
+    }
+
+    failures += maxAngle > 1.0e-12 || maxMag > 1.0e-5;
+    cout << "Star store: " << store.size() << " stars, largest direction difference " << format ( "%.1e", maxAngle ) << " rad, ";
+    cout << "largest magnitude difference " << format ( "%.1e", maxMag ) << ", " << failures << " failures" << endl;
+}
+
+// Checks every light curve template between magnitudes 5 and 8: pulsating curves must be brightest at
+// their epoch and faintest where their rise begins; eclipsing curves must be faintest at their epoch
+// (primary minimum), at full light a quarter period later, and at their secondary minimum half a period
+// later; and no curve may leave the range at any phase. Checks that GCVS type codes map to the right
+// templates. Then verifies that a variable star's magnitude follows its light curve, falls back to its
+// static V magnitude when its period, epoch, or type is unknown, and matches a star store's magnitudes.
+
+void TestLightCurves ( void )
+{
+    struct Template
+    {
+        SSLightCurve curve;
+        string type;
+        double faintest;        // phase when faintest (pulsating) or brightest (eclipsing)
+        double secondary;       // relative depth of secondary minimum; zero for pulsating curves
+    };
+
+    vector<Template> templates =
+    {
+        { kLightCurveSinusoid, "SRA", 0.5, 0.0 },
+        { kLightCurveMira, "M", 0.6, 0.0 },
+        { kLightCurveCepheid, "DCEP", 0.8, 0.0 },
+        { kLightCurveRRLyrae, "RRAB", 0.85, 0.0 },
+        { kLightCurveAlgol, "EA/DM", 0.25, 0.1 },
+        { kLightCurveBetaLyrae, "EB", 0.25, 0.6 },
+        { kLightCurveWUMa, "EW", 0.25, 0.9 },
+        { kLightCurveEllipsoidal, "ELL", 0.25, 1.0 }
+    };
+
+    static const float kMin = 5.0, kMax = 8.0, kTolerance = 1.0e-5;
+    auto magnitude = [] ( SSLightCurve curve, double phase ) { return SSVariableStar::lightCurveMagnitude ( curve, phase, kMin, kMax ); };
+    int failures = 0;
+
+    for ( Template &t : templates )
+    {
+        failures += SSVariableStar::typeToLightCurve ( t.type ) != t.curve;
+        if ( t.secondary == 0.0 )
+        {
+            failures += fabs ( magnitude ( t.curve, 0.0 ) - kMin ) > kTolerance || fabs ( magnitude ( t.curve, 1.0 ) - kMin ) > kTolerance;
+            failures += fabs ( magnitude ( t.curve, t.faintest ) - kMax ) > kTolerance;
+        }
+        else
+        {
+            failures += fabs ( magnitude ( t.curve, 0.0 ) - kMax ) > kTolerance || fabs ( magnitude ( t.curve, -1.0 ) - kMax ) > kTolerance;
+            failures += fabs ( magnitude ( t.curve, t.faintest ) - kMin ) > kTolerance;
+            failures += fabs ( magnitude ( t.curve, 0.5 ) - ( kMin + t.secondary * ( kMax - kMin ) ) ) > kTolerance;
+        }
+
+        for ( int i = 0; i <= 1000; i++ )
+        {
+            float mag = magnitude ( t.curve, i / 1000.0 );
+            failures += mag < kMin - kTolerance || mag > kMax + kTolerance;
+        }
+    }
+
+    for ( string type : { "L", "IA", "UGSS", "" } )
+        failures += SSVariableStar::typeToLightCurve ( type ) != kLightCurveNone;
+
+    // Variable stars: one for each template, then ones with unknown period, epoch, and type.
+
+    double epoch = SSTime::kJ2000, period = 10.0;
+    SSStarStore store;
+    SSObjectVec stars;
+    for ( int i = 0; i < templates.size() + 3; i++ )
+    {
+        SSObjectPtr pObject = SSNewObject ( kTypeVariableStar );
+        SSVariableStarPtr pVar = SSGetVariableStarPtr ( pObject );
+        pVar->setFundamentalPosition ( SSVector ( 0.0, 1.0, 0.0 ) );
+        pVar->setFundamentalVelocity ( SSVector ( 0.0, 0.0, 0.0 ) );
+        pVar->setVMagnitude ( 6.5 );
+        pVar->setVariableType ( i < templates.size() ? templates[i].type : i == templates.size() + 2 ? "L" : "M" );
+        pVar->setMinimumMagnitude ( kMin );
+        pVar->setMaximumMagnitude ( kMax );
+        pVar->setPeriod ( i == templates.size() ? HUGE_VAL : period );
+        pVar->setEpoch ( i == templates.size() + 1 ? HUGE_VAL : epoch );
+        stars.push_back ( pObject );
+        store.append ( pVar );
+    }
+
+    for ( double jd : { epoch, epoch + 0.25 * period, epoch + 103.7 } )
+    {
+        SSDynamics dyn ( jd, 0.0, 0.0 );
+        store.computeEphemeris ( dyn );
+        for ( int i = 0; i < stars.size(); i++ )
+        {
+            SSVariableStarPtr pVar = SSGetVariableStarPtr ( stars[i] );
+            float expected = i < templates.size() ? magnitude ( templates[i].curve, ( dyn.jde - epoch ) / period ) : 6.5;
+            pVar->computeEphemeris ( dyn );
+            failures += fabs ( pVar->computeMagnitude ( dyn.jde ) - expected ) > kTolerance;
+            failures += fabs ( pVar->getMagnitude() - expected ) > kTolerance;
+            failures += store.getMagnitude ( i ) != pVar->getMagnitude();
+        }
+    }
+
+    cout << "Light curves: " << templates.size() << " templates, " << stars.size() << " variable stars, " << failures << " failures" << endl;
+}
+
+// Checks binary star orbits against separations and position angles known in closed form: a circular
+// face-on orbit, whose position angle advances 90 degrees each quarter period; an eccentric face-on orbit,
+// at periastron and half a period later at apastron, on opposite sides of the primary; and an edge-on orbit, whose position angle
+// is always 0 or 180 degrees. Then verifies that computeEphemeris() on a double star and a double variable
+// star computes the orbit's separation and position angle without changing the catalog's measured values
+// or CSV, and that a star store computes the same values for the same stars.
+
+void TestBinaryOrbits ( void )
+{
+    static const double kTolerance = 1.0e-9;
+    double arcsec = SSAngle::kRadPerArcsec, deg = SSAngle::kRadPerDeg, tp = SSTime::kJ2000, p = 100.0;
+    double sep = 0.0, pa = 0.0;
+    int failures = 0;
+
+    SSOrbit circular = SSDoubleStar::binaryOrbit ( arcsec, 0.0, 0.0, 0.0, 0.0, tp, p );
+    for ( int quarter = 0; quarter < 4; quarter++ )
+    {
+        SSDoubleStar::orbitSeparationAndPA ( circular, tp + quarter * p / 4.0, sep, pa );
+        if ( fabs ( sep - arcsec ) > kTolerance * arcsec || fabs ( modpi ( pa - quarter * 90.0 * deg ) ) > kTolerance )
+            failures++;
+    }
+
+    SSOrbit eccentric = SSDoubleStar::binaryOrbit ( arcsec, 0.5, 0.0, 40.0 * deg, 50.0 * deg, tp, p );
+    SSDoubleStar::orbitSeparationAndPA ( eccentric, tp, sep, pa );
+    failures += fabs ( sep - 0.5 * arcsec ) > kTolerance * arcsec || fabs ( modpi ( pa - 90.0 * deg ) ) > kTolerance;
+    SSDoubleStar::orbitSeparationAndPA ( eccentric, tp + p / 2.0, sep, pa );
+    failures += fabs ( sep - 1.5 * arcsec ) > kTolerance * arcsec || fabs ( modpi ( pa + 90.0 * deg ) ) > kTolerance;
+
+    SSOrbit edgeOn = SSDoubleStar::binaryOrbit ( arcsec, 0.0, 90.0 * deg, 0.0, 0.0, tp, p );
+    for ( int step = 0; step < 10; step++ )
+    {
+        SSDoubleStar::orbitSeparationAndPA ( edgeOn, tp + step * p / 10.0, sep, pa );
+        if ( fabs ( sep - fabs ( arcsec * cos ( step * SSAngle::kTwoPi / 10.0 ) ) ) > kTolerance * arcsec || fabs ( sin ( pa ) ) * sep > kTolerance * arcsec )
+            failures++;
+    }
+
+    SSStarStore store;
+    SSDynamics dyn ( tp + 1234.5, 0.0, 0.0 );
+    vector<SSObjectPtr> binaries = { SSNewObject ( kTypeDoubleStar ), SSNewObject ( kTypeDoubleVariableStar ) };
+    for ( SSObjectPtr &pObject : binaries )
+    {
+        SSDoubleStarPtr pDouble = SSGetDoubleStarPtr ( pObject );
+        pDouble->setFundamentalPosition ( SSVector ( 1.0, 0.0, 0.0 ) );
+        pDouble->setFundamentalVelocity ( SSVector ( 0.0, 0.0, 0.0 ) );
+        pDouble->setVMagnitude ( 5.0 );
+        pDouble->setComponents ( "AB" );
+        pDouble->setSeparation ( 2.0 * arcsec );
+        pDouble->setPositionAngle ( 100.0 * deg );
+        pDouble->setPositionAngleYear ( 1990.0 );
+        pDouble->setOrbit ( SSDoubleStar::binaryOrbit ( arcsec, 0.5, 30.0 * deg, 40.0 * deg, 50.0 * deg, tp, p ) );
+        store.append ( pDouble );
+
+        string csv = pDouble->toCSV();
+        pDouble->computeEphemeris ( dyn );
+        SSOrbit orbit = pDouble->getOrbit();
+        SSDoubleStar::orbitSeparationAndPA ( orbit, dyn.jde, sep, pa );
+        failures += pDouble->getOrbitSeparation() != (float) sep || pDouble->getOrbitPositionAngle() != (float) pa;
+        failures += pDouble->toCSV() != csv || pDouble->getSeparation() != (float) ( 2.0 * arcsec ) || pDouble->getPositionAngleYear() != 1990.0f;
+    }
+
+    store.computeEphemeris ( dyn );
+    failures += store.getBinaryCount() != binaries.size();
+    for ( size_t k = 0; k < store.getBinaryCount() && k < binaries.size(); k++ )
+    {
+        SSDoubleStarPtr pDouble = SSGetDoubleStarPtr ( binaries[k] );
+        failures += store.getBinarySeparation ( k ) != pDouble->getOrbitSeparation() || store.getBinaryPositionAngle ( k ) != pDouble->getOrbitPositionAngle();
+    }
+
+    cout << "Binary orbits: " << failures << " failures" << endl;
+}
+
+// Times computing the ephemeris of every star in the bright star catalog (passes) times,
+// at a different Julian Date each pass, and reports the average time per star in the fastest
+// of (runs) runs, so layouts of SSObject and SSStar can be compared despite run-to-run noise.
+// The sizes of both classes are reported with the timing.
+
+void BenchmarkStarEphemeris ( string inputDir, int passes, int runs )
+{
+    SSObjectVec stars;
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", stars );
+    if ( stars.size() < 1 )
+        return;
+
+    SSDynamics dyn ( SSTime::kJ2000, 0.0, 0.0 );
+    double ms = HUGE_VAL;
+
+    for ( int r = 0; r < runs; r++ )
+    {
+        auto start = chrono::steady_clock::now();
+        for ( int n = 0; n < passes; n++ )
+        {
+            dyn.jde = SSTime::kJ2000 + n;
+            for ( SSObjectPtr &pObject : stars )
+                pObject->computeEphemeris ( dyn );
+        }
+
+        double runMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+        ms = min ( ms, runMS );
+    }
+
+    cout << "Star ephemeris: " << stars.size() << " stars x " << passes << " passes in " << format ( "%.2f", ms ) << " ms, best of " << runs << " runs, ";
+    cout << format ( "%.1f", ms * 1.0e6 / ( stars.size() * passes ) ) << " ns per star; SSObject " << sizeof ( SSObject ) << " bytes, SSStar " << sizeof ( SSStar ) << " bytes" << endl;
+}
+
+// Parses the numeric orbit fields of every record in the MPC asteroid file (passes) times,
+// once with string substr()/trim()/strtofloat64() and once with SSStringView columns;
+// verifies that both give identical values, and reports time and memory allocations for each.
+// Then times the full MPC comet and asteroid importers.
+
+void TestFieldParsing ( string inputDir, int passes )
+{
+    static const int cols[9][2] = { { 8, 5 }, { 14, 5 }, { 26, 9 }, { 37, 9 }, { 48, 9 }, { 59, 9 }, { 70, 9 }, { 80, 11 }, { 92, 11 } };
+
+    ifstream file ( inputDir + "/SolarSystem/Asteroids.txt" );
+    vector<string> lines;
+    string line;
+    while ( getline ( file, line ) )
+        if ( line.length() >= 195 )
+            lines.push_back ( line );
+
+    vector<double> stringValues, viewValues;
+    stringValues.reserve ( lines.size() * 9 );
+    viewValues.reserve ( lines.size() * 9 );
+
+    size_t allocs = _numAllocs;
+    auto start = chrono::steady_clock::now();
+    for ( int n = 0; n < passes; n++ )
+    {
+        stringValues.clear();
+        for ( const string &record : lines )
+            for ( int i = 0; i < 9; i++ )
+            {
+                string field = trim ( record.substr ( cols[i][0], cols[i][1] ) );
+                stringValues.push_back ( field.empty() ? HUGE_VAL : strtofloat64 ( field ) );
+            }
+    }
+    double stringMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+    size_t stringAllocs = _numAllocs - allocs;
+
+    allocs = _numAllocs;
+    start = chrono::steady_clock::now();
+    for ( int n = 0; n < passes; n++ )
+    {
+        viewValues.clear();
+        for ( const string &line : lines )
+        {
+            SSStringView record ( line );
+            for ( int i = 0; i < 9; i++ )
+            {
+                SSStringView field = record.column ( cols[i][0], cols[i][1] );
+                viewValues.push_back ( field.empty() ? HUGE_VAL : field.toFloat64() );
+            }
+        }
+    }
+    double viewMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+    size_t viewAllocs = _numAllocs - allocs;
+
+    bool same = stringValues.size() == viewValues.size() && memcmp ( stringValues.data(), viewValues.data(), stringValues.size() * sizeof ( double ) ) == 0;
+    cout << "Field parsing: " << lines.size() << " records x 9 fields x " << passes << " passes, " << ( same ? "identical" : "MISMATCH" ) << endl;
+    cout << "  string: " << format ( "%.2f", stringMS ) << " ms, " << stringAllocs << " allocations" << endl;
+    cout << "  view:   " << format ( "%.2f", viewMS ) << " ms, " << viewAllocs << " allocations" << endl;
+
+    SSObjectVec objects;
+    start = chrono::steady_clock::now();
+    int numComets = SSImportMPCComets ( inputDir + "/SolarSystem/Comets.txt", objects );
+    double cometMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    start = chrono::steady_clock::now();
+    int numAsteroids = SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", objects );
+    double asteroidMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    cout << "Imported " << numComets << " MPC comets in " << format ( "%.2f", cometMS ) << " ms, ";
+    cout << numAsteroids << " MPC asteroids in " << format ( "%.2f", asteroidMS ) << " ms" << endl;
+}
+
+// Reference conversion of an angle string, as strtodeg() did with the C library.
+
+static double sscanfdeg ( const string &str )
+{
+    double deg = 0.0, min = 0.0, sec = 0.0;
+    sscanf ( str.c_str(), "%lf %lf %lf", &deg, &min, &sec );
+    deg = fabs ( deg ) + min / 60.0 + sec / 3600.0;
+    return str[0] == '-' ? -deg : deg;
+}
+
+// Compares the result of each numeric conversion function on a string with the C library
+// function it replaces; returns the number of conversions whose results differ in any bit.
+
+static int compareNumericParsing ( const string &field )
+{
+    int mismatches = 0;
+
+    int i = strtoint ( field );
+    int64_t i64 = strtoint64 ( field );
+    float f = strtofloat ( field );
+    double d = strtofloat64 ( field );
+    double deg = strtodeg ( field );
+
+    int refi = atoi ( field.c_str() );
+    int64_t refi64 = atoll ( field.c_str() );
+    float reff = strtof ( field.c_str(), nullptr );
+    double refd = strtod ( field.c_str(), nullptr );
+    double refdeg = sscanfdeg ( field );
+
+    mismatches += i != refi;
+    mismatches += i64 != refi64;
+    mismatches += memcmp ( &f, &reff, sizeof ( f ) ) != 0;
+    mismatches += memcmp ( &d, &refd, sizeof ( d ) ) != 0;
+    mismatches += memcmp ( &deg, &refdeg, sizeof ( deg ) ) != 0;
+
+    if ( mismatches )
+        cout << "Numeric parsing mismatch for \"" << field << "\"" << endl;
+
+    return mismatches;
+}
+
+// Converts every comma- and space-separated field in every SSData file with strtoint(), strtoint64(),
+// strtofloat(), strtofloat64() and strtodeg(), and verifies that the results are identical to the C library
+// functions they replaced. Then does the same for (count) random decimal numbers, and reports the time
+// taken to convert all SSData fields both ways.
+
+void TestNumericParsing ( string inputDir, int count )
+{
+    static const char *files[] = { "/Constellations/Boundaries.csv", "/Constellations/Constellations.csv", "/Constellations/Shapes.csv",
+        "/DeepSky/Caldwell.csv", "/DeepSky/Messier.csv", "/DeepSky/Names.csv", "/SolarSystem/Asteroids.txt", "/SolarSystem/Comets.txt",
+        "/SolarSystem/Moons.csv", "/SolarSystem/Planets.csv", "/SolarSystem/Satellites/all.txt", "/SolarSystem/Satellites/visual.txt",
+        "/Stars/Brightest.csv", "/Stars/Names.csv", "/Stars/Nearest.csv" };
+
+    vector<string> fields;
+    for ( const char *file : files )
+    {
+        ifstream stream ( inputDir + file );
+        string line;
+        while ( getline ( stream, line ) )
+        {
+            for ( const string &field : split ( line, "," ) )
+                fields.push_back ( field );
+
+            for ( const string &field : tokenize ( line, " " ) )
+                fields.push_back ( field );
+        }
+    }
+
+    int mismatches = 0;
+    for ( const string &field : fields )
+        mismatches += compareNumericParsing ( field );
+
+    cout << "Numeric parsing: " << fields.size() << " SSData fields, " << mismatches << " mismatches" << endl;
+
+    // Random numbers with up to 20 significant digits and exponents up to +/- 40
+    // exercise rounding, the exact fast path limits, and the strtod() fallback.
+
+    srand ( 1 );
+    mismatches = 0;
+    for ( int n = 0; n < count; n++ )
+    {
+        string number = rand() % 4 ? "" : "-";
+        int numDigits = 1 + rand() % 20, point = rand() % ( numDigits + 1 );
+        for ( int k = 0; k < numDigits; k++ )
+        {
+            if ( k == point )
+                number += ".";
+            number += (char) ( '0' + rand() % 10 );
+        }
+
+        if ( rand() % 2 )
+            number += format ( "e%d", rand() % 81 - 40 );
+
+        mismatches += compareNumericParsing ( number );
+    }
+
+    cout << "Numeric parsing: " << count << " random numbers, " << mismatches << " mismatches" << endl;
+
+    double sum = 0.0;
+    auto start = chrono::steady_clock::now();
+    for ( const string &field : fields )
+        sum += strtod ( field.c_str(), nullptr ) + strtof ( field.c_str(), nullptr ) + atoi ( field.c_str() );
+    double refMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    start = chrono::steady_clock::now();
+    for ( const string &field : fields )
+        sum -= strtofloat64 ( field ) + strtofloat ( field ) + strtoint ( field );
+    double newMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    start = chrono::steady_clock::now();
+    for ( const string &field : fields )
+        sum += sscanfdeg ( field );
+    double refDegMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    start = chrono::steady_clock::now();
+    for ( const string &field : fields )
+        sum -= strtodeg ( field );
+    double newDegMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    cout << "  C library: " << format ( "%.2f", refMS ) << " ms numbers, " << format ( "%.2f", refDegMS ) << " ms angles" << endl;
+    cout << "  SSCore:    " << format ( "%.2f", newMS ) << " ms numbers, " << format ( "%.2f", newDegMS ) << " ms angles";
+    cout << ( sum == 0.0 || isnan ( sum ) ? "" : " (sums differ)" ) << endl;
+}
+
+// Switches the numeric locale to one whose decimal point is a comma, if one is installed, and verifies
+// that strtofloat() and strtofloat64() still convert numbers outside their fast paths, which they pass
+// to the C library, exactly as strtof() and strtod() do in the "C" locale.
+
+void TestLocaleParsing ( void )
+{
+    static const char *numbers[] = { "1.23456789012345678901", "-2.5e-300", "3.4028234e38", "0.000000000000000000000001", "1.7976931348623157e308" };
+    static const char *locales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German", "French" };
+
+    vector<double> expected64;
+    vector<float> expected;
+    for ( const char *number : numbers )
+    {
+        expected64.push_back ( strtod ( number, nullptr ) );
+        expected.push_back ( strtof ( number, nullptr ) );
+    }
+
+    const char *name = nullptr;
+    for ( const char *locale : locales )
+    {
+        if ( setlocale ( LC_NUMERIC, locale ) != nullptr && localeconv()->decimal_point[0] == ',' )
+        {
+            name = locale;
+            break;
+        }
+    }
+
+    if ( name == nullptr )
+    {
+        setlocale ( LC_NUMERIC, "C" );
+        cout << "Locale parsing: no locale with a comma decimal point is installed; skipped" << endl;
+        return;
+    }
+
+    int mismatches = 0, differences = 0;
+    for ( int i = 0; i < expected.size(); i++ )
+    {
+        mismatches += strtofloat64 ( numbers[i] ) == expected64[i] ? 0 : 1;
+        mismatches += strtofloat ( numbers[i] ) == expected[i] ? 0 : 1;
+        differences += strtod ( numbers[i], nullptr ) == expected64[i] ? 0 : 1;
+    }
+
+    setlocale ( LC_NUMERIC, "C" );
+    cout << "Locale parsing: " << expected.size() << " numbers in " << name << " locale, " << mismatches << " mismatches; ";
+    cout << differences << " converted differently by strtod()" << endl;
+}
+
+// Writes the bright stars and MPC asteroids to one large CSV file in the output directory,
+// then imports it (passes) times on one thread and on every hardware thread, and verifies that
+// both imports produce the same objects in the same order.
+
+void TestParallelImport ( string inputDir, string outputDir, int passes )
+{
+    SSObjectVec objects;
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", objects );
+    SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", objects );
+
+    string path = outputDir + "/ParallelImport.csv";
+    if ( SSExportObjectsToCSV ( path, objects ) != objects.size() )
+    {
+        cout << "Failed to write " << path << endl;
+        return;
+    }
+
+    SSObjectVec serial, parallel;
+    double serialMS = 0.0, parallelMS = 0.0;
+
+    for ( int i = 0; i < passes; i++ )
+    {
+        serial.clear();
+        auto start = chrono::steady_clock::now();
+        SSImportObjectsFromCSV ( path, serial, nullptr, 1 );
+        serialMS += chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+        parallel.clear();
+        start = chrono::steady_clock::now();
+        SSImportObjectsFromCSV ( path, parallel, nullptr, 0 );
+        parallelMS += chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+    }
+
+    int mismatches = serial.size() == parallel.size() ? 0 : 1;
+    for ( size_t i = 0; i < serial.size() && i < parallel.size(); i++ )
+        if ( serial[i]->toCSV() != parallel[i]->toCSV() )
+            mismatches++;
+
+    cout << "Parallel import: " << serial.size() << " objects on 1 thread in " << format ( "%.2f", serialMS / passes ) << " ms, ";
+    cout << parallel.size() << " on " << thread::hardware_concurrency() << " threads in " << format ( "%.2f", parallelMS / passes ) << " ms, ";
+    cout << mismatches << " mismatches" << endl;
+}
+
+// Verifies that appendint(), appendfixed() and appendexp() format (count) random values exactly as
+// snprintf() does, then exports every SSData catalog to CSV files in the output directory (passes) times,
+// and reports the time and heap allocations taken by each.
+
+void TestCSVExport ( string inputDir, string outputDir, int count, int passes )
+{
+    int mismatches = 0;
+    char buf[1024];
+
+    srand ( 1 );
+    for ( int n = 0; n < count; n++ )
+    {
+        double value = ( rand() - RAND_MAX / 2 ) * pow ( 10.0, rand() % 24 - 16 );
+        if ( n % 4 == 0 )
+            value = ( rand() % 100000 ) / 8.0;      // exact binary fractions, where rounding ties are common
+
+        int precision = rand() % 9, width = rand() % 12;
+        bool plus = rand() % 2;
+        string str;
+
+        appendfixed ( str, value, precision, width, plus );
+        snprintf ( buf, sizeof ( buf ), plus ? "%+0*.*f" : "%0*.*f", width, precision, value );
+        mismatches += str != buf;
+
+        str.clear();
+        appendexp ( str, value, precision, plus );
+        snprintf ( buf, sizeof ( buf ), plus ? "%+.*E" : "%.*E", precision, value );
+        mismatches += str != buf;
+
+        str.clear();
+        appendint ( str, (int64_t) value, width );
+        snprintf ( buf, sizeof ( buf ), "%0*lld", width, (long long) value );
+        mismatches += str != buf;
+    }
+
+    cout << "CSV number formatting: " << count * 3 << " values, " << mismatches << " mismatches" << endl;
+
+    struct { const char *name; SSObjectVec objects; } catalogs[9];
+    SSImportObjectsFromCSV ( inputDir + "/SolarSystem/Planets.csv", catalogs[0].objects );
+    SSImportObjectsFromCSV ( inputDir + "/SolarSystem/Moons.csv", catalogs[1].objects );
+    SSImportMPCComets ( inputDir + "/SolarSystem/Comets.txt", catalogs[2].objects );
+    SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", catalogs[3].objects );
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", catalogs[4].objects );
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Nearest.csv", catalogs[5].objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Messier.csv", catalogs[6].objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", catalogs[7].objects );
+    SSImportConstellations ( inputDir + "/Constellations/Constellations.csv", catalogs[8].objects );
+
+    const char *names[9] = { "Planets", "Moons", "Comets", "Asteroids", "Brightest", "Nearest", "Messier", "Caldwell", "Constellations" };
+    for ( int c = 0; c < 9; c++ )
+    {
+        string path = outputDir + "/Exported" + names[c] + ".csv";
+        SSObjectVec &objects = catalogs[c].objects;
+
+        size_t allocs = _numAllocs;
+        auto start = chrono::steady_clock::now();
+        for ( int i = 0; i < passes; i++ )
+            SSExportObjectsToCSV ( path, objects );
+        double ms = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count() / passes;
+        allocs = ( _numAllocs - allocs ) / passes;
+
+        cout << "CSV export: " << objects.size() << " " << names[c] << " in " << format ( "%.2f", ms ) << " ms, ";
+        cout << allocs << " allocations" << endl;
+    }
+}
+
+// Reads the MPC asteroid file (passes) times with getline() and with an SSLineReader, and reports
+// the time and heap allocations taken by each. Then writes a copy of the file with CRLF line endings,
+// a 1 MB line, and no final line ending to the output directory, and verifies that SSLineReader
+// returns the same lines from it that getline() does, less carriage returns.
+
+void TestLineReader ( string inputDir, string outputDir, int passes )
+{
+    string path = inputDir + "/SolarSystem/Asteroids.txt";
+    vector<string> lines;
+    size_t chars = 0;
+    double getlineMS = 0.0, readerMS = 0.0;
+    size_t getlineAllocs = 0, readerAllocs = 0;
+
+    for ( int i = 0; i < passes; i++ )
+    {
+        size_t allocs = _numAllocs;
+        auto start = chrono::steady_clock::now();
+        ifstream file ( path );
+        string line;
+        lines.clear();
+        while ( getline ( file, line ) )
+            lines.push_back ( line );
+        getlineMS += chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+        getlineAllocs += _numAllocs - allocs;
+
+        allocs = _numAllocs;
+        start = chrono::steady_clock::now();
+        SSLineReader reader ( path );
+        SSStringView view;
+        chars = 0;
+        while ( reader.readLine ( view ) )
+            chars += view.length();
+        readerMS += chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+        readerAllocs += _numAllocs - allocs;
+    }
+
+    cout << "Line reader: " << lines.size() << " lines with getline() in " << format ( "%.2f", getlineMS / passes ) << " ms, ";
+    cout << getlineAllocs / passes << " allocations; " << chars << " chars with SSLineReader in " << format ( "%.2f", readerMS / passes ) << " ms, ";
+    cout << readerAllocs / passes << " allocations" << endl;
+
+    lines.insert ( lines.begin() + lines.size() / 2, string ( 1 << 20, 'x' ) );
+
+    string crlfPath = outputDir + "/LineReader.txt";
+    FILE *file = fopen ( crlfPath.c_str(), "wb" );
+    if ( file == nullptr )
+    {
+        cout << "Failed to write " << crlfPath << endl;
+        return;
+    }
+
+    for ( size_t i = 0; i < lines.size(); i++ )
+        fprintf ( file, i + 1 < lines.size() ? "%s\r\n" : "%s", lines[i].c_str() );
+    fclose ( file );
+
+    SSLineReader reader ( crlfPath );
+    string line;
+    size_t n = 0, mismatches = 0;
+    while ( reader.readLine ( line ) )
+        if ( n >= lines.size() || line != lines[n++] )
+            mismatches++;
+
+    cout << "Line reader: " << n << " of " << lines.size() << " CRLF lines read, " << mismatches + lines.size() - n << " mismatches" << endl;
+}
+
+// Imports all but the last 100 asteroids in the MPC asteroid file, then merges an update into them
+// made from the whole file with every 50th asteroid removed and the mean anomaly of every 10th changed.
+// Verifies that the merged asteroids and their updated index match a fresh import of the update file,
+// and reports the time taken by the merge and by a full import and index rebuild. Then merges a daily
+// update holding only the changed and new asteroids, without retiring any, and compares it the same way
+// with a full import of the whole changed file. Then merges a copy of the visual satellite TLEs,
+// with one missing and one changed, into the originals.
+
+void TestCatalogMerge ( string inputDir, string outputDir )
+{
+    vector<string> lines;
+    string line;
+    SSLineReader reader ( inputDir + "/SolarSystem/Asteroids.txt" );
+    while ( reader.readLine ( line ) )
+        lines.push_back ( line );
+
+    string basePath = outputDir + "/MergeBase.txt", updatePath = outputDir + "/MergeUpdate.txt";
+    string dailyPath = outputDir + "/MergeDaily.txt", changedPath = outputDir + "/MergeChanged.txt";
+    FILE *base = fopen ( basePath.c_str(), "w" );
+    FILE *update = fopen ( updatePath.c_str(), "w" );
+    FILE *daily = fopen ( dailyPath.c_str(), "w" );
+    FILE *changed = fopen ( changedPath.c_str(), "w" );
+    if ( base == nullptr || update == nullptr || daily == nullptr || changed == nullptr )
+    {
+        cout << "Failed to write merge test files to " << outputDir << endl;
+        return;
+    }
+
+    for ( size_t i = 0; i < lines.size(); i++ )
+    {
+        bool isNew = i + 100 >= lines.size();
+        if ( ! isNew )
+            fprintf ( base, "%s\n", lines[i].c_str() );
+
+        bool isChanged = i % 10 == 0 && lines[i].length() > 34;
+        if ( isChanged )
+            lines[i][34] = lines[i][34] == '9' ? '0' : lines[i][34] + 1;
+
+        fprintf ( changed, "%s\n", lines[i].c_str() );
+        if ( isChanged || isNew )
+            fprintf ( daily, "%s\n", lines[i].c_str() );
+        if ( i % 50 != 49 )
+            fprintf ( update, "%s\n", lines[i].c_str() );
+    }
+
+    fclose ( base );
+    fclose ( update );
+    fclose ( daily );
+    fclose ( changed );
+
+    SSObjectVec asteroids;
+    SSImportMPCAsteroids ( basePath, asteroids );
+    SSIdentifierIndex index ( asteroids, kCatAstNum );
+
+    SSMergeSummary summary;
+    auto start = chrono::steady_clock::now();
+    SSUpdateMPCAsteroids ( updatePath, asteroids, true, summary, &index );
+    double mergeMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    SSObjectVec fresh;
+    start = chrono::steady_clock::now();
+    SSImportMPCAsteroids ( updatePath, fresh );
+    SSIdentifierIndex freshIndex ( fresh, kCatAstNum );
+    double importMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    // Merged asteroids are in a different order, so compare sorted CSV strings; then look up
+    // every numbered asteroid through the updated index.
+
+    vector<string> mergedCSV, freshCSV;
+    for ( SSObjectPtr &pObject : asteroids )
+        mergedCSV.push_back ( pObject->toCSV() );
+    for ( SSObjectPtr &pObject : fresh )
+        freshCSV.push_back ( pObject->toCSV() );
+
+    sort ( mergedCSV.begin(), mergedCSV.end() );
+    sort ( freshCSV.begin(), freshCSV.end() );
+    int mismatches = mergedCSV == freshCSV && index.size() == freshIndex.size() ? 0 : 1;
+
+    for ( SSObjectPtr &pFresh : fresh )
+    {
+        SSIdentifier ident = pFresh->getIdentifier ( kCatAstNum );
+        SSObjectPtr pMerged = SSIdentifierToObject ( ident, index, asteroids );
+        if ( ident && ( pMerged == nullptr || pMerged->toCSV() != pFresh->toCSV() ) )
+            mismatches++;
+    }
+
+    cout << "Catalog merge: " << summary.added << " added, " << summary.updated << " updated, " << summary.unchanged << " unchanged, ";
+    cout << summary.retired << " retired in " << format ( "%.2f", mergeMS ) << " ms; full import in " << format ( "%.2f", importMS ) << " ms, ";
+    cout << mismatches << " mismatches" << endl;
+
+    SSObjectVec dailyAsteroids;
+    SSImportMPCAsteroids ( basePath, dailyAsteroids );
+    SSIdentifierIndex dailyIndex ( dailyAsteroids, kCatAstNum );
+
+    start = chrono::steady_clock::now();
+    SSUpdateMPCAsteroids ( dailyPath, dailyAsteroids, false, summary, &dailyIndex );
+    mergeMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    fresh.clear();
+    start = chrono::steady_clock::now();
+    SSImportMPCAsteroids ( changedPath, fresh );
+    SSIdentifierIndex changedIndex ( fresh, kCatAstNum );
+    importMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    mergedCSV.clear();
+    freshCSV.clear();
+    for ( SSObjectPtr &pObject : dailyAsteroids )
+        mergedCSV.push_back ( pObject->toCSV() );
+    for ( SSObjectPtr &pObject : fresh )
+        freshCSV.push_back ( pObject->toCSV() );
+
+    sort ( mergedCSV.begin(), mergedCSV.end() );
+    sort ( freshCSV.begin(), freshCSV.end() );
+    mismatches = mergedCSV == freshCSV && dailyIndex.size() == changedIndex.size() ? 0 : 1;
+
+    for ( SSObjectPtr &pFresh : fresh )
+    {
+        SSIdentifier ident = pFresh->getIdentifier ( kCatAstNum );
+        SSObjectPtr pMerged = SSIdentifierToObject ( ident, dailyIndex, dailyAsteroids );
+        if ( ident && ( pMerged == nullptr || pMerged->toCSV() != pFresh->toCSV() ) )
+            mismatches++;
+    }
+
+    cout << "Daily merge: " << summary.added << " added, " << summary.updated << " updated, " << summary.unchanged << " unchanged ";
+    cout << "in " << format ( "%.2f", mergeMS ) << " ms; full import in " << format ( "%.2f", importMS ) << " ms, ";
+    cout << mismatches << " mismatches" << endl;
+
+    vector<SSTLE> tles, tleUpdates;
+    ifstream file ( inputDir + "/SolarSystem/Satellites/visual.txt" );
+    SSTLE tle;
+    while ( tle.read ( file ) == 0 )
+        tles.push_back ( tle );
+
+    if ( tles.size() < 2 )
+        return;
+
+    tleUpdates.assign ( tles.begin() + 1, tles.end() );
+    tleUpdates.back().bstar *= 2.0;
+    SSMergeTLEs ( tles, tleUpdates, true, summary );
+
+    cout << "TLE merge: " << summary.added << " added, " << summary.updated << " updated, " << summary.unchanged << " unchanged, ";
+    cout << summary.retired << " retired, " << tles.size() << " TLEs" << endl;
+}
+
+// Imports planets, moons, stars, deep sky objects, and constellations into one vector.
+
+static void importMixedObjects ( string inputDir, SSObjectVec &objects )
+{
+    SSImportObjectsFromCSV ( inputDir + "/SolarSystem/Planets.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/SolarSystem/Moons.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Messier.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/Constellations/Constellations.csv", objects );
+}
+
+// Exports planets, moons, stars, deep sky objects, and constellations to a binary catalog file,
+// reopens it, and verifies that every object reads back with the same CSV string. Then writes
+// copies of the file which are truncated, have a section with the wrong element size, have an
+// identifier start column which decreases, and have an unterminated string table, and verifies
+// that all of them are rejected.
+
+void TestBinaryCatalog ( string inputDir, string outputDir )
+{
+    SSObjectVec objects, imported;
+    importMixedObjects ( inputDir, objects );
+
+    string path = outputDir + "/Binary.ssc";
+    int exported = SSExportObjectsToBinary ( path, objects );
+    SSImportObjectsFromBinary ( path, imported );
+
+    int mismatches = exported == (int) objects.size() && imported.size() == objects.size() ? 0 : 1;
+    for ( size_t i = 0; i < objects.size() && i < imported.size(); i++ )
+        if ( objects[i]->toCSV() != imported[i]->toCSV() )
+            mismatches++;
+
+    ifstream file ( path, ios::binary );
+    vector<char> data ( ( istreambuf_iterator<char> ( file ) ), istreambuf_iterator<char>() );
+    if ( data.size() < sizeof ( SSBinaryCatalogHeader ) )
+    {
+        cout << "Failed to read " << path << endl;
+        return;
+    }
+
+    // Finds the section table entry for a section (id) in a copy of the file (copy).
+
+    auto findSection = [] ( vector<char> &copy, uint32_t id ) -> SSBinaryCatalogSection *
+    {
+        SSBinaryCatalogHeader *pHeader = (SSBinaryCatalogHeader *) copy.data();
+        SSBinaryCatalogSection *pSections = (SSBinaryCatalogSection *) ( copy.data() + sizeof ( SSBinaryCatalogHeader ) );
+        for ( uint32_t i = 0; i < pHeader->numSections; i++ )
+            if ( pSections[i].id == id )
+                return pSections + i;
+        return nullptr;
+    };
+
+    vector<vector<char>> damaged ( 4, data );
+    damaged[0].resize ( data.size() / 2 );
+    findSection ( damaged[1], SSBinaryCatalog::kPositionX )->elemSize = 1;
+
+    SSBinaryCatalogSection *pStart = findSection ( damaged[2], SSBinaryCatalog::kIdentStart );
+    ( (uint32_t *) ( damaged[2].data() + pStart->offset ) )[ pStart->count / 2 ] = UINT32_MAX;
+
+    SSBinaryCatalogSection *pStrings = findSection ( damaged[3], SSBinaryCatalog::kStrings );
+    damaged[3][ pStrings->offset + pStrings->count - 1 ] = 'x';
+
+    int rejected = 0;
+    for ( vector<char> &copy : damaged )
+    {
+        string damagedPath = outputDir + "/BinaryDamaged.ssc";
+        ofstream out ( damagedPath, ios::binary );
+        out.write ( copy.data(), copy.size() );
+        out.close();
+
+        SSBinaryCatalog catalog;
+        if ( ! catalog.open ( damagedPath ) )
+            rejected++;
+    }
+
+    cout << "Binary catalog: " << imported.size() << " of " << objects.size() << " objects read back, " << mismatches << " mismatches; ";
+    cout << rejected << " of " << damaged.size() << " damaged files rejected" << endl;
+}
+
+// Streams the bright star catalog through a catalog reader, once pulling objects with next(), and once
+// pushing them through a buffered sink with a small memory budget into a vector, a sky index, a star store,
+// and a binary catalog file at once. Verifies that every sink receives the same stars, in the same order,
+// as a non-streaming import: the vector and binary catalog by CSV, the star store by position and magnitude,
+// and the sky index by cone searches. Then verifies that a callback sink can stop the import, and that
+// the object it rejected is not counted.
+
+void TestCatalogStream ( string inputDir, string outputDir )
+{
+    string path = inputDir + "/Stars/Brightest.csv";
+    SSObjectVec expected;
+    SSImportObjectsFromCSV ( path, expected, nullptr, 1 );
+
+    SSRecordParser parser = [] ( SSStringView line, SSObjectVec &objects )
+    {
+        SSObjectPtr pObject = SSObjectFromCSV ( line.toString() );
+        if ( pObject == nullptr )
+            return 0;
+
+        objects.push_back ( pObject );
+        return 1;
+    };
+
+    // Returns 1 if a vector of objects does not have the same CSV strings, in the same order, as the expected objects.
+
+    auto compare = [&expected] ( SSObjectVec &objects ) -> int
+    {
+        if ( objects.size() != expected.size() )
+            return 1;
+
+        for ( size_t i = 0; i < objects.size(); i++ )
+            if ( objects[i]->toCSV() != expected[i]->toCSV() )
+                return 1;
+
+        return 0;
+    };
+
+    int failures = 0;
+    SSObjectVec pulled;
+    SSObjectPtr pObject = nullptr;
+    SSCatalogReader puller ( path, parser );
+    while ( puller.next ( pObject ) )
+        pulled.push_back ( pObject );
+    failures += compare ( pulled );
+
+    SSObjectVec streamed, reread;
+    SSSkyIndex skyIndex, expectedIndex;
+    SSStarStore store;
+    string binaryPath = outputDir + "/Streamed.ssc";
+    SSObjectVecSink vecSink ( streamed );
+    SSSkyIndexSink indexSink ( skyIndex );
+    SSStarStoreSink storeSink ( store );
+    SSBinaryCatalogSink binarySink ( binaryPath );
+    SSTeeSink tee ( { &vecSink, &indexSink, &storeSink, &binarySink } );
+    SSBufferedSink buffered ( tee, 64 * 1024 );
+
+    SSCatalogReader reader ( path, parser );
+    int count = reader.read ( buffered );
+    failures += count != (int) expected.size();
+    failures += compare ( streamed );
+    failures += ! binarySink.finish() || SSImportObjectsFromBinary ( binaryPath, reread ) != (int) expected.size();
+    failures += compare ( reread );
+
+    failures += store.size() != expected.size();
+    for ( size_t i = 0; i < store.size() && i < expected.size(); i++ )
+    {
+        SSStarPtr pStar = SSGetStarPtr ( expected[i] );
+        if ( pStar == nullptr || store.getFundamentalPosition ( i ) != pStar->getFundamentalPosition() || store.getVMagnitude ( i ) != pStar->getVMagnitude() )
+            failures++;
+    }
+
+    expectedIndex.build ( expected );
+    for ( int ra = 0; ra < 24; ra += 3 )
+    {
+        SSVector center ( SSSpherical ( ra * SSAngle::kRadPerHour, ( ra - 12 ) * 5.0 * SSAngle::kRadPerDeg, 1.0 ) );
+        vector<int> found, wanted;
+        skyIndex.coneSearch ( center, 20.0 * SSAngle::kRadPerDeg, found );
+        expectedIndex.coneSearch ( center, 20.0 * SSAngle::kRadPerDeg, wanted );
+        sort ( found.begin(), found.end() );
+        sort ( wanted.begin(), wanted.end() );
+        failures += found != wanted || found.empty();
+    }
+
+    int accepted = 0;
+    SSCallbackSink callbackSink ( [&accepted] ( SSObjectPtr pObject )
+    {
+        if ( pObject == nullptr || accepted == 100 )
+            return false;
+
+        accepted++;
+        return true;
+    } );
+    SSCatalogReader stopper ( path, parser );
+    failures += stopper.read ( callbackSink ) != 100 || accepted != 100;
+
+    cout << "Catalog stream: " << count << " of " << expected.size() << " stars streamed to vector, sky index, star store and binary catalog; ";
+    cout << failures << " failures" << endl;
+}
+
+// Builds sky tiles over stars and deep sky objects, writes them to a tile file, opens the file,
+// and verifies that several queries find the same objects in the opened tiles, paged in from disk,
+// as in the built tiles; then unloads every tile and repeats the queries. Then writes copies of the
+// file which are truncated, have a tile with a negative count, and have tile entries outside the
+// file, and verifies that all of them are rejected.
+
+void TestSkyTiles ( string inputDir, string outputDir )
+{
+    SSObjectVec objects;
+    importMixedObjects ( inputDir, objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", objects );
+
+    SSSkyTiles built ( 3 ), opened;
+    int numBuilt = built.build ( objects );
+    string path = outputDir + "/SkyTiles.sst";
+    if ( ! built.write ( path ) || ! opened.open ( path ) )
+    {
+        cout << "Failed to write and open " << path << endl;
+        return;
+    }
+
+    // Returns the object indices and magnitudes of every tile entry found by a query, in order.
+
+    auto query = [] ( SSSkyTiles &tiles, SSVector center, double radius, float limMag ) -> vector<pair<int,float>>
+    {
+        vector<SSSkyTileSpan> spans;
+        vector<pair<int,float>> found;
+        tiles.query ( center, radius, limMag, spans );
+        for ( SSSkyTileSpan &span : spans )
+            for ( int i = 0; i < span.count; i++ )
+                found.push_back ( { span.entries[i].index, span.entries[i].mag } );
+        return found;
+    };
+
+    SSVector orion ( SSSpherical ( 5.5 * SSAngle::kRadPerHour, 0.0, 1.0 ) );
+    SSVector virgo ( SSSpherical ( 12.5 * SSAngle::kRadPerHour, 12.0 * SSAngle::kRadPerDeg, 1.0 ) );
+    vector<SSVector> centers = { orion, virgo, orion };
+    vector<double> radii = { 20.0 * SSAngle::kRadPerDeg, 15.0 * SSAngle::kRadPerDeg, SSAngle::kPi };
+    vector<float> limits = { 4.0f, 10.0f, INFINITY };
+
+    int mismatches = 0;
+    size_t numFound = 0;
+    for ( int pass = 0; pass < 2; pass++ )
+    {
+        for ( int q = 0; q < centers.size(); q++ )
+        {
+            vector<pair<int,float>> expected = query ( built, centers[q], radii[q], limits[q] );
+            vector<pair<int,float>> found = query ( opened, centers[q], radii[q], limits[q] );
+            mismatches += found == expected ? 0 : 1;
+            numFound += found.size();
+        }
+
+        for ( int i = 0; i < opened.getTileCount(); i++ )
+            opened.unloadTile ( i );
+    }
+
+    mismatches += query ( opened, orion, SSAngle::kPi, INFINITY ).size() == numBuilt ? 0 : 1;
+    opened.close();
+
+    // Tile file layout: 4-byte magic number and 16-byte header, then one 16-byte directory record
+    // per tile, holding a 4-byte entry count, 4-byte brightest magnitude, and 8-byte entry offset.
+
+    ifstream file ( path, ios::binary );
+    vector<char> data ( ( istreambuf_iterator<char> ( file ) ), istreambuf_iterator<char>() );
+    if ( data.size() < 36 )
+    {
+        cout << "Failed to read " << path << endl;
+        return;
+    }
+
+    vector<vector<char>> damaged ( 4, data );
+    damaged[0].resize ( data.size() - 1 );
+    *(int32_t *) ( damaged[1].data() + 20 ) = -5;
+    *(int64_t *) ( damaged[2].data() + 28 ) = INT64_MAX;
+    *(int64_t *) ( damaged[3].data() + 28 ) = 0;
+
+    int rejected = 0;
+    for ( vector<char> &copy : damaged )
+    {
+        string damagedPath = outputDir + "/SkyTilesDamaged.sst";
+        ofstream out ( damagedPath, ios::binary );
+        out.write ( copy.data(), copy.size() );
+        out.close();
+
+        SSSkyTiles tiles;
+        if ( ! tiles.open ( damagedPath ) )
+            rejected++;
+    }
+
+    cout << "Sky tiles: " << numBuilt << " objects in " << built.getTileCount() << " tiles, " << numFound << " found by queries of opened file, ";
+    cout << mismatches << " mismatches; " << rejected << " of " << damaged.size() << " damaged files rejected" << endl;
+}
+
+// Builds a sky index of the brightest stars' J2000 directions, and verifies that cone searches,
+// polygon searches, and nearest-neighbor searches find the same stars as brute-force scans of
+// the directions. Then moves some stars with update() and commit(), including one moved into
+// a different trixel, and verifies that all three searches find the stars in their new places.
+
+void TestSkyIndex ( string inputDir )
+{
+    SSObjectVec objects;
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", objects );
+
+    vector<SSVector> dirs;
+    for ( int i = 0; i < objects.size(); i++ )
+    {
+        SSStarPtr pStar = SSGetStarPtr ( objects[i] );
+        if ( pStar != nullptr )
+            dirs.push_back ( pStar->getFundamentalPosition().normalize() );
+    }
+
+    SSSkyIndex index;
+    index.build ( dirs );
+
+    // Returns the indices of all directions inside a region, in ascending order.
+
+    auto scan = [&dirs] ( SSSkyRegion &region ) -> vector<int>
+    {
+        vector<int> found;
+        for ( int i = 0; i < dirs.size(); i++ )
+            if ( region.contains ( dirs[i] ) )
+                found.push_back ( i );
+        return found;
+    };
+
+    // Returns the k directions nearest to a unit vector, in order of increasing distance.
+
+    auto scanNearest = [&dirs] ( SSVector dir, int k ) -> vector<int>
+    {
+        vector<pair<double,int>> sorted ( dirs.size() );
+        for ( int i = 0; i < dirs.size(); i++ )
+            sorted[i] = pair<double,int> ( -dir.dotProduct ( dirs[i] ), i );
+        partial_sort ( sorted.begin(), sorted.begin() + k, sorted.end() );
+
+        vector<int> found ( k );
+        for ( int i = 0; i < k; i++ )
+            found[i] = sorted[i].second;
+        return found;
+    };
+
+    SSVector orion ( SSSpherical ( 5.5 * SSAngle::kRadPerHour, 0.0, 1.0 ) );
+    SSVector virgo ( SSSpherical ( 12.5 * SSAngle::kRadPerHour, 12.0 * SSAngle::kRadPerDeg, 1.0 ) );
+    SSVector pole ( SSSpherical ( 0.0, 89.0 * SSAngle::kRadPerDeg, 1.0 ) );
+    vector<SSVector> centers = { orion, virgo, pole };
+
+    // Runs cone, polygon, and nearest-neighbor searches around a direction, and returns the number
+    // of searches whose results differ from brute-force scans. The polygon is a quadrilateral whose
+    // vertices are 10 degrees east, north, west, and south of the direction.
+
+    int searches = 0;
+    auto compare = [&] ( SSVector center ) -> int
+    {
+        int mismatches = 0;
+        SSSpherical sph ( center );
+        double side = 10.0 * SSAngle::kRadPerDeg;
+
+        for ( double radius : { 0.2 * SSAngle::kRadPerDeg, 5.0 * SSAngle::kRadPerDeg, 30.0 * SSAngle::kRadPerDeg } )
+        {
+            SSSkyRegion cone ( center, radius );
+            vector<int> found;
+            index.coneSearch ( center, radius, found );
+            sort ( found.begin(), found.end() );
+            mismatches += found == scan ( cone ) ? 0 : 1;
+            searches++;
+        }
+
+        SSVector north = SSVector ( SSSpherical ( sph.lon, sph.lat + SSAngle::kHalfPi, 1.0 ) );
+        SSVector east = north.crossProduct ( center ).normalize();
+        vector<SSVector> vertices =
+        {
+            center * cos ( side ) + east * sin ( side ),
+            center * cos ( side ) + north * sin ( side ),
+            center * cos ( side ) - east * sin ( side ),
+            center * cos ( side ) - north * sin ( side )
+        };
+
+        SSSkyRegion polygon ( vertices );
+        vector<int> found;
+        index.polygonSearch ( vertices, found );
+        sort ( found.begin(), found.end() );
+        mismatches += found == scan ( polygon ) ? 0 : 1;
+        searches++;
+
+        for ( int k : { 1, 10, 100 } )
+        {
+            found.clear();
+            index.nearest ( center, k, found );
+            mismatches += found == scanNearest ( center, k ) ? 0 : 1;
+            searches++;
+        }
+
+        mismatches += index.nearest ( center ) == scanNearest ( center, 1 )[0] ? 0 : 1;
+        searches++;
+        return mismatches;
+    };
+
+    int mismatches = 0;
+    for ( SSVector &center : centers )
+        mismatches += compare ( center );
+
+    // Move one star to the opposite side of the sky, which is always a different trixel, and nudge
+    // every 50th star by a tenth of a degree, which may or may not change its trixel.
+
+    int level = index.getLevel();
+    int moved = 0, failures = 0;
+    SSVector oldDir = dirs[0], newDir = dirs[0] * -1.0;
+    failures += SSSkyIndex::trixelID ( oldDir, level ) != SSSkyIndex::trixelID ( newDir, level ) ? 0 : 1;
+    failures += index.update ( 0, newDir ) ? 0 : 1;
+    dirs[0] = newDir;
+    moved++;
+
+    for ( int i = 50; i < dirs.size(); i += 50 )
+    {
+        SSSpherical sph ( dirs[i] );
+        sph.lon += 0.1 * SSAngle::kRadPerDeg;
+        dirs[i] = SSVector ( sph );
+        moved += index.update ( i, dirs[i] ) ? 1 : 0;
+    }
+
+    failures += index.commit() == moved ? 0 : 1;
+    for ( SSVector &center : centers )
+        mismatches += compare ( center );
+    mismatches += compare ( newDir );
+    mismatches += compare ( oldDir );
+
+    // The moved star must be found at its new place, and not at its old one.
+
+    vector<int> found;
+    index.coneSearch ( newDir, 0.01 * SSAngle::kRadPerDeg, found );
+    failures += count ( found.begin(), found.end(), 0 ) == 1 ? 0 : 1;
+    found.clear();
+    index.coneSearch ( oldDir, 0.01 * SSAngle::kRadPerDeg, found );
+    failures += count ( found.begin(), found.end(), 0 ) == 0 ? 0 : 1;
+    failures += index.nearest ( newDir ) == 0 ? 0 : 1;
+
+    cout << "Sky index: " << dirs.size() << " stars at level " << level << ", " << searches << " searches, ";
+    cout << mismatches << " mismatches with brute-force scans; " << moved << " stars moved to new trixels, " << failures << " failures" << endl;
+}
+
+// Runs several queries over a mixed catalog of solar system objects, stars, and deep sky objects,
+// once using sky tiles and a sky index, and once scanning the whole catalog.
+// Verifies that both find the same objects, and that the first query finds the same stars as a
+// hand-written loop; reports the time taken by each, averaged over (passes) runs.
+
+void TestQuery ( string inputDir, int passes )
+{
+    SSObjectVec objects;
+    importMixedObjects ( inputDir, objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", objects );
+    SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", objects );
+
+    // Stars keep their J2000 positions and visual magnitudes; only solar system objects need ephemerides.
+
+    SSDynamics dyn ( SSTime::kJ2000, 0.0, 0.0 );
+    for ( SSObjectPtr &pObject : objects )
+        if ( SSGetPlanetPtr ( pObject ) != nullptr )
+            pObject->computeEphemeris ( dyn );
+
+    SSSkyIndex skyIndex;
+    skyIndex.build ( objects );
+    SSSkyTiles skyTiles ( 4 );
+    skyTiles.build ( objects );
+
+    SSVector orion ( SSSpherical ( 5.5 * SSAngle::kRadPerHour, 0.0, 1.0 ) );
+    SSVector virgo ( SSSpherical ( 12.5 * SSAngle::kRadPerHour, 12.0 * SSAngle::kRadPerDeg, 1.0 ) );
+
+    vector<SSQuery> queries ( 4 );
+    vector<string> names = { "bright stars near Orion", "galaxies near Virgo", "HR stars of mag 2-3", "objects within 3 AU in half the sky" };
+    queries[0].addTypes ( kTypeStar, kTypeDoubleVariableStar ).setMagnitudeRange ( -HUGE_VAL, 4.0 ).setCone ( orion, 20.0 * SSAngle::kRadPerDeg );
+    queries[1].addType ( kTypeGalaxy ).setMagnitudeRange ( -HUGE_VAL, 10.0 ).setCone ( virgo, 15.0 * SSAngle::kRadPerDeg );
+    queries[2].addCatalog ( kCatHR ).setMagnitudeRange ( 2.0, 3.0 );
+    queries[3].setDistanceRange ( 0.0, 3.0 ).setCone ( orion, 90.0 * SSAngle::kRadPerDeg );
+
+    for ( int q = 0; q < queries.size(); q++ )
+    {
+        SSQuery scan = queries[q];
+        queries[q].useSkyTiles ( skyTiles ).useSkyIndex ( skyIndex );
+
+        vector<int> indexed, scanned;
+        auto start = chrono::steady_clock::now();
+        for ( int n = 0; n < passes; n++ )
+        {
+            indexed.clear();
+            queries[q].run ( objects, indexed );
+        }
+        double indexedMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+        start = chrono::steady_clock::now();
+        for ( int n = 0; n < passes; n++ )
+        {
+            scanned.clear();
+            scan.run ( objects, scanned );
+        }
+        double scannedMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+        int mismatches = indexed == scanned ? 0 : 1;
+        if ( q == 0 )
+        {
+            vector<int> looped;
+            for ( int i = 0; i < objects.size(); i++ )
+            {
+                SSStarPtr pStar = SSGetStarPtr ( objects[i] );
+                if ( pStar && pStar->getType() <= kTypeDoubleVariableStar && pStar->getVMagnitude() <= 4.0
+                    && pStar->getFundamentalPosition().normalize().angularSeparation ( orion ) <= 20.0 * SSAngle::kRadPerDeg )
+                    looped.push_back ( i );
+            }
+
+            mismatches += looped == indexed ? 0 : 1;
+        }
+
+        cout << "Query " << names[q] << ": " << indexed.size() << " of " << objects.size() << " objects in " << format ( "%.3f", indexedMS / passes ) << " ms indexed, ";
+        cout << format ( "%.3f", scannedMS / passes ) << " ms scanned, " << mismatches << " mismatches" << endl;
+    }
+
+    // Brighten every variable star to its maximum, as its ephemeris would at that phase of its light curve,
+    // without rebuilding the tiles. Stars which are fainter than the limit at their V magnitude but brighter
+    // at maximum must still be found using tiles.
+
+    int brightened = 0;
+    for ( SSObjectPtr &pObject : objects )
+    {
+        SSVariableStarPtr pVar = SSGetVariableStarPtr ( pObject );
+        if ( pVar == nullptr || isinf ( pVar->getMinimumMagnitude() ) )
+            continue;
+
+        pVar->setMagnitude ( pVar->getMinimumMagnitude() );
+        brightened += pVar->getVMagnitude() > 4.0 && pVar->getMinimumMagnitude() <= 4.0;
+    }
+
+    SSQuery bright;
+    bright.addTypes ( kTypeStar, kTypeDoubleVariableStar ).setMagnitudeRange ( -HUGE_VAL, 4.0 );
+    SSQuery scan = bright;
+    bright.useSkyTiles ( skyTiles );
+
+    vector<int> indexed, scanned;
+    bright.run ( objects, indexed );
+    scan.run ( objects, scanned );
+    cout << "Query variable stars at maximum: " << indexed.size() << " stars brighter than 4.0, " << brightened << " only at maximum, ";
+    cout << ( indexed == scanned ? 0 : 1 ) << " mismatches" << endl;
+}
+
+// Converts every identifier of every object in the star, deep sky, and solar system data files,
+// and in the star and deep sky name files, to a string and back (passes) times. Verifies that each
+// string converts back to the same identifier, and reports the time and heap allocations taken.
+// JPL planet and NORAD satellite numbers are skipped, since their strings have no catalog prefix.
+
+void TestIdentifierParsing ( string inputDir, int passes )
+{
+    SSObjectVec objects;
+    importMixedObjects ( inputDir, objects );
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Nearest.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", objects );
+    SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", objects );
+    SSImportMPCComets ( inputDir + "/SolarSystem/Comets.txt", objects );
+
+    SSIdentifierNameMap nameMap;
+    SSImportIdentifierNameMap ( ( inputDir + "/Stars/Names.csv" ).c_str(), nameMap );
+    SSImportIdentifierNameMap ( ( inputDir + "/DeepSky/Names.csv" ).c_str(), nameMap );
+
+    SSIdentifierVec idents;
+    for ( SSObjectPtr &pObject : objects )
+        for ( int i = 0; i < pObject->getIdentifierCount(); i++ )
+            idents.push_back ( pObject->getIdentifierAtIndex ( i ) );
+
+    for ( auto &pair : nameMap )
+        idents.push_back ( pair.first );
+
+    vector<string> strings;
+    for ( SSIdentifier &ident : idents )
+        if ( ident.catalog() != kCatJPLanet && ident.catalog() != kCatNORADSat )
+            strings.push_back ( ident.toString() );
+
+    size_t mismatches = 0;
+    for ( size_t i = 0, k = 0; i < idents.size(); i++ )
+        if ( idents[i].catalog() != kCatJPLanet && idents[i].catalog() != kCatNORADSat )
+            if ( SSIdentifier::fromString ( strings[k++] ) != idents[i] )
+                mismatches++;
+
+    size_t allocs = _numAllocs;
+    auto start = chrono::steady_clock::now();
+    for ( int n = 0; n < passes; n++ )
+        for ( string &str : strings )
+            SSIdentifier::fromString ( str );
+    double ms = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+    allocs = _numAllocs - allocs;
+
+    cout << "Identifier parsing: " << strings.size() << " identifiers in " << format ( "%.1f", ms * 1.0e6 / ( strings.size() * passes ) ) << " ns each, ";
+    cout << allocs / passes << " allocations, " << mismatches << " round-trip mismatches" << endl;
+}
+
+// Converts every identifier of every object in the star, deep sky, and solar system data files (passes) times,
+// with toString(), by appending to a reused string, into a character buffer, and in one batch per object,
+// as CSV export does. Verifies that all give the same strings, and reports the time and heap allocations taken.
+
+void TestIdentifierFormatting ( string inputDir, int passes )
+{
+    SSObjectVec objects;
+    importMixedObjects ( inputDir, objects );
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Nearest.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", objects );
+    SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", objects );
+    SSImportMPCComets ( inputDir + "/SolarSystem/Comets.txt", objects );
+
+    vector<SSIdentifierVec> identVecs ( objects.size() );
+    size_t count = 0;
+    for ( size_t k = 0; k < objects.size(); k++ )
+    {
+        for ( int i = 0; i < objects[k]->getIdentifierCount(); i++ )
+            identVecs[k].push_back ( objects[k]->getIdentifierAtIndex ( i ) );
+        count += identVecs[k].size();
+    }
+
+    // Compare every way of formatting each object's identifiers with toString().
+
+    size_t mismatches = 0;
+    string str, batch;
+    char buf[32];
+    for ( SSIdentifierVec &idents : identVecs )
+    {
+        string expected;
+        batch.clear();
+        SSAppendIdentifiers ( batch, idents, ',' );
+        for ( SSIdentifier ident : idents )
+        {
+            string s = ident.toString();
+            expected += s + ",";
+
+            str.clear();
+            ident.appendString ( str );
+            if ( str != s || ident.toString ( buf, sizeof ( buf ) ) != s.length() || s != buf )
+                mismatches++;
+        }
+
+        if ( batch != expected )
+            mismatches++;
+    }
+
+    // Time each way of formatting all identifiers; appended strings are cleared after each object.
+
+    const char *methods[] = { "toString()", "appendString()", "toString ( buf )", "SSAppendIdentifiers()" };
+    for ( int method = 0; method < 4; method++ )
+    {
+        size_t allocs = _numAllocs, chars = 0;
+        auto start = chrono::steady_clock::now();
+        for ( int n = 0; n < passes; n++ )
+        {
+            for ( SSIdentifierVec &idents : identVecs )
+            {
+                str.clear();
+                if ( method == 3 )
+                    SSAppendIdentifiers ( str, idents, ',' );
+                else
+                    for ( SSIdentifier ident : idents )
+                        if ( method == 0 )
+                            chars += ident.toString().length();
+                        else if ( method == 1 )
+                            ident.appendString ( str );
+                        else
+                            chars += ident.toString ( buf, sizeof ( buf ) );
+                chars += str.length();
+            }
+        }
+        double ms = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+        allocs = _numAllocs - allocs;
+
+        cout << "Identifier formatting with " << methods[method] << ": " << count << " identifiers in " << format ( "%.1f", ms * 1.0e6 / ( count * passes ) ) << " ns each, ";
+        cout << allocs / passes << " allocations, " << chars / passes << " characters" << endl;
+    }
+
+    cout << "Identifier formatting: " << mismatches << " mismatches" << endl;
+}
+
+// Returns a string (text) lowercased, with whitespace removed, for comparison with SSNameIndex keys.
+
+static string nameKey ( const string &text )
+{
+    string key;
+    for ( char c : text )
+        if ( ! strchr ( " \t\n\v\f\r", c ) || c == 0 )
+            key.push_back ( c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c );
+    return key;
+}
+
+// Builds a name index of stars, deep sky and solar system objects, with common names from the star
+// and deep sky name files, and verifies that searches for prefixes of its strings return the same
+// matches as a scan of every object. Then builds an index of (count) objects made by repeating those,
+// and reports the time taken to build it, to find names, and to search for prefixes as a user types them.
+
+void TestNameIndex ( string inputDir, int count )
+{
+    SSObjectVec objects;
+    importMixedObjects ( inputDir, objects );
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Nearest.csv", objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", objects );
+    SSImportMPCAsteroids ( inputDir + "/SolarSystem/Asteroids.txt", objects );
+    SSImportMPCComets ( inputDir + "/SolarSystem/Comets.txt", objects );
+
+    SSIdentifierNameMap nameMap;
+    SSImportIdentifierNameMap ( ( inputDir + "/Stars/Names.csv" ).c_str(), nameMap );
+    SSImportIdentifierNameMap ( ( inputDir + "/DeepSky/Names.csv" ).c_str(), nameMap );
+
+    SSNameIndex index ( objects, &nameMap );
+
+    // Collect every object's strings the slow way, as pairs of keys and object indices.
+
+    vector<pair<string,int>> strings;
+    for ( int i = 0; i < objects.size(); i++ )
+    {
+        SSIdentifierVec idents;
+        for ( const SSInternedString &name : objects[i]->getNames() )
+            strings.push_back ( { nameKey ( name ), i } );
+
+        for ( int k = 0; k < objects[i]->getIdentifierCount(); k++ )
+        {
+            SSIdentifier ident = objects[i]->getIdentifierAtIndex ( k );
+            if ( ident.catalog() != kCatJPLanet )
+            {
+                strings.push_back ( { nameKey ( ident.toString() ), i } );
+                idents.push_back ( ident );
+            }
+        }
+
+        for ( const string &name : SSIdentifiersToNames ( idents, nameMap ) )
+            strings.push_back ( { nameKey ( name ), i } );
+    }
+
+    sort ( strings.begin(), strings.end() );
+    strings.erase ( unique ( strings.begin(), strings.end() ), strings.end() );
+
+    int searches = 0, mismatches = 0;
+    vector<SSNameMatch> matches;
+    for ( size_t s = 0; s < strings.size(); s += 499 )
+    {
+        for ( size_t len = 1; len <= strings[s].first.length(); len++ )
+        {
+            string prefix = strings[s].first.substr ( 0, len );
+            vector<pair<string,int>> expected, found;
+            for ( auto &str : strings )
+                if ( str.first.compare ( 0, len, prefix ) == 0 )
+                    expected.push_back ( str );
+
+            index.search ( prefix, matches );
+            for ( SSNameMatch &match : matches )
+                found.push_back ( { nameKey ( match.text.toString() ), match.index } );
+
+            mismatches += found == expected ? 0 : 1;
+            searches++;
+        }
+    }
+
+    cout << "Name index: " << index.size() << " strings of " << objects.size() << " objects, " << searches << " prefix searches, " << mismatches << " mismatches" << endl;
+
+    // Repeat the objects until there are (count) of them, and time searches of a much larger index.
+
+    SSObjectVec manyObjects;
+    manyObjects.reserve ( count );
+    while ( manyObjects.size() < count )
+        manyObjects.push_back ( objects[ manyObjects.size() % objects.size() ] );
+
+    auto start = chrono::steady_clock::now();
+    SSNameIndex bigIndex ( manyObjects, &nameMap );
+    double buildMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    vector<string> typed = { "Sirius", "Rigil Kentaurus", "M 31", "NGC 7000", "HIP 71683", "Ceres", "Halley", "Andromeda Galaxy", "BD +38 3238" };
+    int lookups = 0, notFound = 0;
+    start = chrono::steady_clock::now();
+    for ( string &name : typed )
+    {
+        for ( size_t len = 1; len <= name.length(); len++ )
+        {
+            bigIndex.search ( SSStringView ( name.data(), len ), matches, 10 );
+            lookups++;
+        }
+
+        notFound += bigIndex.find ( name ) < 0 ? 1 : 0;
+    }
+    double searchMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    start = chrono::steady_clock::now();
+    for ( string &name : typed )
+        SSNameToObject ( name, manyObjects );
+    double scanMS = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+
+    cout << "Name index: " << bigIndex.size() << " strings of " << manyObjects.size() << " objects built in " << format ( "%.0f", buildMS ) << " ms; ";
+    cout << lookups << " searches as typed in " << format ( "%.1f", searchMS * 1000.0 / lookups ) << " us each, " << notFound << " not found; ";
+    cout << "scanning objects for names takes " << format ( "%.1f", scanMS * 1000.0 / typed.size() ) << " us each" << endl;
+}
+
+// Computes ephemerides for the same mixed vector of objects (passes) times, once with
+// a virtual call per object and once with an SSEphemerisBatch; verifies that the results
+// are identical and reports the time taken by each. Does this twice: with the objects
+// in the order they were imported, which groups them by type, and with the objects
+// shuffled, as in a catalog merged from several sources.
+
+void TestEphemerisBatch ( string inputDir, int passes )
+{
+    for ( int shuffled = 0; shuffled < 2; shuffled++ )
+    {
+        SSObjectVec objects, batchObjects;
+        importMixedObjects ( inputDir, objects );
+        importMixedObjects ( inputDir, batchObjects );
+
+        // Shuffle both vectors the same way, so objects can still be compared pairwise.
+
+        srand ( 1 );
+        for ( size_t i = objects.size(); shuffled && i > 1; i-- )
+        {
+            size_t j = rand() % i;
+            swap ( objects[i - 1], objects[j] );
+            swap ( batchObjects[i - 1], batchObjects[j] );
+        }
+
+        SSEphemerisBatch batch ( batchObjects );
+        SSDynamics dyn ( SSTime::kJ2000, 0.0, 0.0 );
+
+        // Alternate the two methods, and keep the fastest of several runs of each, to reduce noise.
+
+        double virtualMS = HUGE_VAL, batchMS = HUGE_VAL;
+        for ( int run = 0; run < 3; run++ )
+        {
+            auto start = chrono::steady_clock::now();
+            for ( int n = 0; n < passes; n++ )
+            {
+                dyn.jde = SSTime::kJ2000 + n;
+                for ( SSObjectPtr &pObject : objects )
+                    pObject->computeEphemeris ( dyn );
+            }
+            double ms = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+            virtualMS = min ( virtualMS, ms );
+
+            start = chrono::steady_clock::now();
+            for ( int n = 0; n < passes; n++ )
+            {
+                dyn.jde = SSTime::kJ2000 + n;
+                batch.computeEphemeris ( dyn );
+            }
+            ms = chrono::duration<double,milli> ( chrono::steady_clock::now() - start ).count();
+            batchMS = min ( batchMS, ms );
+        }
+
+        int mismatches = 0;
+        for ( int i = 0; i < objects.size(); i++ )
+        {
+            SSObject *p = objects[i].get(), *q = batchObjects[i].get();
+            SSVector u = p->getDirection(), v = q->getDirection();
+            double d = p->getDistance(), e = q->getDistance();
+            float m = p->getMagnitude(), n = q->getMagnitude();
+
+            // Compare bit patterns, so infinite and NaN results match only themselves.
+
+            if ( memcmp ( &u, &v, sizeof ( u ) ) != 0 || memcmp ( &d, &e, sizeof ( d ) ) != 0 || memcmp ( &m, &n, sizeof ( m ) ) != 0 )
+                mismatches++;
+        }
+
+        cout << "Ephemeris batch, " << ( shuffled ? "shuffled" : "catalog order" ) << ": " << batch.getPlanetCount() << " planets, " << batch.getStarCount() << " stars, " << batch.getOtherCount() << " other, " << batch.getSkippedCount() << " skipped; ";
+        cout << passes << " passes, best of 3 runs: virtual " << format ( "%.2f", virtualMS ) << " ms, batched " << format ( "%.2f", batchMS ) << " ms, ";
+        cout << mismatches << " mismatches" << endl;
+    }
+}
+
+// Counts heap allocations made by common read-only passes over the bright star catalog:
+// reading every star's names and identifiers, making an identifier map, looking up
+// names from identifiers, and converting every star to CSV.
+
+void TestAccessorAllocations ( string inputDir )
+{
+    SSObjectVec stars;
+    SSIdentifierNameMap nameMap;
+
+    SSImportObjectsFromCSV ( inputDir + "/Stars/Brightest.csv", stars );
+    SSImportIdentifierNameMap ( ( inputDir + "/Stars/Names.csv" ).c_str(), nameMap );
+
+    size_t count = 0, start = _numAllocs;
+    for ( SSObjectPtr &pObject : stars )
+    {
+        SSStarPtr pStar = SSGetStarPtr ( pObject );
+        count += pStar->getNames().size() + pStar->getIdentifiers().size() + pStar->getSpectralType().length();
+    }
+    cout << "Accessors: " << count << " names, identifiers, and spectral type characters; " << _numAllocs - start << " allocations" << endl;
+
+    start = _numAllocs;
+    SSObjectMap map = SSMakeObjectMap ( stars, kCatHIP );
+    cout << "Object map: " << map.size() << " identifiers; " << _numAllocs - start << " allocations" << endl;
+
+    count = 0;
+    start = _numAllocs;
+    for ( SSObjectPtr &pObject : stars )
+        count += SSIdentifiersToNames ( SSGetStarPtr ( pObject )->getIdentifiers(), nameMap ).size();
+    cout << "Name search: " << count << " names; " << _numAllocs - start << " allocations" << endl;
+
+    count = 0;
+    start = _numAllocs;
+    for ( SSObjectPtr &pObject : stars )
+        count += pObject->toCSV().length();
+    cout << "CSV export: " << count << " characters; " << _numAllocs - start << " allocations" << endl;
+}
+
+// Returns the bytes used by a string object, including its characters if they don't fit
+// inside the object itself; libstdc++ keeps up to 15 characters in the object.
+
+static size_t stringBytes ( const string &str )
+{
+    return sizeof ( string ) + ( str.length() > 15 ? str.length() + 1 : 0 );
+}
+
+// Reports how much memory interning saves on the names, spectral types, and variable types
+// of every object in several catalogs, compared to a separate string for each one; then
+// looks up a few objects by name. The interned figure counts only the table entries these
+// catalogs use, plus the hash node that holds each one, not strings other tests interned;
+// the table's growth during the import is reported separately.
+
+void TestStringTable ( string inputDir )
+{
+    SSObjectVec objects;
+    size_t tableSize = SSStringTable::size();
+    importMixedObjects ( inputDir, objects );
+    SSImportObjectsFromCSV ( inputDir + "/DeepSky/Caldwell.csv", objects );
+    size_t tableGrowth = SSStringTable::size() - tableSize;
+
+    size_t numStrings = 0, separateBytes = 0;
+    unordered_set<const string *> entries;
+    for ( SSObjectPtr &pObject : objects )
+    {
+        vector<const string *> strings;
+        for ( int i = 0; i < pObject->getNames().size(); i++ )
+            strings.push_back ( &pObject->getName ( i ) );
+
+        SSStarPtr pStar = SSGetStarPtr ( pObject );
+        if ( pStar != nullptr )
+            strings.push_back ( &pStar->getSpectralType() );
+
+        SSVariableStarPtr pVar = SSGetVariableStarPtr ( pObject );
+        if ( pVar != nullptr )
+            strings.push_back ( &pVar->getVariableType() );
+
+        for ( const string *pStr : strings )
+        {
+            separateBytes += stringBytes ( *pStr );
+            if ( ! pStr->empty() )
+                entries.insert ( pStr );
+        }
+        numStrings += strings.size();
+    }
+
+    size_t internedBytes = numStrings * sizeof ( SSInternedString );
+    for ( const string *pStr : entries )
+        internedBytes += stringBytes ( *pStr ) + 2 * sizeof ( void * );
+
+    cout << "String table: " << numStrings << " strings, " << entries.size() << " distinct; ";
+    cout << separateBytes << " bytes as separate strings, " << internedBytes << " bytes interned; ";
+    cout << "table grew by " << tableGrowth << " entries during import" << endl;
+
+    for ( string name : { "Sirius", "Andromeda Galaxy", "Jupiter", "Nonexistent Name" } )
+    {
+        SSObjectPtr pObject = SSNameToObject ( name, objects );
+        cout << name << ": " << ( pObject ? pObject->toCSV() : "not found" ) << endl;
+    }
+}
+
+// Compares importing a star catalog repeatedly (passes) into objects allocated from the heap,
+// and from an arena, then releasing them. Reports the heap allocations counted during each import,
+// which include the objects' strings and vectors as well as the objects themselves, and for the arena,
+// the number of allocations it made from its blocks instead.
+
+void TestArena ( string inputDir, int passes )
+{
+    string path = inputDir + "/Stars/Brightest.csv";
+    SSObjectVec heapStars, arenaStars;
+    SSArena arena;
+
+    size_t allocs = _numAllocs;
+    auto start = chrono::steady_clock::now();
+    for ( int i = 0; i < passes; i++ )
+        SSImportObjectsFromCSV ( path, heapStars );
+    auto loaded = chrono::steady_clock::now();
+    size_t numHeap = heapStars.size(), heapAllocs = _numAllocs - allocs;
+    SSObjectVec().swap ( heapStars );
+    auto freed = chrono::steady_clock::now();
+
+    cout << "Heap: " << numHeap << " objects, " << heapAllocs << " heap allocations, ";
+    cout << "loaded in " << format ( "%.2f", chrono::duration<double,milli> ( loaded - start ).count() ) << " ms, ";
+    cout << "freed in " << format ( "%.2f", chrono::duration<double,milli> ( freed - loaded ).count() ) << " ms" << endl;
+
+    allocs = _numAllocs;
+    start = chrono::steady_clock::now();
+    for ( int i = 0; i < passes; i++ )
+        SSImportObjectsFromCSV ( path, arenaStars, &arena );
+    loaded = chrono::steady_clock::now();
+    size_t numArena = arenaStars.size(), arenaHeapAllocs = _numAllocs - allocs, numAllocs = arena.getAllocationCount();
+    size_t numBytes = arena.getBytesAllocated(), numBlocks = arena.getBlockCount();
+    bool released = SSReleaseObjects ( arenaStars, arena );
+    freed = chrono::steady_clock::now();
+
+    cout << "Arena: " << numArena << " objects, " << arenaHeapAllocs << " heap allocations, " << numAllocs << " arena allocations, " << numBytes << " bytes in " << numBlocks << " blocks, ";
+    cout << "loaded in " << format ( "%.2f", chrono::duration<double,milli> ( loaded - start ).count() ) << " ms, ";
+    cout << ( released ? "freed in " : "NOT freed in " ) << format ( "%.2f", chrono::duration<double,milli> ( freed - loaded ).count() ) << " ms" << endl;
+}
+
 void TestJPLDEphemeris ( string inputDir )
 {
     SSJPLDEphemeris jpldeph;
@@ -302,8 +2293,34 @@ int main ( int argc, const char *argv[] )
     TestJPLDEphemeris ( inpath );
     TestSolarSystem ( inpath, outpath );
     TestConstellations ( inpath, outpath );
+    TestConstellationAbbreviations();
     TestStars ( inpath, outpath );
     TestDeepSky ( inpath, outpath );
+    TestIdentifierIndex ( inpath );
+    TestIdentifierIndexes ( inpath );
+    TestAccessorAllocations ( inpath );
+    TestStringTable ( inpath );
+    TestArena ( inpath, 10 );
+    TestStarStore ( inpath );
+    TestLightCurves();
+    TestBinaryOrbits();
+    BenchmarkStarEphemeris ( inpath, 500, 5 );
+    TestEphemerisBatch ( inpath, 1000 );
+    TestFieldParsing ( inpath, 10 );
+    TestNumericParsing ( inpath, 1000000 );
+    TestLocaleParsing();
+    TestParallelImport ( inpath, outpath, 5 );
+    TestCSVExport ( inpath, outpath, 100000, 5 );
+    TestLineReader ( inpath, outpath, 5 );
+    TestCatalogMerge ( inpath, outpath );
+    TestBinaryCatalog ( inpath, outpath );
+    TestCatalogStream ( inpath, outpath );
+    TestSkyTiles ( inpath, outpath );
+    TestSkyIndex ( inpath );
+    TestQuery ( inpath, 100 );
+    TestIdentifierParsing ( inpath, 20 );
+    TestIdentifierFormatting ( inpath, 20 );
+    TestNameIndex ( inpath, 1000000 );
     
 /*
     SSObjectVec comets;